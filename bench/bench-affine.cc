@@ -0,0 +1,126 @@
+/*
+ * benchmark of affine<double> for dense and sparse storage of noise symbols.
+ * compile with the storage to be measured, e.g.
+ *   c++ -O3 -I.. bench-affine.cc                      (dense)
+ *   c++ -O3 -I.. -DAFFINE_SPARSE=1 bench-affine.cc    (sparse)
+ * and with or without the compaction of noise symbols in ode_affine
+ *   c++ -O3 -I.. -DAFFINE_REGISTRY=1 bench-affine.cc
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. the cases are
+ *   mix:   long sequence of +,-,*,sqrt,exp on a few affine variables
+ *          (each nonlinear operation adds a new noise symbol and all
+ *          the variables depend on all the noise symbols)
+ *   local: many affine variables each of which depends only on its
+ *          neighbours (most coefficients are zero)
+ *   ode:   odelong_affine for the Lorenz equation (same as test-ode-affine)
+ *   wrapper: odelong_wrapper for the Lorenz equation
+ * "check" is the midpoint of the result.
+ */
+
+#include <iostream>
+#include <kv/affine.hpp>
+#include <kv/ode-affine.hpp>
+#include <kv/ode-affine-wrapper.hpp>
+#include "bench.hpp"
+
+#ifndef NT
+#define NT 2000
+#endif
+
+#ifndef NV
+#define NV 200
+#endif
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+typedef kv::affine<double> afd;
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+double mix()
+{
+	int i;
+	afd x, y, z;
+	itv w;
+
+	afd::maxnum() = 0;
+	x = itv(1., 1.01);
+	y = itv(2., 2.01);
+	z = itv(0.5, 0.51);
+
+	for (i=0; i<NT; i++) {
+		x = 0.5 * (x + y) - 0.25 * z;
+		y = sqrt(x * x + 3.) - 0.5 * z;
+		z = exp(0.1 * (y - x)) * 0.5;
+	}
+	w = to_interval(x) + to_interval(y) + to_interval(z);
+
+	return mid(w);
+}
+
+double local()
+{
+	int i, j;
+	ub::vector<afd> x(NV), y(NV);
+	double r = 0.;
+
+	afd::maxnum() = 0;
+	for (i=0; i<NV; i++) x(i) = itv(1., 1.01) + 0.01 * i;
+
+	for (j=0; j<20; j++) {
+		for (i=0; i<NV; i++) {
+			y(i) = 0.25 * (x(i) + x((i+1) % NV)) + 0.5 * sqrt(x(i));
+		}
+		x = y;
+	}
+	for (i=0; i<NV; i++) r += mid(to_interval(x(i)));
+
+	return r;
+}
+
+double ode()
+{
+	ub::vector<afd> x(3);
+	itv end;
+
+	afd::maxnum() = 0;
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+	end = 1.;
+	kv::odelong_affine(Lorenz(), x, (itv)0., end);
+
+	return mid(to_interval(x(0)));
+}
+
+double wrapper()
+{
+	ub::vector<afd> x(3);
+	itv end;
+
+	afd::maxnum() = 0;
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+	end = 1.;
+	kv::odelong_wrapper(Lorenz(), x, (itv)0., end);
+
+	return mid(to_interval(x(0)));
+}
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "affine");
+
+	d.run("mix", "NT=" + bench::str(NT), mix);
+	d.run("local", "NV=" + bench::str(NV), local);
+	d.run("ode", "Lorenz", ode);
+	d.run("wrapper", "Lorenz", wrapper);
+}
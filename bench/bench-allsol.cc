@@ -0,0 +1,104 @@
+/*
+ * scaling of allsol with the number of threads for the problems of
+ * example/allsolexample.cc.
+ *   c++ -O3 -fopenmp -I.. bench-allsol.cc
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. each problem is solved with 1, 2, ...
+ * up to OMP_NUM_THREADS threads. "check" is 1 if each solution
+ * corresponds to exactly one of the solutions found with 1 thread,
+ * and 0 otherwise.
+ */
+
+#include <iostream>
+#include <list>
+#include <omp.h>
+#include <kv/allsol.hpp>
+#include "../example/allsolexample.hpp"
+#include "bench.hpp"
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+typedef std::list< ub::vector<itv> > solutions;
+
+// each solution of s corresponds to exactly one solution of s1
+
+bool same(const solutions& s, const solutions& s1)
+{
+	solutions::const_iterator p, q;
+	int n;
+
+	if (s.size() != s1.size()) return false;
+	for (p=s.begin(); p!=s.end(); p++) {
+		n = 0;
+		for (q=s1.begin(); q!=s1.end(); q++) {
+			if (overlap(*p, *q)) n++;
+		}
+		if (n != 1) return false;
+	}
+	return true;
+}
+
+// the case with 1 thread is run first and keeps its solutions in s1
+
+template <class F> struct allsol_case {
+	ub::vector<itv> I;
+	int th;
+	double giveup;
+	solutions& s1;
+
+	allsol_case(const ub::vector<itv>& I, int th, double giveup, solutions& s1) : I(I), th(th), giveup(giveup), s1(s1) {}
+
+	double operator()() {
+		solutions s;
+
+		omp_set_num_threads(th);
+		s = kv::allsol(F(), I, 0, giveup);
+		if (th == 1) s1 = s;
+
+		return same(s, s1) ? 1. : 0.;
+	}
+};
+
+template <class F> void cases(bench::driver& d, const ub::vector<itv>& I, const char *name, int maxth, double giveup = 0.)
+{
+	solutions s1;
+
+	for (int th=1; th<=maxth; th++) {
+		d.run(name, "threads=" + bench::str(th), allsol_case<F>(I, th, giveup, s1));
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "allsol");
+	ub::vector<itv> I;
+	int maxth;
+
+	maxth = omp_get_max_threads();
+
+	Matsu1().range(I);
+	cases<Matsu1>(d, I, "Matsu1", maxth);
+	Matsu2().range(I);
+	cases<Matsu2>(d, I, "Matsu2", maxth);
+	BadCond().range(I);
+	cases<BadCond>(d, I, "BadCond", maxth);
+	Hansen1().range(I);
+	cases<Hansen1>(d, I, "Hansen1", maxth);
+	GE1().range(I);
+	cases<GE1>(d, I, "GE1", maxth);
+	Shinohara1().range(I);
+	cases<Shinohara1>(d, I, "Shinohara1", maxth);
+	Shinohara2().range(I);
+	cases<Shinohara2>(d, I, "Shinohara2", maxth, 1e-8);
+	Shinohara3().range(I);
+	cases<Shinohara3>(d, I, "Shinohara3", maxth);
+	ModifiedHimmelblau().range(I);
+	cases<ModifiedHimmelblau>(d, I, "ModifiedHimmelblau", maxth);
+	Heihachiro().range(I);
+	cases<Heihachiro>(d, I, "Heihachiro", maxth);
+	Yamamura2().range(7, I);
+	cases<Yamamura2>(d, I, "Yamamura2(7)", maxth);
+	HydroCarbon().range(I);
+	cases<HydroCarbon>(d, I, "HydroCarbon", maxth);
+}
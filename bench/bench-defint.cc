@@ -0,0 +1,93 @@
+/*
+ * defint with many subintervals, defint_autostep, and a table of gamma
+ * whose entries are computed in parallel, for 1, 2, 4, ... threads.
+ *   c++ -O3 -I.. bench-defint.cc
+ *   c++ -O3 -fopenmp -DDEFINT_PARALLEL=1 -I.. bench-defint.cc   (1, 2, 4, ... up to OMP_NUM_THREADS)
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. "check" is 1 if the result is
+ * identical to that of one thread, and 0 otherwise.
+ */
+
+#include <iostream>
+#include <vector>
+#include <kv/defint.hpp>
+#include <kv/gamma.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "bench.hpp"
+
+typedef kv::interval<double> itv;
+
+#ifndef NTABLE
+#define NTABLE 64
+#endif
+
+struct Func {
+	template <class T> T operator() (const T& x) {
+		return exp(-x * x) * sin(10. * x) / (1. + x);
+	}
+};
+
+bool same(const std::vector<itv>& a, const std::vector<itv>& b)
+{
+	if (a.size() != b.size()) return false;
+	for (int i=0; i<(int)a.size(); i++) {
+		if (a[i].lower() != b[i].lower() || a[i].upper() != b[i].upper()) return false;
+	}
+	return true;
+}
+
+// the case with 1 thread is run first and keeps its result in r1
+
+struct defint_case {
+	int k, th;
+	std::vector<itv>& r1;
+
+	defint_case(int k, int th, std::vector<itv>& r1) : k(k), th(th), r1(r1) {}
+
+	double operator()() {
+		std::vector<itv> r;
+		int i;
+
+#ifdef _OPENMP
+		omp_set_num_threads(th);
+#endif
+		if (k == 0) {
+			r.assign(1, kv::defint(Func(), itv(0.), itv(4.), 16, 2000));
+		} else if (k == 1) {
+			r.assign(1, itv(0.));
+			for (i=0; i<20; i++) r[0] += kv::defint_autostep(Func(), itv(0.), itv(4.), 16);
+		} else {
+			// each entry is computed serially by one thread
+			r.resize(NTABLE);
+			#pragma omp parallel for schedule(dynamic)
+			for (i=0; i<NTABLE; i++) {
+				r[i] = kv::gamma(itv(0.5 + i * 0.25));
+			}
+		}
+		if (th == 1) r1 = r;
+
+		return same(r, r1) ? 1. : 0.;
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "defint");
+	int th, maxth, k;
+	const char *names[] = {"defint", "defint_autostep", "gamma_table"};
+	std::vector<itv> r1[3];
+
+#ifdef _OPENMP
+	maxth = omp_get_max_threads();
+#else
+	maxth = 1;
+#endif
+
+	for (k=0; k<3; k++) {
+		for (th=1; th<=maxth; th*=2) {
+			d.run(names[k], "threads=" + bench::str(th), defint_case(k, th, r1[k]));
+		}
+	}
+}
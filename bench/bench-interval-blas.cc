@@ -0,0 +1,78 @@
+/*
+ * benchmark of iblas::gemm / iblas::gemv against ub::prod
+ *   c++ -O3 -I.. -march=native bench-interval-blas.cc
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. each case repeats the product "rep"
+ * times (param). the cases are
+ *   gemv:       interval matrix times interval vector
+ *   gemm:       interval matrix times interval matrix
+ *   gemm_point: double matrix times interval matrix
+ * by ub::prod (_ublas) and by iblas (_iblas). "check" is the upper
+ * bound of the first element of the product.
+ */
+
+#include <iostream>
+#include <boost/random.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/interval-blas.hpp>
+#include "bench.hpp"
+
+namespace ub = boost::numeric::ublas;
+typedef kv::interval<double> itv;
+
+struct blas_case {
+	int op, nrep;
+	bool iblas;
+	const ub::matrix<itv>& A;
+	const ub::matrix<double>& R;
+	const ub::vector<itv>& x;
+
+	blas_case(int op, bool iblas, int nrep, const ub::matrix<itv>& A, const ub::matrix<double>& R, const ub::vector<itv>& x) : op(op), nrep(nrep), iblas(iblas), A(A), R(R), x(x) {}
+
+	double operator()() {
+		ub::matrix<itv> C;
+		ub::vector<itv> y;
+		int rep;
+
+		for (rep=0; rep<nrep; rep++) {
+			switch (op) {
+			case 0: y = iblas ? kv::iblas::gemv(A, x) : ub::vector<itv>(prod(A, x)); break;
+			case 1: C = iblas ? kv::iblas::gemm(A, A) : ub::matrix<itv>(prod(A, A)); break;
+			case 2: C = iblas ? kv::iblas::gemm(R, A) : ub::matrix<itv>(prod(R, A)); break;
+			}
+		}
+
+		return (op == 0) ? y(0).upper() : C(0, 0).upper();
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "interval-blas");
+	int n, i, j, op, nrep;
+	const char *names[] = {"gemv", "gemm", "gemm_point"};
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(1), boost::uniform_real<>(-1., 1.));
+
+	for (n=50; n<=200; n+=50) {
+		ub::matrix<itv> A(n, n);
+		ub::matrix<double> R(n, n);
+		ub::vector<itv> x(n);
+
+		for (i=0; i<n; i++) {
+			for (j=0; j<n; j++) {
+				A(i, j) = itv::hull(rand(), rand());
+				R(i, j) = rand();
+			}
+			x(i) = itv::hull(rand(), rand());
+		}
+
+		for (op=0; op<3; op++) {
+			nrep = (op == 0) ? 2000000 / (n * n) + 1 : 20000000 / (n * n * n) + 1;
+			d.run(std::string(names[op]) + "_ublas", "n=" + bench::str(n) + " rep=" + bench::str(nrep), blas_case(op, false, nrep, A, R, x));
+			d.run(std::string(names[op]) + "_iblas", "n=" + bench::str(n) + " rep=" + bench::str(nrep), blas_case(op, true, nrep, A, R, x));
+		}
+	}
+}
@@ -0,0 +1,81 @@
+/*
+ * benchmark of midpoint-radius interval matrix product
+ *  ub::prod (element-wise interval arithmetic, n <= 400 only),
+ *  iblas::gemm and iblas::gemm_midrad for n = 100, ..., 1000
+ *   c++ -O3 -I.. -march=native bench-interval-midrad.cc
+ *   c++ -O3 -I.. -march=native -DUSE_LAPACK bench-interval-midrad.cc -lblas -llapack
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. "check" is the maximum ratio of the
+ * widths of the elements to those of iblas::gemm.
+ */
+
+#include <iostream>
+#include <algorithm>
+#include <boost/random.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/interval-blas.hpp>
+#include "bench.hpp"
+
+namespace ub = boost::numeric::ublas;
+typedef kv::interval<double> itv;
+
+struct midrad_case {
+	int op;
+	const ub::matrix<itv>& A;
+	const ub::matrix<itv>& B;
+	const ub::matrix<itv>& C1;
+
+	midrad_case(int op, const ub::matrix<itv>& A, const ub::matrix<itv>& B, const ub::matrix<itv>& C1) : op(op), A(A), B(B), C1(C1) {}
+
+	double operator()() {
+		ub::matrix<itv> C;
+		double wr;
+		int i, j;
+
+		switch (op) {
+		case 0: C = prod(A, B); break;
+		case 1: C = kv::iblas::gemm(A, B); break;
+		case 2: C = kv::iblas::gemm_midrad(A, B); break;
+		}
+
+		wr = 0.;
+		for (i=0; i<(int)C.size1(); i++) {
+			for (j=0; j<(int)C.size2(); j++) {
+				wr = std::max(wr, width(C(i, j)) / width(C1(i, j)));
+			}
+		}
+
+		return wr;
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "interval-midrad");
+	int sizes[] = {100, 200, 400, 700, 1000};
+	int n, i, j, l;
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(1), boost::uniform_real<>(-1., 1.));
+
+	for (l=0; l<5; l++) {
+		n = sizes[l];
+		ub::matrix<itv> A(n, n), B(n, n), C1;
+
+		for (i=0; i<n; i++) {
+			for (j=0; j<n; j++) {
+				double a = rand();
+				A(i, j) = itv(a, a + 1e-6 * rand() * rand() + 1e-6);
+				a = rand();
+				B(i, j) = itv(a, a + 1e-6);
+			}
+		}
+
+		// reference of the widths
+		C1 = kv::iblas::gemm(A, B);
+
+		if (n <= 400) d.run("ublas", "n=" + bench::str(n), midrad_case(0, A, B, C1));
+		d.run("gemm", "n=" + bench::str(n), midrad_case(1, A, B, C1));
+		d.run("gemm_midrad", "n=" + bench::str(n), midrad_case(2, A, B, C1));
+	}
+}
@@ -0,0 +1,80 @@
+/*
+ * micro benchmark of interval<double> arithmetic.
+ * compile with the rounding backend to be measured, e.g.
+ *   c++ -O3 -I.. bench-interval-ops.cc                    (hwround)
+ *   c++ -O3 -I.. -DKV_FASTROUND bench-interval-ops.cc     (hwround, MXCSR)
+ *   c++ -O3 -I.. -DKV_NOHWROUND bench-interval-ops.cc     (nohwround)
+ *   c++ -O3 -I.. -DKV_USE_SSE2 bench-interval-ops.cc      (sse2 packed)
+ *   c++ -O3 -I.. -mavx512f -DKV_USE_AVX512 bench-interval-ops.cc
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. each case applies an operation to N
+ * intervals NT times, without (plain) and with (scoped) an enclosing
+ * rop<double>::begin() / end(). "check" is the upper bound of the last
+ * result.
+ */
+
+#include <iostream>
+#include <vector>
+#include <boost/random.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include "bench.hpp"
+
+#ifndef N
+#define N 1000
+#endif
+
+#ifndef NT
+#define NT 10000
+#endif
+
+typedef kv::interval<double> itv;
+
+std::vector<itv> x(N), y(N), z(N);
+
+void op_add() { for (int i=0; i<N; i++) z[i] = x[i] + y[i]; }
+void op_sub() { for (int i=0; i<N; i++) z[i] = x[i] - y[i]; }
+void op_mul() { for (int i=0; i<N; i++) z[i] = x[i] * y[i]; }
+void op_div() { for (int i=0; i<N; i++) z[i] = x[i] / y[i]; }
+void op_sqrt() { for (int i=0; i<N; i++) z[i] = sqrt(y[i]); }
+
+struct ops_case {
+	void (*f)();
+	bool scoped;
+
+	ops_case(void (*f)(), bool scoped) : f(f), scoped(scoped) {}
+
+	double operator()() {
+		int i;
+
+		if (scoped) kv::rop<double>::begin();
+		for (i=0; i<NT; i++) f();
+		if (scoped) kv::rop<double>::end();
+
+		return z[N-1].upper();
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "interval-ops");
+	const char *modes[] = {"plain", "scoped"};
+	int i;
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(1), boost::uniform_real<>(-1., 1.));
+
+	for (i=0; i<N; i++) {
+		double a = rand(), b = rand();
+		x[i] = itv::hull(a, b);
+		a = rand(); b = rand();
+		// positive intervals so that division and sqrt are defined
+		y[i] = itv::hull(1. + a * a, 2. + b * b);
+	}
+
+	for (i=0; i<2; i++) {
+		d.run("add", modes[i], ops_case(op_add, i == 1));
+		d.run("sub", modes[i], ops_case(op_sub, i == 1));
+		d.run("mul", modes[i], ops_case(op_mul, i == 1));
+		d.run("div", modes[i], ops_case(op_div, i == 1));
+		d.run("sqrt", modes[i], ops_case(op_sqrt, i == 1));
+	}
+}
@@ -0,0 +1,185 @@
+/*
+ * benchmark of lp_minimize and lp_minimize_verified (revised simplex)
+ * compared with the full tableau implementation used before.
+ *   c++ -O3 -I.. bench-lp.cc
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. the cases are
+ *   small:  the problems of test-lp.cc
+ *   dense:  random problems with m constraints and n variables
+ *   sparse: random problems with a few nonzeros in each constraint
+ *   affine: problems of the same form as the non-existence test by
+ *           LP in allsol-affine (USE_LP)
+ * "check" is the sum of the minimums.
+ */
+
+#include <iostream>
+#include <list>
+#include <boost/random.hpp>
+#include <kv/lp.hpp>
+#include "bench.hpp"
+
+namespace ub = boost::numeric::ublas;
+
+typedef std::list< ub::vector<double> > clist;
+
+
+struct problem {
+	ub::vector<double> objfunc;
+	clist constraints;
+};
+
+void small_problems(std::vector<problem>& ps)
+{
+	problem p;
+	ub::vector<double> tmp;
+
+	p.objfunc.resize(3);
+	p.objfunc(0) = 0.; p.objfunc(1) = -2.; p.objfunc(2) = -1.;
+	tmp.resize(3);
+	tmp(0) = -5.; tmp(1) = 1.; tmp(2) = -1.; p.constraints.push_back(tmp);
+	tmp(0) = -10.; tmp(1) = 1.; tmp(2) = 2.; p.constraints.push_back(tmp);
+	ps.push_back(p);
+
+	p.constraints.clear();
+	p.objfunc.resize(4);
+	p.objfunc(0) = 0.; p.objfunc(1) = 1.; p.objfunc(2) = 0.; p.objfunc(3) = -1.;
+	tmp.resize(4);
+	tmp(0) = -2.; tmp(1) = 1.; tmp(2) = 0.; tmp(3) = 0.; p.constraints.push_back(tmp);
+	tmp(0) = 0.; tmp(1) = -2.; tmp(2) = 1.; tmp(3) = 0.; p.constraints.push_back(tmp);
+	tmp(0) = -4.; tmp(1) = 4.; tmp(2) = -1.; tmp(3) = 0.; p.constraints.push_back(tmp);
+	tmp(0) = 0.; tmp(1) = -2.; tmp(2) = 0.; tmp(3) = 1.; p.constraints.push_back(tmp);
+	tmp(0) = 0.; tmp(1) = -4.; tmp(2) = 2.; tmp(3) = 1.; p.constraints.push_back(tmp);
+	tmp(0) = -4.; tmp(1) = 6.; tmp(2) = -2.; tmp(3) = -1.; p.constraints.push_back(tmp);
+	ps.push_back(p);
+}
+
+// m random constraints with nz nonzeros (all if nz = 0) and x_j <= 10
+// so that the problem is bounded.
+
+void random_problems(std::vector<problem>& ps, int np, int m, int n, int nz)
+{
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand1(boost::mt19937(m * 1000 + n), boost::uniform_real<>(-1., 1.));
+	problem p;
+	ub::vector<double> tmp;
+	int i, j, k;
+
+	for (k=0; k<np; k++) {
+		p.constraints.clear();
+		p.objfunc.resize(n+1);
+		p.objfunc(0) = 0.;
+		for (j=1; j<=n; j++) p.objfunc(j) = rand1();
+		tmp.resize(n+1);
+		for (i=0; i<m; i++) {
+			tmp(0) = -1. - std::abs(rand1());
+			for (j=1; j<=n; j++) tmp(j) = (nz == 0) ? rand1() : 0.;
+			for (j=0; j<nz; j++) tmp(1 + (int)((rand1() + 1.) * 0.5 * n) % n) = rand1();
+			p.constraints.push_back(tmp);
+		}
+		for (j=1; j<=n; j++) {
+			tmp = ub::zero_vector<double>(n+1);
+			tmp(0) = -10.;
+			tmp(j) = 1.;
+			p.constraints.push_back(tmp);
+		}
+		ps.push_back(p);
+	}
+}
+
+// the same form as the LP of allsol-affine: s dense rows of ep noise
+// symbols and the rows x_i + x_(ep+i) <= 2, the objective is minus the
+// sum of the constraints.
+
+void affine_problems(std::vector<problem>& ps, int np, int s, int ep)
+{
+	boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand1(boost::mt19937(s * 1000 + ep), boost::uniform_real<>(-1., 1.));
+	problem p;
+	ub::vector<double> tmp;
+	int i, j, k;
+	int lp_size = 1 + 2 * ep;
+
+	for (k=0; k<np; k++) {
+		p.constraints.clear();
+		tmp.resize(lp_size);
+		for (i=0; i<s; i++) {
+			tmp(0) = -0.1 * std::abs(rand1());
+			for (j=1; j<lp_size; j++) tmp(j) = 0.;
+			for (j=1; j<=ep; j++) tmp(j) = (j <= s || j == s + i + 1) ? rand1() : 0.01 * rand1();
+			p.constraints.push_back(tmp);
+		}
+		for (i=0; i<ep; i++) {
+			for (j=0; j<lp_size; j++) tmp(j) = 0.;
+			tmp(0) = -2.;
+			tmp(1 + i) = 1.;
+			tmp(ep + 1 + i) = 1.;
+			p.constraints.push_back(tmp);
+		}
+		p.objfunc = ub::zero_vector<double>(lp_size);
+		for (clist::iterator q=p.constraints.begin(); q!=p.constraints.end(); q++) {
+			p.objfunc -= *q;
+		}
+		ps.push_back(p);
+	}
+}
+
+// type 0: previous lp_minimize, 1: lp_minimize,
+// 2: previous lp_minimize_verified (round = -1), 3: lp_minimize_verified
+
+struct lp_case {
+	std::vector<problem> ps;
+	int type;
+
+	lp_case(const std::vector<problem>& ps, int type) : ps(ps), type(type) {}
+
+	double operator()() {
+		double r = 0.;
+
+		for (int k=0; k<(int)ps.size(); k++) {
+			switch (type) {
+			case 0: r += kv::lp_sub::tableau_minimize(ps[k].objfunc, ps[k].constraints); break;
+			case 1: r += kv::lp_minimize(ps[k].objfunc, ps[k].constraints); break;
+			case 2: r += kv::lp_sub::tableau_minimize_verified(ps[k].objfunc, ps[k].constraints, -1); break;
+			case 3: r += kv::lp_minimize_verified(ps[k].objfunc, ps[k].constraints, -1); break;
+			}
+		}
+
+		return r;
+	}
+};
+
+void cases(bench::driver& d, const char *name, const std::string& param, const std::vector<problem>& ps)
+{
+	const char *types[] = {"tableau", "revised", "tableau_verified", "revised_verified"};
+
+	for (int type=0; type<4; type++) {
+		d.run(std::string(name) + "_" + types[type], param, lp_case(ps, type));
+	}
+}
+
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "lp");
+	std::vector<problem> ps;
+	int n;
+
+	small_problems(ps);
+	cases(d, "small", "test-lp x2", ps);
+
+	for (n=20; n<=80; n*=2) {
+		ps.clear();
+		random_problems(ps, 4, n, n, 0);
+		cases(d, "dense", bench::str(n) + "x" + bench::str(n), ps);
+	}
+
+	for (n=50; n<=200; n*=2) {
+		ps.clear();
+		random_problems(ps, 4, n, 2 * n, 3);
+		cases(d, "sparse", bench::str(n) + "x" + bench::str(2 * n), ps);
+	}
+
+	for (n=5; n<=20; n*=2) {
+		ps.clear();
+		affine_problems(ps, 4, n, 5 * n);
+		cases(d, "affine", "s=" + bench::str(n) + " ep=" + bench::str(5 * n), ps);
+	}
+}
@@ -0,0 +1,78 @@
+/*
+ * benchmark of interval< mpfr<106> > and interval< mpfr<212> > arithmetic.
+ * compile with the storage of mpfr<N> to be measured, e.g.
+ *   c++ -O3 -I.. bench-mpfr.cc -lmpfr -lgmp                   (inline)
+ *   c++ -O3 -I.. -DMPFR_INLINE=0 bench-mpfr.cc -lmpfr -lgmp   (heap)
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. each case applies an operation to NV
+ * intervals NT times with the precision given by param. "check" is the
+ * upper bound of the last result.
+ */
+
+#include <iostream>
+#include <vector>
+#include <kv/interval.hpp>
+#include <kv/mpfr.hpp>
+#include <kv/rmpfr.hpp>
+#include "bench.hpp"
+
+#ifndef NV
+#define NV 1000
+#endif
+
+#ifndef NT
+#define NT 200
+#endif
+
+template <int P> struct ops {
+	typedef kv::interval< kv::mpfr<P> > itv;
+
+	static std::vector<itv>& x() { static std::vector<itv> v(NV); return v; }
+	static std::vector<itv>& y() { static std::vector<itv> v(NV); return v; }
+	static std::vector<itv>& z() { static std::vector<itv> v(NV); return v; }
+
+	static void op_add() { for (int i=0; i<NV; i++) z()[i] = x()[i] + y()[i]; }
+	static void op_mul() { for (int i=0; i<NV; i++) z()[i] = x()[i] * y()[i]; }
+	static void op_div() { for (int i=0; i<NV; i++) z()[i] = x()[i] / y()[i]; }
+	static void op_sqrt() { for (int i=0; i<NV; i++) z()[i] = sqrt(y()[i]); }
+	static void op_exp() { for (int i=0; i<NV; i++) z()[i] = exp(x()[i]); }
+	static void op_expr() { for (int i=0; i<NV; i++) z()[i] = (x()[i] + 1.) * y()[i] - x()[i] / (y()[i] + 2.); }
+
+	static void init() {
+		for (int i=0; i<NV; i++) {
+			x()[i] = itv(1. + i * 1e-3, 1. + i * 1e-3 + 1e-10) / 3.;
+			y()[i] = itv(2. + i * 1e-3, 2. + i * 1e-3 + 1e-10) / 7.;
+		}
+	}
+
+	struct op_case {
+		void (*f)();
+
+		op_case(void (*f)()) : f(f) {}
+
+		double operator()() {
+			for (int i=0; i<NT; i++) f();
+			return (double)z()[NV-1].upper();
+		}
+	};
+
+	static void run(bench::driver& d) {
+		std::string param = bench::str(P);
+
+		init();
+		d.run("add", param, op_case(op_add));
+		d.run("mul", param, op_case(op_mul));
+		d.run("div", param, op_case(op_div));
+		d.run("sqrt", param, op_case(op_sqrt));
+		d.run("exp", param, op_case(op_exp));
+		d.run("expr", param, op_case(op_expr));
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "mpfr");
+
+	ops<106>::run(d);
+	ops<212>::run(d);
+}
@@ -0,0 +1,137 @@
+/*
+ * scaling of odelong_batch / odelong_maffine_batch with the number of
+ * threads for the van der Pol equation (example/test-vdp.cc) started
+ * from a grid of small initial boxes.
+ *   c++ -O3 -fopenmp -I.. bench-ode-batch.cc
+ *   c++ -O3 -fopenmp -I.. -DNGRID=8 bench-ode-batch.cc      (8 x 8 boxes)
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. param is "serial" for the loop of
+ * odelong / odelong_maffine over the boxes, and the number of threads
+ * (1, 2, ... up to OMP_NUM_THREADS) for the batch. "check" is 1 if the
+ * results are the same as the ones of the serial loop, and 0 otherwise.
+ */
+
+#include <iostream>
+#include <vector>
+#include <omp.h>
+#include <kv/ode-batch.hpp>
+#include "bench.hpp"
+
+#ifndef NGRID
+#define NGRID 4
+#endif
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+typedef std::vector< ub::vector<itv> > boxes;
+
+struct VDP {
+	double mu;
+	VDP(double mu) : mu(mu) {}
+
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(2);
+
+		y(0) = x(1);
+		y(1) = mu * (1. - x(0)*x(0)) * x(1) - x(0);
+
+		return y;
+	}
+};
+
+bool same(const boxes& x, const boxes& y)
+{
+	int i, j;
+
+	if (x.size() != y.size()) return false;
+	for (i=0; i<(int)x.size(); i++) {
+		for (j=0; j<(int)x[i].size(); j++) {
+			if (x[i](j).lower() != y[i](j).lower()) return false;
+			if (x[i](j).upper() != y[i](j).upper()) return false;
+		}
+	}
+	return true;
+}
+
+// the serial loop (th = 0) is run first and keeps its results in x1
+
+struct batch_case {
+	bool maffine;
+	int th;
+	const boxes& init;
+	boxes& x1;
+
+	batch_case(bool maffine, int th, const boxes& init, boxes& x1) : maffine(maffine), th(th), init(init), x1(x1) {}
+
+	double operator()() {
+		boxes x;
+		std::vector<int> status;
+		std::vector<itv> reached;
+		itv end;
+		int i;
+		kv::ode_param<double> p;
+
+		p.set_order(18);
+		end = 2.;
+
+		x = init;
+		if (th == 0) {
+			omp_set_num_threads(1);
+			for (i=0; i<(int)x.size(); i++) {
+				itv e = end;
+				if (maffine) {
+					kv::odelong_maffine(VDP(1.), x[i], itv(0.), e, p);
+				} else {
+					kv::odelong(VDP(1.), x[i], itv(0.), e, p);
+				}
+			}
+			x1 = x;
+		} else {
+			omp_set_num_threads(th);
+			if (maffine) {
+				kv::odelong_maffine_batch(VDP(1.), x, itv(0.), end, status, reached, p);
+			} else {
+				kv::odelong_batch(VDP(1.), x, itv(0.), end, status, reached, p);
+			}
+		}
+
+		return same(x, x1) ? 1. : 0.;
+	}
+};
+
+void cases(bench::driver& d, bool maffine, const boxes& init, const char *name, int maxth)
+{
+	boxes x1;
+
+	d.run(name, "serial", batch_case(maffine, 0, init, x1));
+	for (int th=1; th<=maxth; th++) {
+		d.run(name, "threads=" + bench::str(th), batch_case(maffine, th, init, x1));
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "ode-batch");
+	boxes init;
+	ub::vector<itv> x(2);
+	int maxth, k, i, j;
+
+	maxth = omp_get_max_threads();
+	k = NGRID;
+
+	// k x k boxes of width 1e-4 on [-2, 2]^2. the boxes near the
+	// origin take longer steps than the ones on the limit cycle.
+	for (i=0; i<k; i++) {
+		for (j=0; j<k; j++) {
+			x(0) = -2. + 4. * i / (k - 1);
+			x(1) = -2. + 4. * j / (k - 1);
+			x(0) = itv(x(0).lower(), x(0).lower() + 1e-4);
+			x(1) = itv(x(1).lower(), x(1).lower() + 1e-4);
+			init.push_back(x);
+		}
+	}
+
+	cases(d, false, init, "odelong", maxth);
+	cases(d, true, init, "odelong_maffine", maxth);
+}
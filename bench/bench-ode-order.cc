@@ -0,0 +1,93 @@
+/*
+ * per-step cost of the ODE solvers for small systems (Lorenz, Rossler)
+ * with the orders 12, 16, 20, 24 and 30.
+ * compile with the storage of psa to be measured, e.g.
+ *   c++ -O3 -I.. bench-ode-order.cc                        (heap)
+ *   c++ -O3 -I.. -DPSA_FIXED_ORDER=30 bench-ode-order.cc   (fixed)
+ * and of the coefficients with the Jacobian (odelong_qr_lohner)
+ *   c++ -O3 -I.. -DODE_JET_MAX=0 bench-ode-order.cc        (autodif)
+ *   c++ -O3 -I.. bench-ode-order.cc                        (jet)
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. "check" is the radius of x(0) at the
+ * end (or at the time reached).
+ */
+
+#include <iostream>
+#include <kv/ode.hpp>
+#include <kv/ode-maffine.hpp>
+#include <kv/ode-qr-lohner.hpp>
+#include "bench.hpp"
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+struct Rossler {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = - x(1) - x(2);
+		y(1) = x(0) + 0.2 * x(1);
+		y(2) = 0.2 + x(2) * (x(0) - 5.7);
+
+		return y;
+	}
+};
+
+template <class F> struct order_case {
+	F f;
+	int k, order;
+	double x0, x1, x2, te;
+
+	order_case(F f, int k, int order, double x0, double x1, double x2, double te) : f(f), k(k), order(order), x0(x0), x1(x1), x2(x2), te(te) {}
+
+	double operator()() {
+		ub::vector<itv> x(3);
+		itv end;
+
+		x(0) = x0; x(1) = x1; x(2) = x2;
+		end = te;
+		if (k == 0) {
+			kv::odelong(f, x, itv(0.), end, kv::ode_param<double>().set_order(order));
+		} else if (k == 1) {
+			kv::odelong_maffine(f, x, itv(0.), end, kv::ode_param<double>().set_order(order));
+		} else {
+			kv::odelong_qr_lohner(f, x, itv(0.), end, kv::ode_param<double>().set_order(order));
+		}
+
+		return rad(x(0));
+	}
+};
+
+template <class F> void cases(bench::driver& d, F f, const char *name, double x0, double x1, double x2, double te)
+{
+	static const int orders[] = {12, 16, 20, 24, 30};
+	const char *solvers[] = {"odelong", "odelong_maffine", "odelong_qr_lohner"};
+	int i, k;
+
+	for (k=0; k<3; k++) {
+		for (i=0; i<5; i++) {
+			d.run(solvers[k], std::string(name) + " order=" + bench::str(orders[i]), order_case<F>(f, k, orders[i], x0, x1, x2, te));
+		}
+	}
+}
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "ode-order");
+
+	cases(d, Lorenz(), "Lorenz", 15., 15., 36., 1.);
+	cases(d, Rossler(), "Rossler", 1., 0., 0., 10.);
+}
@@ -0,0 +1,77 @@
+/*
+ * count heap allocations and measure time of odelong for the Lorenz
+ * equation (same problem as test-ode.cc).
+ * compile with the allocator of psa to be measured, e.g.
+ *   c++ -O3 -I.. bench-psa-alloc.cc                  (std::allocator)
+ *   c++ -O3 -I.. -DPSA_POOL=1 bench-psa-alloc.cc     (psa_pool_allocator)
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. "check" is the number of heap
+ * allocations of the last repetition (with the pool, the first one
+ * allocates more while the free lists fill up).
+ */
+
+#include <iostream>
+#include <cstdlib>
+#include <new>
+#include <kv/ode.hpp>
+#include "bench.hpp"
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+static unsigned long long nalloc = 0;
+
+void* operator new(std::size_t n)
+{
+	void* p;
+
+	nalloc++;
+	p = std::malloc(n == 0 ? 1 : n);
+	if (p == NULL) throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+double odelong_case()
+{
+	ub::vector<itv> x(3);
+	itv end;
+	unsigned long long n0;
+
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+	end = 10.;
+
+	n0 = nalloc;
+	kv::odelong(Lorenz(), x, itv(0.), end);
+
+	return (double)(nalloc - n0);
+}
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "psa-alloc");
+
+	d.run("odelong", "Lorenz t=10", odelong_case);
+}
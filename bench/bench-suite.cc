@@ -0,0 +1,331 @@
+/*
+ * benchmark suite of the main parts of kv for tracking performance.
+ * compile with the configuration to be measured, e.g.
+ *   c++ -O3 -I.. bench-suite.cc                                (hwround)
+ *   c++ -O3 -I.. -DKV_FASTROUND bench-suite.cc                 (hwround, MXCSR)
+ *   c++ -O3 -I.. -DKV_USE_SSE2 bench-suite.cc                  (sse2 packed)
+ *   c++ -O3 -I.. -DKV_NOHWROUND bench-suite.cc                 (nohwround)
+ *   c++ -O3 -I.. -mavx512f -DKV_USE_AVX512 bench-suite.cc      (avx512)
+ *   c++ -O3 -I.. -DBENCH_MPFR bench-suite.cc -lmpfr -lgmp      (with interval<mpfr>)
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. the cases are
+ *   interval, interval_dd, interval_mpfr: +, *, /, sqrt, exp on vectors
+ *   psa: multiplication, exp and sin of order 10, 20, 30
+ *   odelong: Lorenz (odelong), van der Pol and 3-body (odelong_maffine)
+ *   allsol: some problems of example/allsolexample.cc
+ *   defint: defint and defint_autostep
+ *   vleq, veig: random matrices
+ */
+
+#include <iostream>
+#include <vector>
+#include <boost/random.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/dd.hpp>
+#include <kv/rdd.hpp>
+#ifdef BENCH_MPFR
+#include <kv/mpfr.hpp>
+#include <kv/rmpfr.hpp>
+#endif
+#include <kv/psa.hpp>
+#include <kv/ode.hpp>
+#include <kv/ode-maffine.hpp>
+#include <kv/allsol.hpp>
+#include <kv/defint.hpp>
+#include <kv/vleq.hpp>
+#include <kv/eig.hpp>
+#include "../example/allsolexample.hpp"
+#include "bench.hpp"
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+
+// arithmetic on vectors of intervals
+
+template <class T> struct interval_op {
+	int op, nv, nt;
+	std::vector< kv::interval<T> > x, y, z;
+
+	interval_op(int op, int nv, int nt) : op(op), nv(nv), nt(nt), x(nv), y(nv), z(nv) {
+		for (int i=0; i<nv; i++) {
+			x[i] = kv::interval<T>(1. + i * 1e-3, 1. + i * 1e-3 + 1e-10) / 3.;
+			y[i] = kv::interval<T>(2. + i * 1e-3, 2. + i * 1e-3 + 1e-10) / 7.;
+		}
+	}
+
+	double operator()() {
+		int i, j;
+
+		for (j=0; j<nt; j++) {
+			switch (op) {
+			case 0: for (i=0; i<nv; i++) z[i] = x[i] + y[i]; break;
+			case 1: for (i=0; i<nv; i++) z[i] = x[i] * y[i]; break;
+			case 2: for (i=0; i<nv; i++) z[i] = x[i] / y[i]; break;
+			case 3: for (i=0; i<nv; i++) z[i] = sqrt(y[i]); break;
+			case 4: for (i=0; i<nv; i++) z[i] = exp(x[i]); break;
+			}
+		}
+
+		return (double)z[nv-1].upper();
+	}
+};
+
+template <class T> void interval_cases(bench::driver& d, const char *name, int nv, int nt)
+{
+	const char *ops[] = {"add", "mul", "div", "sqrt", "exp"};
+
+	for (int op=0; op<5; op++) {
+		d.run(name, ops[op], interval_op<T>(op, nv, nt));
+	}
+}
+
+
+// power series arithmetic
+
+struct psa_op {
+	int op, order, nt;
+	kv::psa<itv> x, y, z;
+
+	psa_op(int op, int order, int nt) : op(op), order(order), nt(nt) {
+		x.v.resize(order + 1);
+		y.v.resize(order + 1);
+		for (int i=0; i<=order; i++) {
+			x.v(i) = itv(1.) / (i + 1.);
+			y.v(i) = itv(1., 1. + 1e-10) / (i + 2.);
+		}
+	}
+
+	double operator()() {
+		kv::psa<itv>::mode() = 1;
+		for (int j=0; j<nt; j++) {
+			switch (op) {
+			case 0: z = x * y; break;
+			case 1: z = exp(x); break;
+			case 2: z = sin(x); break;
+			}
+		}
+
+		return z.v(order).upper();
+	}
+};
+
+
+// ODE
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+struct VDP {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(2);
+
+		y(0) = x(1);
+		y(1) = (1. - x(0)*x(0)) * x(1) - x(0);
+
+		return y;
+	}
+};
+
+struct ThreeBody {
+	template <class T> T pow23(T x, T y) {
+		T tmp;
+		tmp = x*x + y*y;
+		return tmp * sqrt(tmp);
+	}
+
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(12);
+
+		T x1 = x(0);
+		T y1 = x(1);
+		T x2 = x(2);
+		T y2 = x(3);
+		T x3 = x(4);
+		T y3 = x(5);
+
+		y(0) = x(6);
+		y(1) = x(7);
+		y(2) = x(8);
+		y(3) = x(9);
+		y(4) = x(10);
+		y(5) = x(11);
+
+		T d12 = pow23(x1-x2,y1-y2);
+		T d13 = pow23(x1-x3,y1-y3);
+		T d23 = pow23(x2-x3,y2-y3);
+
+		y(6) = (-12.*(x1-x2)/d12 - 15.*(x1-x3)/d13) / 3.;
+		y(7) = (-12.*(y1-y2)/d12 - 15.*(y1-y3)/d13) / 3.;
+		y(8) = (12.*(x1-x2)/d12 - 20.*(x2-x3)/d23) / 4.;
+		y(9) = (12.*(y1-y2)/d12 - 20.*(y2-y3)/d23) / 4.;
+		y(10) = (15.*(x1-x3)/d13 + 20.*(x2-x3)/d23) / 5.;
+		y(11) = (15.*(y1-y3)/d13 + 20.*(y2-y3)/d23) / 5.;
+
+		return y;
+	}
+};
+
+template <class F> struct odelong_case {
+	ub::vector<itv> x;
+	double end;
+	bool maffine;
+
+	odelong_case(const ub::vector<itv>& x, double end, bool maffine) : x(x), end(end), maffine(maffine) {}
+
+	double operator()() {
+		ub::vector<itv> y = x;
+		itv e(end);
+		int r;
+
+		if (maffine) {
+			r = kv::odelong_maffine(F(), y, itv(0.), e, kv::ode_param<double>().set_restart_max(10));
+		} else {
+			r = kv::odelong(F(), y, itv(0.), e);
+		}
+		if (r != 2) return 0.;
+
+		return y(0).upper();
+	}
+};
+
+
+// all solutions
+
+template <class F> struct allsol_case {
+	int nt;
+
+	allsol_case(int nt) : nt(nt) {}
+
+	double operator()() {
+		ub::vector<itv> I;
+		int r = 0;
+
+		F().range(I);
+		for (int j=0; j<nt; j++) r = kv::allsol(F(), I, 0).size();
+		return (double)r;
+	}
+};
+
+
+// definite integral
+
+struct Func {
+	template <class T> T operator() (const T& x) {
+		return exp(-x * x) * sin(10. * x) / (1. + x);
+	}
+};
+
+struct defint_case {
+	bool autostep;
+
+	defint_case(bool autostep) : autostep(autostep) {}
+
+	double operator()() {
+		if (autostep) {
+			return kv::defint_autostep(Func(), itv(0.), itv(4.), 16).upper();
+		}
+		return kv::defint(Func(), itv(0.), itv(4.), 16, 200).upper();
+	}
+};
+
+
+// linear equation and eigenvalues
+
+struct vleq_case {
+	ub::matrix<itv> a, b;
+
+	vleq_case(int n) : a(n, n), b(n, n) {
+		boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(1), boost::uniform_real<>(-1., 1.));
+
+		for (int i=0; i<n; i++) {
+			for (int j=0; j<n; j++) {
+				a(i, j) = rand();
+				b(i, j) = rand();
+			}
+		}
+	}
+
+	double operator()() {
+		ub::matrix<itv> x;
+
+		if (!kv::vleq(a, b, x)) return 0.;
+		return x(0, 0).upper();
+	}
+};
+
+struct veig_case {
+	ub::matrix<double> a;
+
+	veig_case(int n) : a(n, n) {
+		boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand(boost::mt19937(1), boost::uniform_real<>(-1., 1.));
+
+		for (int i=0; i<n; i++) {
+			for (int j=0; j<n; j++) {
+				a(i, j) = rand();
+			}
+		}
+	}
+
+	double operator()() {
+		ub::vector< kv::complex<itv> > v;
+
+		if (!kv::veig(a, v)) return 0.;
+		return v(0).real().upper();
+	}
+};
+
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "suite");
+	ub::vector<itv> x;
+	int order;
+
+	interval_cases<double>(d, "interval", 1000, 1000);
+	interval_cases<kv::dd>(d, "interval_dd", 1000, 100);
+	#ifdef BENCH_MPFR
+	interval_cases< kv::mpfr<106> >(d, "interval_mpfr", 1000, 20);
+	#endif
+
+	for (order=10; order<=30; order+=10) {
+		d.run("psa_mul", bench::str(order), psa_op(0, order, 20000));
+		d.run("psa_exp", bench::str(order), psa_op(1, order, 1000));
+		d.run("psa_sin", bench::str(order), psa_op(2, order, 1000));
+	}
+
+	x.resize(3);
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+	d.run("odelong", "Lorenz", odelong_case<Lorenz>(x, 1., false));
+	x.resize(2);
+	x(0) = itv(1., 1.01); x(1) = itv(1., 1.01);
+	d.run("odelong_maffine", "VDP", odelong_case<VDP>(x, 5., true));
+	x.resize(12);
+	x(0) = 1.; x(1) = 3.;
+	x(2) = -2.; x(3) = -1.;
+	x(4) = 1.; x(5) = -1.;
+	x(6) = x(7) = x(8) = x(9) = x(10) = x(11) = 0.;
+	d.run("odelong_maffine", "ThreeBody", odelong_case<ThreeBody>(x, 1., true));
+
+	d.run("allsol", "Matsu1", allsol_case<Matsu1>(100));
+	d.run("allsol", "Hansen1", allsol_case<Hansen1>(20));
+	d.run("allsol", "GE1", allsol_case<GE1>(20));
+	d.run("allsol", "Shinohara1", allsol_case<Shinohara1>(1));
+
+	d.run("defint", "200", defint_case(false));
+	d.run("defint_autostep", "16", defint_case(true));
+
+	d.run("vleq", "100", vleq_case(100));
+	d.run("veig", "30", veig_case(30));
+}
@@ -0,0 +1,151 @@
+/*
+ * vleq for many right-hand sides (n x 2n as in veig) compared with the
+ * column by column residual computation used before.
+ *   c++ -O3 -I.. bench-vleq.cc
+ *   c++ -O3 -fopenmp -I.. bench-vleq.cc   (1, 2, 4, ... up to OMP_NUM_THREADS)
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ * see bench.hpp for the output. param is "columnwise" for the previous
+ * implementation and the number of threads for vleq. "check" is 1 if
+ * the enclosure is identical to the one of the previous
+ * implementation, and 0 otherwise.
+ */
+
+#include <iostream>
+#include <boost/random.hpp>
+#include <kv/vleq.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#include "bench.hpp"
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand1(boost::mt19937(1), boost::uniform_real<>(-1., 1.));
+
+// previous implementation
+
+template <class T>
+bool vleq_columnwise(
+	const ub::matrix< kv::interval<T> >& a,
+	const ub::matrix< kv::interval<T> >& b,
+	ub::matrix< kv::interval<T> >& x)
+{
+	int i, j;
+	int s1 = b.size1();
+	int s2 = b.size2();
+	ub::matrix<T> R, E;
+	ub::matrix< kv::interval<T> > EmRA;
+	ub::vector< kv::interval<T> > xtmp(s1), btmp(s1), rtmp(s1);
+	bool bo;
+	T norm1, norm2, norm3, err;
+
+	bo = kv::invert(mid(a), R);
+	if (bo == false) return false;
+
+	E = ub::identity_matrix<T>(s1);
+
+	EmRA = E - prod(R, a);
+	norm1 = kv::max_norm(EmRA);
+	kv::rop<T>::begin();
+	norm1 = kv::rop<T>::sub_down(T(1.), norm1);
+	kv::rop<T>::end();
+
+	if (norm1 <= 0.) return false;
+
+	x = prod(R, mid(b));
+
+	norm2 = kv::max_norm(R);
+
+	for (i=0; i<s2; i++) {
+		for (j=0; j<s1; j++) {
+			xtmp(j) = x(j, i);
+			btmp(j) = b(j, i);
+		}
+		rtmp = prod(a, xtmp) - btmp;
+		norm3 = kv::max_norm(rtmp);
+		kv::rop<T>::begin();
+		err = kv::rop<T>::div_up(kv::rop<T>::mul_up(norm2, norm3), norm1);
+		kv::rop<T>::end();
+		for (j=0; j<s1; j++) {
+			x(j, i) += kv::interval<T>(-err, err);
+		}
+	}
+
+	return true;
+}
+
+bool same(const ub::matrix<itv>& x1, const ub::matrix<itv>& x2)
+{
+	int i, j;
+
+	if (x1.size1() != x2.size1() || x1.size2() != x2.size2()) return false;
+	for (i=0; i<(int)x1.size1(); i++) {
+		for (j=0; j<(int)x1.size2(); j++) {
+			if (x1(i, j).lower() != x2(i, j).lower() || x1(i, j).upper() != x2(i, j).upper()) return false;
+		}
+	}
+	return true;
+}
+
+// the previous implementation (th = 0) is run first and keeps its
+// enclosure in x1
+
+struct vleq_case {
+	int th;
+	const ub::matrix<itv>& a;
+	const ub::matrix<itv>& b;
+	ub::matrix<itv>& x1;
+
+	vleq_case(int th, const ub::matrix<itv>& a, const ub::matrix<itv>& b, ub::matrix<itv>& x1) : th(th), a(a), b(b), x1(x1) {}
+
+	double operator()() {
+		ub::matrix<itv> x;
+
+		if (th == 0) {
+			vleq_columnwise(a, b, x);
+			x1 = x;
+		} else {
+#ifdef _OPENMP
+			omp_set_num_threads(th);
+#endif
+			kv::vleq(a, b, x);
+		}
+
+		return same(x, x1) ? 1. : 0.;
+	}
+};
+
+int main(int argc, char *argv[])
+{
+	bench::driver d(argc, argv, "vleq");
+	int n, i, j, th, maxth;
+	std::string param;
+
+#ifdef _OPENMP
+	maxth = omp_get_max_threads();
+#else
+	maxth = 1;
+#endif
+
+	for (n=100; n<=300; n+=100) {
+		ub::matrix<itv> a(n, n), b(n, 2 * n), x1;
+
+		for (i=0; i<n; i++) {
+			for (j=0; j<n; j++) {
+				a(i, j) = rand1() + itv(-1e-10, 1e-10);
+			}
+			a(i, i) += n;
+			for (j=0; j<2*n; j++) {
+				b(i, j) = rand1() + itv(-1e-10, 1e-10);
+			}
+		}
+
+		param = "n=" + bench::str(n) + " rhs=" + bench::str(2 * n);
+		d.run("vleq", param + " columnwise", vleq_case(0, a, b, x1));
+		for (th=1; th<=maxth; th*=2) {
+			d.run("vleq", param + " threads=" + bench::str(th), vleq_case(th, a, b, x1));
+		}
+	}
+}
@@ -0,0 +1,239 @@
+/*
+ * common driver of the benchmark programs
+ *
+ *   ./a.out [-r repetitions] [-j] [-f filter]
+ *     -r n   run each case n times (default 5)
+ *     -j     print JSON instead of CSV
+ *     -f s   run only the cases whose name contains s
+ *
+ * a case is a function (or a function object) which returns double.
+ * the returned value is printed as "check" so that a change of the
+ * result is noticed together with a change of the time. the mean,
+ * the standard deviation, the minimum and the maximum of the time of
+ * the repetitions are printed with the configuration (rounding
+ * backend, storage of psa, affine and mpfr, compiler) given by the
+ * macros, so bench.hpp must be included after the headers of kv.
+ * the CSV is quoted as RFC 4180, and the values which are not finite
+ * are null in the JSON.
+ */
+
+#ifndef BENCH_HPP
+#define BENCH_HPP
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace bench {
+
+inline double seconds()
+{
+#ifdef _OPENMP
+	return omp_get_wtime();
+#else
+	return (double)std::clock() / CLOCKS_PER_SEC;
+#endif
+}
+
+template <class C> std::string str(const C& x)
+{
+	std::ostringstream s;
+	s << x;
+	return s.str();
+}
+
+// configuration given by the macros
+
+inline std::string config()
+{
+	std::string s;
+
+#if defined(KV_NOHWROUND)
+	s = "nohwround";
+#elif defined(KV_USE_AVX512)
+	s = "avx512";
+#elif defined(KV_USE_SSE2)
+	s = "sse2";
+#elif defined(KV_FASTROUND)
+	s = "hwround-fastround";
+#else
+	s = "hwround";
+#endif
+#if defined(PSA_FIXED_ORDER) && PSA_FIXED_ORDER
+	s += " psa-fixed";
+#endif
+#if defined(PSA_POOL) && PSA_POOL
+	s += " psa-pool";
+#endif
+#if defined(AFFINE_SPARSE) && AFFINE_SPARSE
+	s += " affine-sparse";
+#endif
+#if defined(AFFINE_REGISTRY) && AFFINE_REGISTRY
+	s += " affine-registry";
+#endif
+#if defined(MPFR_INLINE) && !MPFR_INLINE
+	s += " mpfr-heap";
+#endif
+#ifdef ODE_JET_MAX
+	s += " ode-jet(" + str(ODE_JET_MAX) + ")";
+#endif
+#if defined(DEFINT_PARALLEL) && DEFINT_PARALLEL
+	s += " defint-parallel";
+#endif
+#ifdef _OPENMP
+	s += " openmp(" + str(omp_get_max_threads()) + ")";
+#endif
+#ifdef __VERSION__
+	s += " " + std::string(__VERSION__);
+#endif
+
+	return s;
+}
+
+// field of CSV (RFC 4180): quoted if it contains a comma, a double
+// quote or a line break, with the double quotes doubled
+
+inline std::string csv(const std::string& x)
+{
+	std::string s = "\"";
+	int i;
+
+	if (x.find_first_of(",\"\r\n") == std::string::npos) return x;
+
+	for (i=0; i<(int)x.size(); i++) {
+		if (x[i] == '"') s += "\"\"";
+		else s += x[i];
+	}
+	s += "\"";
+
+	return s;
+}
+
+// string of JSON
+
+inline std::string json_string(const std::string& x)
+{
+	std::string s = "\"";
+	char buf[8];
+	int i;
+
+	for (i=0; i<(int)x.size(); i++) {
+		if (x[i] == '"') s += "\\\"";
+		else if (x[i] == '\\') s += "\\\\";
+		else if (x[i] == '\n') s += "\\n";
+		else if (x[i] == '\r') s += "\\r";
+		else if (x[i] == '\t') s += "\\t";
+		else if ((unsigned char)x[i] < 0x20) {
+			std::sprintf(buf, "\\u%04x", (unsigned char)x[i]);
+			s += buf;
+		}
+		else s += x[i];
+	}
+	s += "\"";
+
+	return s;
+}
+
+// number of JSON. inf and nan are not allowed in JSON.
+
+inline std::string json_number(double x)
+{
+	std::ostringstream s;
+
+	if (!std::isfinite(x)) return "null";
+	s.precision(17);
+	s << x;
+	return s.str();
+}
+
+class driver {
+	std::string suite;
+	std::string conf;
+	std::string filter;
+	int reps;
+	bool json;
+	int count;
+
+	driver(const driver&);
+	driver& operator=(const driver&);
+
+	public:
+
+	driver(int argc, char *argv[], const char *suite) : suite(suite), reps(5), json(false), count(0) {
+		int i;
+
+		for (i=1; i<argc; i++) {
+			if (std::strcmp(argv[i], "-r") == 0 && i+1 < argc) {
+				reps = std::atoi(argv[++i]);
+				if (reps < 1) reps = 1;
+			} else if (std::strcmp(argv[i], "-j") == 0) {
+				json = true;
+			} else if (std::strcmp(argv[i], "-f") == 0 && i+1 < argc) {
+				filter = argv[++i];
+			} else {
+				std::cerr << "usage: " << argv[0] << " [-r repetitions] [-j] [-f filter]\n";
+				std::exit(1);
+			}
+		}
+
+		conf = config();
+		std::cout.precision(17);
+		if (json) {
+			std::cout << "[\n";
+		} else {
+			std::cout << "suite,case,param,config,reps,mean,sd,min,max,check\n";
+		}
+	}
+
+	~driver() {
+		if (json) std::cout << "\n]\n";
+	}
+
+	template <class F> void run(const std::string& name, const std::string& param, F f) {
+		std::vector<double> t(reps);
+		double t0, check = 0., mean, sd, mn, mx;
+		int i;
+
+		if (!filter.empty() && name.find(filter) == std::string::npos) return;
+
+		for (i=0; i<reps; i++) {
+			t0 = seconds();
+			check = f();
+			t[i] = seconds() - t0;
+		}
+
+		mean = 0.;
+		mn = mx = t[0];
+		for (i=0; i<reps; i++) {
+			mean += t[i];
+			if (t[i] < mn) mn = t[i];
+			if (t[i] > mx) mx = t[i];
+		}
+		mean /= reps;
+		sd = 0.;
+		for (i=0; i<reps; i++) sd += (t[i] - mean) * (t[i] - mean);
+		sd = (reps > 1) ? std::sqrt(sd / (reps - 1)) : 0.;
+
+		if (json) {
+			if (count > 0) std::cout << ",\n";
+			std::cout << "{\"suite\": " << json_string(suite) << ", \"case\": " << json_string(name) << ", \"param\": " << json_string(param) << ", \"config\": " << json_string(conf) << ", \"reps\": " << reps << ", \"mean\": " << json_number(mean) << ", \"sd\": " << json_number(sd) << ", \"min\": " << json_number(mn) << ", \"max\": " << json_number(mx) << ", \"check\": " << json_number(check) << "}";
+		} else {
+			std::cout << csv(suite) << "," << csv(name) << "," << csv(param) << "," << csv(conf) << "," << reps << "," << mean << "," << sd << "," << mn << "," << mx << "," << check << "\n";
+		}
+		std::cout << std::flush;
+		count++;
+	}
+};
+
+} // namespace bench
+
+#endif // BENCH_HPP
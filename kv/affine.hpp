@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2019 Masahide Kashiwagi (kashi@waseda.jp)
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
  */
 
 #ifndef AFFINE_HPP
@@ -49,14 +49,179 @@
 #define AFFINE_MULT 0
 #endif
 
+/*
+ * select the storage of noise symbols
+ *
+ *  0: dense ub::vector<T> of size maxnum()+1 (default)
+ *  1: sparse (sorted index/coefficient pairs). only nonzero coefficients
+ *     are stored, so the cost of each operation is proportional to the
+ *     number of nonzero coefficients instead of maxnum().
+ *     the resulting enclosures are the same as the dense storage
+ *     (only the sign of zero coefficients may differ).
+ */
+
+#ifndef AFFINE_SPARSE
+#define AFFINE_SPARSE 0
+#endif
+
+/*
+ * registry of live affine objects
+ *
+ *  0: no registry (default)
+ *  1: every affine object is linked to a per-thread list. inside an
+ *     affine_compaction<T> scope, when maxnum() has grown by the
+ *     threshold, the noise symbols created in the scope which no live
+ *     object uses are removed and the others are renumbered keeping
+ *     their order (compaction). the resulting enclosures are the same.
+ *     compaction skips the objects not written since the scope began,
+ *     so code which writes the public members a or er directly (not by
+ *     the operators of affine) must call reg_touch() of the object
+ *     after that, or the object may keep removed noise symbols.
+ *     every object is linked to the list of the thread which created
+ *     it, so it must be destroyed by that thread.
+ */
+
+#ifndef AFFINE_REGISTRY
+#define AFFINE_REGISTRY 0
+#endif
+
+// default threshold of affine_compaction
+
+#ifndef AFFINE_COMPACT_MIN
+#define AFFINE_COMPACT_MIN 1024
+#endif
+
 
 namespace kv {
 
 namespace ub = boost::numeric::ublas;
 
 
+#if AFFINE_SPARSE
+
+// coefficients of affine form stored as sorted (index, value) pairs.
+// size() is the logical size, i.e. the size of the corresponding dense
+// vector. indices not stored have the coefficient 0.
+
+template <class T> class affine_sparse_vector {
+	public:
+	std::vector<int> idx;
+	std::vector<T> val;
+	int n;
+
+	affine_sparse_vector() : n(0) {}
+
+	int size() const {
+		return n;
+	}
+
+	// number of stored coefficients
+	int nnz() const {
+		return idx.size();
+	}
+
+	// position of the first stored coefficient whose index >= i
+	int offset(int i) const {
+		if (idx.empty() || idx[0] >= i) return 0;
+		return std::lower_bound(idx.begin(), idx.end(), i) - idx.begin();
+	}
+
+	void resize(int s, bool preserve = true) {
+		int k;
+
+		if (!preserve) {
+			clear();
+		} else if (s < n) {
+			k = offset(s);
+			idx.resize(k);
+			val.resize(k);
+		}
+		n = s;
+	}
+
+	void clear() {
+		idx.clear();
+		val.clear();
+	}
+
+	void reserve(int k) {
+		idx.reserve(k);
+		val.reserve(k);
+	}
+
+	// add coefficient of index i to the end. i must be larger than
+	// all the stored indices. zero is not stored.
+	void push_back(int i, const T& v) {
+		if (v == 0.) return;
+		idx.push_back(i);
+		val.push_back(v);
+	}
+
+	// copy stored coefficients of x from the position k.
+	void push_back(const affine_sparse_vector& x, int k, bool negate = false) {
+		int xs = x.nnz();
+
+		for ( ; k<xs; k++) {
+			idx.push_back(x.idx[k]);
+			val.push_back(negate ? T(-x.val[k]) : x.val[k]);
+		}
+	}
+
+	T operator()(int i) const {
+		int k = offset(i);
+		if (k < idx.size() && idx[k] == i) return val[k];
+		return T(0.);
+	}
+
+	// insert the coefficient if it is not stored.
+	T& operator()(int i) {
+		int k;
+
+		if (i >= n) n = i + 1;
+		if (idx.empty() || i > idx.back()) {
+			idx.push_back(i);
+			val.push_back(T(0.));
+			return val.back();
+		}
+		k = offset(i);
+		if (idx[k] != i) {
+			idx.insert(idx.begin() + k, i);
+			val.insert(val.begin() + k, T(0.));
+		}
+		return val[k];
+	}
+
+	friend affine_sparse_vector operator-(const affine_sparse_vector& x) {
+		affine_sparse_vector r;
+
+		r.n = x.n;
+		r.reserve(x.nnz());
+		r.push_back(x, 0, true);
+
+		return r;
+	}
+};
+
+#endif // AFFINE_SPARSE
+
+
 template <class T> class affine;
 
+#if AFFINE_REGISTRY
+
+template <class T> class affine_compaction;
+
+// statistics of the registry (per thread)
+
+struct affine_registry_stat {
+	int objects;      // live affine objects
+	int peak;         // maximum of maxnum()
+	int compactions;  // number of compactions
+	long removed;     // noise symbols removed by compactions
+};
+
+#endif // AFFINE_REGISTRY
+
 template <class C, class T> struct acceptable_s<C, affine<T> > {
 	static const bool value = boost::is_same<C, interval<T> >::value || boost::is_convertible<C, std::string>::value;
 };
@@ -83,7 +248,11 @@ template <class C, class T> struct convertible<C, affine<T> > {
 
 template <class T> class affine {
 	public:
+	#if AFFINE_SPARSE
+	affine_sparse_vector<T> a;
+	#else
 	ub::vector<T> a;
+	#endif
 	#if AFFINE_SIMPLE >= 1
 	T er;
 	#endif
@@ -96,17 +265,105 @@ template <class T> class affine {
 		return m;
 	}
 
+	#if AFFINE_REGISTRY
+	struct registry_type {
+		affine* head;
+		int gen;                     // incremented by each scope
+		affine_compaction<T>* scope; // innermost scope
+		affine_registry_stat stat;
+	};
+
+	static registry_type& registry() {
+		static registry_type r;
+		#pragma omp threadprivate(r)
+		return r;
+	}
+
+	static const affine_registry_stat& registry_stat() {
+		return registry().stat;
+	}
+
+	affine* reg_prev;
+	affine* reg_next;
+	registry_type* reg_owner;
+	int reg_gen; // generation in which the object was written last
+
+	void reg_link() {
+		registry_type& g = registry();
+
+		reg_owner = &g;
+		reg_prev = NULL;
+		reg_next = g.head;
+		if (reg_next != NULL) reg_next->reg_prev = this;
+		g.head = this;
+		reg_gen = g.gen;
+		g.stat.objects++;
+	}
+
+	// mark the object as written in the current generation. needed
+	// after writing a or er directly.
+	void reg_touch() {
+		reg_gen = registry().gen;
+	}
+
+	affine(const affine& x) : a(x.a) {
+		#if AFFINE_SIMPLE >= 1
+		er = x.er;
+		#endif
+		reg_link();
+	}
+
+	~affine() {
+		if (reg_prev != NULL) reg_prev->reg_next = reg_next;
+		else reg_owner->head = reg_next;
+		if (reg_next != NULL) reg_next->reg_prev = reg_prev;
+		reg_owner->stat.objects--;
+	}
+
+	affine& operator=(const affine& x) {
+		a = x.a;
+		#if AFFINE_SIMPLE >= 1
+		er = x.er;
+		#endif
+		reg_touch();
+		return *this;
+	}
+	#endif // AFFINE_REGISTRY
+
+	// add a new noise symbol. the coefficients of affine objects may be
+	// renumbered here (AFFINE_REGISTRY), so the sizes of the arguments
+	// must be read after this.
+
+	static int new_symbol() {
+		#if AFFINE_REGISTRY
+		registry_type& g = registry();
+		if (g.scope != NULL) g.scope->check();
+		#endif
+		maxnum()++;
+		#if AFFINE_REGISTRY
+		if (maxnum() > g.stat.peak) g.stat.peak = maxnum();
+		#endif
+		return maxnum();
+	}
+
 	friend inline T rad(const affine& x) {
 		int i, xs;
 		T r(0.);
 
-		xs = x.a.size();
-
 		rop<T>::begin();
+		#if AFFINE_SPARSE
+		xs = x.a.nnz();
+		for (i=x.a.offset(1); i<xs; i++) {
+			using std::abs;
+			r = rop<T>::add_up(r, abs(x.a.val[i]));
+		}
+		#else
+		xs = x.a.size();
 		for (i=1; i<xs; i++) {
 			using std::abs;
 			r = rop<T>::add_up(r, abs(x.a(i)));
 		}
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		r = rop<T>::add_up(r, x.er);
 		#endif
@@ -128,9 +385,15 @@ template <class T> class affine {
 
 
 	affine() {
+		#if AFFINE_REGISTRY
+		reg_link();
+		#endif
 	}
 
 	template <class C> explicit affine(const C& x, typename boost::enable_if_c< acceptable_n<C, affine>::value >::type* =0) {
+		#if AFFINE_REGISTRY
+		reg_link();
+		#endif
 		a.resize(1);
 		a(0) = x;
 		#if AFFINE_SIMPLE >= 1
@@ -141,7 +404,21 @@ template <class T> class affine {
 	template <class C> explicit affine(const C& x, typename boost::enable_if_c< acceptable_s<C, affine>::value >::type* =0) {
 		int i;
 		interval<T> I(x);
-		maxnum()++;
+		#if AFFINE_REGISTRY
+		reg_link();
+		#endif
+		new_symbol();
+
+		#if AFFINE_SPARSE
+		T c;
+		a.resize(maxnum()+1, false);
+		{
+		rop_scope<T> scope;
+		c = rop<T>::mul_up(rop<T>::add_up(I.upper(), I.lower()), T(0.5));
+		a.push_back(0, c);
+		a.push_back(maxnum(), rop<T>::sub_up(c, I.lower()));
+		}
+		#else
 		a.resize(maxnum()+1);
 
 
@@ -151,6 +428,7 @@ template <class T> class affine {
 		rop<T>::end();
 
 		for (i=1; i<maxnum(); i++) a(i) = 0.;
+		#endif
 
 		#if AFFINE_SIMPLE >= 1
 		er = 0.;
@@ -158,6 +436,9 @@ template <class T> class affine {
 	}
 
 	template <class C> typename boost::enable_if_c< acceptable_n<C, affine>::value, affine& >::type operator=(const C& x) {
+		#if AFFINE_REGISTRY
+		reg_touch();
+		#endif
 		a.resize(1);
 		a(0) = x;
 		#if AFFINE_SIMPLE >= 1
@@ -170,7 +451,21 @@ template <class T> class affine {
 	template <class C> typename boost::enable_if_c< acceptable_s<C, affine>::value, affine& >::type operator=(const C& x) {
 		int i;
 		interval<T> I(x);
-		maxnum()++;
+		#if AFFINE_REGISTRY
+		reg_touch();
+		#endif
+		new_symbol();
+
+		#if AFFINE_SPARSE
+		T c;
+		a.resize(maxnum()+1, false);
+		{
+		rop_scope<T> scope;
+		c = rop<T>::mul_up(rop<T>::add_up(I.upper(), I.lower()), T(0.5));
+		a.push_back(0, c);
+		a.push_back(maxnum(), rop<T>::sub_up(c, I.lower()));
+		}
+		#else
 		a.resize(maxnum()+1);
 
 		rop<T>::begin();
@@ -179,6 +474,7 @@ template <class T> class affine {
 		rop<T>::end();
 
 		for (i=1; i<maxnum(); i++) a(i) = 0.;
+		#endif
 
 		#if AFFINE_SIMPLE >= 1
 		er = 0.;
@@ -204,16 +500,85 @@ template <class T> class affine {
 		#endif
 	}
 
+	#if AFFINE_SPARSE
+
+	// append coefficients of x + y (or x - y) to r.a and add the
+	// rounding error to err. indices stored in only one of x and y are
+	// copied without rounding.
+	// must be called between rop<T>::begin() and rop<T>::end().
+
+	static void sparse_addsub(const affine& x, const affine& y, bool sub, affine& r, T& err) {
+		int xs, ys, i, j;
+		T tmp;
+
+		xs = x.a.nnz();
+		ys = y.a.nnz();
+		r.a.reserve(xs + ys + 1);
+
+		i = j = 0;
+		while (i < xs && j < ys) {
+			if (x.a.idx[i] < y.a.idx[j]) {
+				r.a.push_back(x.a.idx[i], x.a.val[i]);
+				i++;
+			} else if (x.a.idx[i] > y.a.idx[j]) {
+				r.a.push_back(y.a.idx[j], sub ? T(-y.a.val[j]) : y.a.val[j]);
+				j++;
+			} else {
+				if (sub) {
+					tmp = rop<T>::sub_down(x.a.val[i], y.a.val[j]);
+					err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::sub_up(x.a.val[i], y.a.val[j]), tmp));
+				} else {
+					tmp = rop<T>::add_down(x.a.val[i], y.a.val[j]);
+					err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(x.a.val[i], y.a.val[j]), tmp));
+				}
+				r.a.push_back(x.a.idx[i], tmp);
+				i++;
+				j++;
+			}
+		}
+		r.a.push_back(x.a, i);
+		r.a.push_back(y.a, j, sub);
+	}
+
+	// append coefficients of x from the position k multiplied by c
+	// (rounded downward) to r.a and add the rounding error to err.
+	// must be called between rop<T>::begin() and rop<T>::end().
+
+	static void sparse_mul(const affine& x, int k, const T& c, affine& r, T& err) {
+		int xs;
+		T tmp;
+
+		xs = x.a.nnz();
+		r.a.reserve(r.a.nnz() + xs - k + 1);
+
+		for ( ; k<xs; k++) {
+			tmp = rop<T>::mul_down(x.a.val[k], c);
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x.a.val[k], c), tmp));
+			r.a.push_back(x.a.idx[k], tmp);
+		}
+	}
+
+	#endif // AFFINE_SPARSE
+
 	friend affine operator+(const affine& x, const affine& y) {
 		affine r;
 		int xs, ys, i;
 		T err(0.);
 
 		#if AFFINE_SIMPLE == 0
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#endif
 
+		#if AFFINE_SPARSE
+		#if AFFINE_SIMPLE >= 1
+		r.a.resize(std::max(x.a.size(), y.a.size()));
+		#endif
+		{
+		rop_scope<T> scope;
+		sparse_addsub(x, y, false, r, err);
+		}
+		#else
 		xs = x.a.size();
 		ys = y.a.size();
 		if (xs > ys) {
@@ -259,6 +624,7 @@ template <class T> class affine {
 			}
 			#endif
 		}
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
 		r.er = rop<T>::add_up(rop<T>::add_up(x.er, y.er), err);
@@ -277,6 +643,31 @@ template <class T> class affine {
 		affine r;
 		int xs, ys, i;
 
+		#if AFFINE_SPARSE
+		int j;
+
+		xs = x.a.nnz();
+		ys = y.a.nnz();
+		r.a.resize(std::max(x.a.size(), y.a.size()));
+		r.a.reserve(xs + ys);
+
+		i = j = 0;
+		while (i < xs && j < ys) {
+			if (x.a.idx[i] < y.a.idx[j]) {
+				r.a.push_back(x.a.idx[i], x.a.val[i]);
+				i++;
+			} else if (x.a.idx[i] > y.a.idx[j]) {
+				r.a.push_back(y.a.idx[j], y.a.val[j]);
+				j++;
+			} else {
+				r.a.push_back(x.a.idx[i], x.a.val[i] + y.a.val[j]);
+				i++;
+				j++;
+			}
+		}
+		r.a.push_back(x.a, i);
+		r.a.push_back(y.a, j);
+		#else
 		xs = x.a.size();
 		ys = y.a.size();
 
@@ -297,6 +688,7 @@ template <class T> class affine {
 				r.a(i) = y.a(i);
 			}
 		}
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		r.er = x.er + y.er;
 		#endif
@@ -309,20 +701,23 @@ template <class T> class affine {
 		int xs, i;
 		T err;
 
-		xs = x.a.size();
-
 		#if AFFINE_SIMPLE == 0
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#else
-		r.a.resize(xs);
+		r.a.resize(x.a.size());
 		#endif
 
+		xs = x.a.size();
+
 		rop<T>::begin();
 		r.a(0) = rop<T>::add_down(x.a(0), (T)y);
 		err = rop<T>::sub_up(rop<T>::add_up(x.a(0), (T)y), r.a(0));
 		rop<T>::end();
 
+		#if AFFINE_SPARSE
+		r.a.push_back(x.a, x.a.offset(1));
+		#else
 		for (i=1; i<xs; i++) {
 			r.a(i) = x.a(i);
 		}
@@ -331,6 +726,7 @@ template <class T> class affine {
 			r.a(i) = 0.;
 		}
 		#endif
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
 		r.er = rop<T>::add_up(x.er, err);
@@ -346,20 +742,23 @@ template <class T> class affine {
 		int ys, i;
 		T err;
 
-		ys = y.a.size();
-
 		#if AFFINE_SIMPLE == 0
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#else
-		r.a.resize(ys);
+		r.a.resize(y.a.size());
 		#endif
 
+		ys = y.a.size();
+
 		rop<T>::begin();
 		r.a(0) = rop<T>::add_down((T)x, y.a(0));
 		err = rop<T>::sub_up(rop<T>::add_up((T)x, y.a(0)), r.a(0));
 		rop<T>::end();
 
+		#if AFFINE_SPARSE
+		r.a.push_back(y.a, y.a.offset(1));
+		#else
 		for (i=1; i<ys; i++) {
 			r.a(i) = y.a(i);
 		}
@@ -368,6 +767,7 @@ template <class T> class affine {
 			r.a(i) = 0.;
 		}
 		#endif
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
 		r.er = rop<T>::add_up(y.er, err);
@@ -407,10 +807,19 @@ template <class T> class affine {
 		T err(0.);
 
 		#if AFFINE_SIMPLE == 0
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#endif
 
+		#if AFFINE_SPARSE
+		#if AFFINE_SIMPLE >= 1
+		r.a.resize(std::max(x.a.size(), y.a.size()));
+		#endif
+		{
+		rop_scope<T> scope;
+		sparse_addsub(x, y, true, r, err);
+		}
+		#else
 		xs = x.a.size();
 		ys = y.a.size();
 		if (xs > ys) {
@@ -456,6 +865,7 @@ template <class T> class affine {
 			}
 			#endif
 		}
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
 		r.er = rop<T>::add_up(rop<T>::add_up(x.er, y.er), err);
@@ -471,20 +881,23 @@ template <class T> class affine {
 		int xs, i;
 		T err;
 
-		xs = x.a.size();
-
 		#if AFFINE_SIMPLE == 0
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#else
-		r.a.resize(xs);
+		r.a.resize(x.a.size());
 		#endif
 
+		xs = x.a.size();
+
 		rop<T>::begin();
 		r.a(0) = rop<T>::sub_down(x.a(0), (T)y);
 		err = rop<T>::sub_up(rop<T>::sub_up(x.a(0), (T)y), r.a(0));
 		rop<T>::end();
 
+		#if AFFINE_SPARSE
+		r.a.push_back(x.a, x.a.offset(1));
+		#else
 		for (i=1; i<xs; i++) {
 			r.a(i) = x.a(i);
 		}
@@ -493,6 +906,7 @@ template <class T> class affine {
 			r.a(i) = 0.;
 		}
 		#endif
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
 		r.er = rop<T>::add_up(x.er, err);
@@ -508,20 +922,23 @@ template <class T> class affine {
 		int ys, i;
 		T err;
 
-		ys = y.a.size();
-
 		#if AFFINE_SIMPLE == 0
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#else
-		r.a.resize(ys);
+		r.a.resize(y.a.size());
 		#endif
 
+		ys = y.a.size();
+
 		rop<T>::begin();
 		r.a(0) = rop<T>::sub_down((T)x, y.a(0));
 		err = rop<T>::sub_up(rop<T>::sub_up((T)x, y.a(0)), r.a(0));
 		rop<T>::end();
 
+		#if AFFINE_SPARSE
+		r.a.push_back(y.a, y.a.offset(1), true);
+		#else
 		for (i=1; i<ys; i++) {
 			r.a(i) = - y.a(i);
 		}
@@ -530,6 +947,7 @@ template <class T> class affine {
 			r.a(i) = 0.;
 		}
 		#endif
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		rop<T>::begin();
 		r.er = rop<T>::add_up(y.er, err);
@@ -578,25 +996,30 @@ template <class T> class affine {
 		int xs, i;
 		T err(0.);
 
-		xs = x.a.size();
-
 		#if AFFINE_SIMPLE == 0
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#else
-		r.a.resize(xs);
+		r.a.resize(x.a.size());
 		#endif
 
-		rop<T>::begin();
+		xs = x.a.size();
+
+		{
+		rop_scope<T> scope;
+		#if AFFINE_SPARSE
+		sparse_mul(x, 0, (T)y, r, err);
+		#else
 		for (i=0; i<xs; i++) {
 			r.a(i) = rop<T>::mul_down(x.a(i), (T)y);
 		}
 		for (i=0; i<xs; i++) {
 			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x.a(i), (T)y), r.a(i)));
 		}
-		rop<T>::end();
+		#endif
+		}
 
-		#if AFFINE_SIMPLE == 0
+		#if AFFINE_SIMPLE == 0 && !AFFINE_SPARSE
 		for (i=xs; i<maxnum(); i++) r.a(i) = 0.;
 		#endif
 		#if AFFINE_SIMPLE >= 1
@@ -616,25 +1039,30 @@ template <class T> class affine {
 		int ys, i;
 		T err(0.);
 
-		ys = y.a.size();
-
 		#if AFFINE_SIMPLE == 0
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#else
-		r.a.resize(ys);
+		r.a.resize(y.a.size());
 		#endif
 
-		rop<T>::begin();
+		ys = y.a.size();
+
+		{
+		rop_scope<T> scope;
+		#if AFFINE_SPARSE
+		sparse_mul(y, 0, (T)x, r, err);
+		#else
 		for (i=0; i<ys; i++) {
 			r.a(i) = rop<T>::mul_down((T)x, y.a(i));
 		}
 		for (i=0; i<ys; i++) {
 			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up((T)x, y.a(i)), r.a(i)));
 		}
-		rop<T>::end();
+		#endif
+		}
 
-		#if AFFINE_SIMPLE == 0
+		#if AFFINE_SIMPLE == 0 && !AFFINE_SPARSE
 		for (i=ys; i<maxnum(); i++) r.a(i) = 0.;
 		#endif
 		#if AFFINE_SIMPLE >= 1
@@ -763,21 +1191,55 @@ template <class T> class affine {
 
 		// if (&x == &y) return square(x);
 
-		xs = x.a.size();
-		ys = y.a.size();
-
 		#if AFFINE_SIMPLE != 2
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#else
-		r.a.resize(std::max(xs, ys));
+		r.a.resize(std::max(x.a.size(), y.a.size()));
 		#endif
 
+		xs = x.a.size();
+		ys = y.a.size();
+
 		rop<T>::begin();
 		r.a(0) = rop<T>::mul_down(x.a(0), y.a(0));
 		err = rop<T>::sub_up(rop<T>::mul_up(x.a(0), y.a(0)), r.a(0));
 		rop<T>::end();
 
+		#if AFFINE_SPARSE
+		T x0, y0, tmp;
+
+		x0 = x.a(0);
+		y0 = y.a(0);
+		xs = x.a.nnz();
+		ys = y.a.nnz();
+		r.a.reserve(xs + ys + 1);
+
+		{
+		rop_scope<T> scope;
+		i = x.a.offset(1);
+		j = y.a.offset(1);
+		while (i < xs || j < ys) {
+			if (j == ys || (i < xs && x.a.idx[i] < y.a.idx[j])) {
+				tmp = rop<T>::mul_down(y0, x.a.val[i]);
+				err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(y0, x.a.val[i]), tmp));
+				r.a.push_back(x.a.idx[i], tmp);
+				i++;
+			} else if (i == xs || x.a.idx[i] > y.a.idx[j]) {
+				tmp = rop<T>::mul_down(x0, y.a.val[j]);
+				err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::mul_up(x0, y.a.val[j]), tmp));
+				r.a.push_back(y.a.idx[j], tmp);
+				j++;
+			} else {
+				tmp = rop<T>::add_down(rop<T>::mul_down(y0, x.a.val[i]), rop<T>::mul_down(x0, y.a.val[j]));
+				err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::add_up(rop<T>::mul_up(y0, x.a.val[i]), rop<T>::mul_up(x0, y.a.val[j])), tmp));
+				r.a.push_back(x.a.idx[i], tmp);
+				i++;
+				j++;
+			}
+		}
+		}
+		#else
 		if (xs > ys) {
 			rop<T>::begin();
 			for (i=1; i<ys; i++) {
@@ -819,6 +1281,7 @@ template <class T> class affine {
 			}
 			#endif
 		}
+		#endif
 
 		#if AFFINE_MULT >= 1
 
@@ -881,15 +1344,15 @@ template <class T> class affine {
 		T a, b, l, u;
 		int i, xs;
 
-		xs = x.a.size();
-
 		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
+		r.a.resize(x.a.size());
 		#else
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#endif
 
+		xs = x.a.size();
+
 		I = to_interval(x);
 		l = I.lower();
 		u = I.upper();
@@ -909,9 +1372,19 @@ template <class T> class affine {
 		tmp = u;
 		range = interval<T>::hull(range, 1./tmp - a * tmp);
 
-		rop<T>::begin();
+		{
+		rop_scope<T> scope;
 		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
 		err = rop<T>::sub_up(b, range.lower());
+		#if AFFINE_SPARSE
+		T c;
+		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
+		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
+		c = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
+		r.a.push_back(0, c);
+		sparse_mul(x, x.a.offset(1), a, r, err);
+		err = rop<T>::add_up(err, rop<T>::sub_up(c, l));
+		#else
 		for (i=1; i<xs; i++) {
 			r.a(i) = rop<T>::mul_down(x.a(i), a);
 		}
@@ -925,12 +1398,13 @@ template <class T> class affine {
 		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
 		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
 		err = rop<T>::add_up(err, rop<T>::sub_up(r.a(0), l));
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		// err += abs(a) * x.er;
 		using std::abs;
 		err = rop<T>::add_up(err, rop<T>::mul_up(abs(a), x.er));
 		#endif
-		rop<T>::end();
+		}
 
 		#if AFFINE_SIMPLE == 2
 		r.er = err;
@@ -956,26 +1430,40 @@ template <class T> class affine {
 		affine r;
 		int xs, i;
 		T err(0.);
-
-		xs = x.a.size();
+		#if AFFINE_SPARSE
+		T tmp;
+		#endif
 
 		#if AFFINE_SIMPLE == 0
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#else
-		r.a.resize(xs);
+		r.a.resize(x.a.size());
 		#endif
 
-		rop<T>::begin();
+		xs = x.a.size();
+
+		{
+		rop_scope<T> scope;
+		#if AFFINE_SPARSE
+		xs = x.a.nnz();
+		r.a.reserve(xs + 1);
+		for (i=0; i<xs; i++) {
+			tmp = rop<T>::div_down(x.a.val[i], (T)y);
+			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::div_up(x.a.val[i], (T)y), tmp));
+			r.a.push_back(x.a.idx[i], tmp);
+		}
+		#else
 		for (i=0; i<xs; i++) {
 			r.a(i) = rop<T>::div_down(x.a(i), (T)y);
 		}
 		for (i=0; i<xs; i++) {
 			err = rop<T>::add_up(err, rop<T>::sub_up(rop<T>::div_up(x.a(i), (T)y), r.a(i)));
 		}
-		rop<T>::end();
+		#endif
+		}
 
-		#if AFFINE_SIMPLE == 0
+		#if AFFINE_SIMPLE == 0 && !AFFINE_SPARSE
 		for (i=xs; i<maxnum(); i++) r.a(i) = 0.;
 		#endif
 		#if AFFINE_SIMPLE >= 1
@@ -1022,15 +1510,15 @@ template <class T> class affine {
 		T a, b, l, u;
 		int i, xs;
 
-		xs = x.a.size();
-
 		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
+		r.a.resize(x.a.size());
 		#else
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#endif
 
+		xs = x.a.size();
+
 		I = to_interval(x);
 		l = I.lower();
 		u = I.upper();
@@ -1048,9 +1536,19 @@ template <class T> class affine {
 		tmp = u;
 		range = interval<T>::hull(range, sqrt(tmp) - a * tmp);
 
-		rop<T>::begin();
+		{
+		rop_scope<T> scope;
 		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
 		err = rop<T>::sub_up(b, range.lower());
+		#if AFFINE_SPARSE
+		T c;
+		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
+		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
+		c = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
+		r.a.push_back(0, c);
+		sparse_mul(x, x.a.offset(1), a, r, err);
+		err = rop<T>::add_up(err, rop<T>::sub_up(c, l));
+		#else
 		for (i=1; i<xs; i++) {
 			r.a(i) = rop<T>::mul_down(x.a(i), a);
 		}
@@ -1064,12 +1562,13 @@ template <class T> class affine {
 		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
 		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
 		err = rop<T>::add_up(err, rop<T>::sub_up(r.a(0), l));
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		// err += abs(a) * x.er;
 		using std::abs;
 		err = rop<T>::add_up(err, rop<T>::mul_up(abs(a), x.er));
 		#endif
-		rop<T>::end();
+		}
 
 		#if AFFINE_SIMPLE == 2
 		r.er = err;
@@ -1090,15 +1589,15 @@ template <class T> class affine {
 		T a, b, l, u;
 		int i, xs;
 
-		xs = x.a.size();
-
 		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
+		r.a.resize(x.a.size());
 		#else
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#endif
 
+		xs = x.a.size();
+
 		I = to_interval(x);
 		l = I.lower();
 		u = I.upper();
@@ -1112,9 +1611,19 @@ template <class T> class affine {
 		tmp = u;
 		range = interval<T>::hull(range, tmp * (tmp - a));
 
-		rop<T>::begin();
+		{
+		rop_scope<T> scope;
 		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
 		err = rop<T>::sub_up(b, range.lower());
+		#if AFFINE_SPARSE
+		T c;
+		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
+		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
+		c = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
+		r.a.push_back(0, c);
+		sparse_mul(x, x.a.offset(1), a, r, err);
+		err = rop<T>::add_up(err, rop<T>::sub_up(c, l));
+		#else
 		for (i=1; i<xs; i++) {
 			r.a(i) = rop<T>::mul_down(x.a(i), a);
 		}
@@ -1128,12 +1637,13 @@ template <class T> class affine {
 		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
 		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
 		err = rop<T>::add_up(err, rop<T>::sub_up(r.a(0), l));
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		// err += abs(a) * x.er;
 		using std::abs;
 		err = rop<T>::add_up(err, rop<T>::mul_up(abs(a), x.er));
 		#endif
-		rop<T>::end();
+		}
 
 		#if AFFINE_SIMPLE == 2
 		r.er = err;
@@ -1154,15 +1664,15 @@ template <class T> class affine {
 		T a, b, l, u;
 		int i, xs;
 
-		xs = x.a.size();
-
 		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
+		r.a.resize(x.a.size());
 		#else
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#endif
 
+		xs = x.a.size();
+
 		I = to_interval(x);
 		l = I.lower();
 		u = I.upper();
@@ -1177,9 +1687,19 @@ template <class T> class affine {
 		tmp = u;
 		range = interval<T>::hull(range, exp(tmp) - a * tmp);
 
-		rop<T>::begin();
+		{
+		rop_scope<T> scope;
 		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
 		err = rop<T>::sub_up(b, range.lower());
+		#if AFFINE_SPARSE
+		T c;
+		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
+		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
+		c = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
+		r.a.push_back(0, c);
+		sparse_mul(x, x.a.offset(1), a, r, err);
+		err = rop<T>::add_up(err, rop<T>::sub_up(c, l));
+		#else
 		for (i=1; i<xs; i++) {
 			r.a(i) = rop<T>::mul_down(x.a(i), a);
 		}
@@ -1193,12 +1713,13 @@ template <class T> class affine {
 		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
 		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
 		err = rop<T>::add_up(err, rop<T>::sub_up(r.a(0), l));
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		// err += abs(a) * x.er;
 		using std::abs;
 		err = rop<T>::add_up(err, rop<T>::mul_up(abs(a), x.er));
 		#endif
-		rop<T>::end();
+		}
 
 		#if AFFINE_SIMPLE == 2
 		r.er = err;
@@ -1219,15 +1740,15 @@ template <class T> class affine {
 		T a, b, l, u;
 		int i, xs;
 
-		xs = x.a.size();
-
 		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
+		r.a.resize(x.a.size());
 		#else
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#endif
 
+		xs = x.a.size();
+
 		I = to_interval(x);
 		l = I.lower();
 		u = I.upper();
@@ -1246,9 +1767,19 @@ template <class T> class affine {
 		tmp = u;
 		range = interval<T>::hull(range, log(tmp) - a * tmp);
 
-		rop<T>::begin();
+		{
+		rop_scope<T> scope;
 		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
 		err = rop<T>::sub_up(b, range.lower());
+		#if AFFINE_SPARSE
+		T c;
+		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
+		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
+		c = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
+		r.a.push_back(0, c);
+		sparse_mul(x, x.a.offset(1), a, r, err);
+		err = rop<T>::add_up(err, rop<T>::sub_up(c, l));
+		#else
 		for (i=1; i<xs; i++) {
 			r.a(i) = rop<T>::mul_down(x.a(i), a);
 		}
@@ -1262,12 +1793,13 @@ template <class T> class affine {
 		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
 		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
 		err = rop<T>::add_up(err, rop<T>::sub_up(r.a(0), l));
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		// err += abs(a) * x.er;
 		using std::abs;
 		err = rop<T>::add_up(err, rop<T>::mul_up(abs(a), x.er));
 		#endif
-		rop<T>::end();
+		}
 
 		#if AFFINE_SIMPLE == 2
 		r.er = err;
@@ -1299,24 +1831,34 @@ template <class T> class affine {
 			return -x;
 		}
 
-		xs = x.a.size();
-
 		#if AFFINE_SIMPLE == 2
-		r.a.resize(xs);
+		r.a.resize(x.a.size());
 		#else
-		maxnum()++;
+		new_symbol();
 		r.a.resize(maxnum()+1);
 		#endif
 
+		xs = x.a.size();
+
 		a = (u + l) / (u - l);
 
 		range = 0.;
 		range = interval<T>::hull(range, u - a * u);
 		range = interval<T>::hull(range, -l - a * l);
 
-		rop<T>::begin();
+		{
+		rop_scope<T> scope;
 		b = rop<T>::mul_up(rop<T>::add_up(range.upper(), range.lower()), T(0.5));
 		err = rop<T>::sub_up(b, range.lower());
+		#if AFFINE_SPARSE
+		T c;
+		l = rop<T>::add_down(rop<T>::mul_down(x.a(0), a), b);
+		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
+		c = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
+		r.a.push_back(0, c);
+		sparse_mul(x, x.a.offset(1), a, r, err);
+		err = rop<T>::add_up(err, rop<T>::sub_up(c, l));
+		#else
 		for (i=1; i<xs; i++) {
 			r.a(i) = rop<T>::mul_down(x.a(i), a);
 		}
@@ -1330,12 +1872,13 @@ template <class T> class affine {
 		u = rop<T>::add_up(rop<T>::mul_up(x.a(0), a), b);
 		r.a(0) = rop<T>::mul_up(rop<T>::add_up(l, u), T(0.5));
 		err = rop<T>::add_up(err, rop<T>::sub_up(r.a(0), l));
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		// err += abs(a) * x.er;
 		using std::abs;
 		err = rop<T>::add_up(err, rop<T>::mul_up(abs(a), x.er));
 		#endif
-		rop<T>::end();
+		}
 
 		#if AFFINE_SIMPLE == 2
 		r.er = err;
@@ -1614,10 +2157,16 @@ template <class T> class affine {
 
 	friend std::ostream& operator<<(std::ostream& s, const affine& x) {
 		int i;
+		T c;
 
+		// zero coefficients are printed as 0 without sign, since the
+		// sparse storage does not keep the sign of the zeros of the
+		// noise symbols which are not stored
 		s << "[(" << x.a(0) << ")";
 		for (i=1; i<x.a.size(); i++) {
-			s << "+(" << x.a(i) << ")e" << i;
+			c = x.a(i);
+			if (c == 0.) c = 0.;
+			s << "+(" << c << ")e" << i;
 		}
 		#if AFFINE_SIMPLE >= 1
 		s << "+(" << x.er << ")er";
@@ -1630,7 +2179,21 @@ template <class T> class affine {
 	friend inline void split(const affine& x, int n, affine& y, affine& z) {
 		int i;
 		int s = x.a.size();
-	
+
+		#if AFFINE_REGISTRY
+		y.reg_touch();
+		z.reg_touch();
+		#endif
+
+		#if AFFINE_SPARSE
+		i = x.a.offset(n+1);
+		y.a.resize(s, false);
+		z.a.resize(s, false);
+		y.a.idx.assign(x.a.idx.begin(), x.a.idx.begin() + i);
+		y.a.val.assign(x.a.val.begin(), x.a.val.begin() + i);
+		z.a.idx.assign(x.a.idx.begin() + i, x.a.idx.end());
+		z.a.val.assign(x.a.val.begin() + i, x.a.val.end());
+		#else
 		y.a.resize(s);
 		z.a.resize(s);
 		for (i=0; i<=n; i++) {
@@ -1641,6 +2204,7 @@ template <class T> class affine {
 			y.a(i) = 0.;
 			z.a(i) = x.a(i);
 		}
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		y.er = 0.;
 		z.er = x.er;
@@ -1648,6 +2212,12 @@ template <class T> class affine {
 	}
 
 	void resize() {
+		#if AFFINE_REGISTRY
+		reg_touch();
+		#endif
+		#if AFFINE_SPARSE
+		a.resize(maxnum()+1);
+		#else
 		int i;
 		ub::vector<T> r;
 
@@ -1657,9 +2227,134 @@ template <class T> class affine {
 		}
 
 		a = r;
+		#endif
+	}
+};
+
+
+#if AFFINE_REGISTRY
+
+/*
+ * scope of automatic compaction of noise symbols
+ *
+ * the noise symbols which exist when the scope is created are kept as
+ * they are, so the indices saved before (e.g. for split) remain valid.
+ * only the affine objects written in the scope are renumbered.
+ * after maxnum() has grown by the threshold, the unused noise symbols
+ * are removed, and the next compaction is done when maxnum() becomes
+ * twice the number of the remaining ones (or grows by the threshold).
+ * if maxnum() is decreased in the scope (by epsilon_reduce or by
+ * setting maxnum() directly), no more compaction is done in the scope.
+ */
+
+template <class T> class affine_compaction {
+	public:
+	int base;      // noise symbols 1..base are kept
+	int gen;
+	int last;      // maxnum() at the last check
+	int limit;     // compaction when maxnum() - base >= limit
+	int threshold;
+	bool stopped;
+	affine_compaction* outer;
+
+	explicit affine_compaction(int threshold = AFFINE_COMPACT_MIN) : threshold(threshold) {
+		typename affine<T>::registry_type& g = affine<T>::registry();
+
+		base = affine<T>::maxnum();
+		last = base;
+		limit = threshold;
+		stopped = false;
+		gen = ++g.gen;
+		outer = g.scope;
+		g.scope = this;
+	}
+
+	~affine_compaction() {
+		affine<T>::registry().scope = outer;
+	}
+
+	void check() {
+		int m = affine<T>::maxnum();
+
+		if (stopped) return;
+		if (m < last) {
+			stopped = true;
+			return;
+		}
+		last = m;
+		if (m - base >= limit) {
+			compact();
+			limit = std::max(threshold, 2 * (affine<T>::maxnum() - base));
+		}
+	}
+
+	// returns the number of removed noise symbols
+	int compact() {
+		typename affine<T>::registry_type& g = affine<T>::registry();
+		int m = affine<T>::maxnum();
+		int i, k, s;
+		affine<T>* p;
+		std::vector<char> used(m + 1, 0);
+		std::vector<int> pos(m + 1);
+
+		if (stopped) return 0;
+
+		for (p=g.head; p!=NULL; p=p->reg_next) {
+			if (p->reg_gen < gen) continue;
+			s = p->a.size();
+			if (s > m + 1) {
+				// not created in this numbering
+				stopped = true;
+				return 0;
+			}
+			#if AFFINE_SPARSE
+			for (k=p->a.offset(base+1); k<p->a.nnz(); k++) {
+				used[p->a.idx[k]] = 1;
+			}
+			#else
+			for (i=base+1; i<s; i++) {
+				if (p->a(i) != 0.) used[i] = 1;
+			}
+			#endif
+		}
+
+		// new index of each noise symbol
+		k = base;
+		for (i=0; i<=base; i++) pos[i] = i;
+		for (i=base+1; i<=m; i++) {
+			if (used[i]) k++;
+			pos[i] = k;
+		}
+		if (k == m) return 0;
+
+		for (p=g.head; p!=NULL; p=p->reg_next) {
+			if (p->reg_gen < gen) continue;
+			s = p->a.size();
+			if (s <= base + 1) continue;
+			#if AFFINE_SPARSE
+			for (i=p->a.offset(base+1); i<p->a.nnz(); i++) {
+				p->a.idx[i] = pos[p->a.idx[i]];
+			}
+			p->a.n = pos[s-1] + 1;
+			#else
+			for (i=base+1; i<s; i++) {
+				if (used[i]) p->a(pos[i]) = p->a(i);
+			}
+			p->a.resize(pos[s-1] + 1);
+			#endif
+		}
+
+		affine<T>::maxnum() = k;
+		last = k;
+		g.stat.compactions++;
+		g.stat.removed += m - k;
+
+		return m - k;
 	}
 };
 
+#endif // AFFINE_REGISTRY
+
 
 template <class T> inline ub::vector< interval<T> > to_interval(const ub::vector< affine<T> >& x) {
 	int s = x.size();
@@ -1745,6 +2440,22 @@ template <class T> inline void epsilon_reduce(ub::vector< affine<T> >& x, int n,
 	a.resize(m);
 	pa.resize(m);
 
+	#if AFFINE_SPARSE
+	for (i=1; i<=m; i++) {
+		a[i-1].v.resize(s);
+		for (j=0; j<s; j++) a[i-1].v(j) = 0.;
+	}
+	for (j=0; j<s; j++) {
+		const affine<T>& xj = x(j);
+		for (i=xj.a.offset(1); i<xj.a.nnz() && xj.a.idx[i]<=m; i++) {
+			a[xj.a.idx[i]-1].v(j) = xj.a.val[i];
+		}
+	}
+	for (i=1; i<=m; i++) {
+		a[i-1].calc_score();
+		pa[i-1] = &(a[i-1]);
+	}
+	#else
 	for (i=1; i<=m; i++) {
 		a[i-1].v.resize(s);
 		for (j=0; j<s; j++) {
@@ -1753,6 +2464,7 @@ template <class T> inline void epsilon_reduce(ub::vector< affine<T> >& x, int n,
 		a[i-1].calc_score();
 		pa[i-1] = &(a[i-1]);
 	}
+	#endif
 
 #ifdef EP_REDUCE_REVERSE
 	std::partial_sort(pa.begin(), pa.begin()+m-n+s, pa.end(), ep_reduce_cmp<T>);
@@ -1811,20 +2523,36 @@ template <class T> inline void epsilon_reduce2(ub::vector< affine<T> >& x, int n
 	for (i=0; i<s; i++) {
 		tmp = 0.;
 		rop<T>::begin();
+		#if AFFINE_SPARSE
+		for (j=x(i).a.offset(n+1); j<x(i).a.nnz(); j++) {
+			using std::abs;
+			tmp = rop<T>::add_up(tmp, abs(x(i).a.val[j]));
+		}
+		#else
 		for (j=n+1; j<x(i).a.size(); j++) {
 			using std::abs;
 			tmp = rop<T>::add_up(tmp, abs(x(i).a(j)));
 		}
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		tmp = rop<T>::add_up(tmp, x(i).er);
 		#endif
 		rop<T>::end();
 
+		#if AFFINE_REGISTRY
+		x(i).reg_touch();
+		#endif
+		#if AFFINE_SPARSE
+		x(i).a.resize(n+1);
+		x(i).a.push_back(n+1+i, tmp);
+		x(i).a.resize(n+1+i+1);
+		#else
 		x(i).a.resize(n+1+i+1, true);
 		for (j=0; j<i; j++) {
 			x(i).a(n+1+j) = 0.;
 		}
 		x(i).a(n+1+i) = tmp;
+		#endif
 		#if AFFINE_SIMPLE >= 1
 		x(i).er = 0.;
 		#endif
@@ -2,7 +2,10 @@
 #include <kv/airy.hpp>
 #include <kv/allsol-affine.hpp>
 #include <kv/allsol-simple.hpp>
+#include <kv/allsol-workpool.hpp>
 #include <kv/allsol.hpp>
+#include <kv/autodif-reverse.hpp>
+#include <kv/autodif-sparse.hpp>
 #include <kv/autodif.hpp>
 #include <kv/bessel.hpp>
 #include <kv/beta.hpp>
@@ -29,8 +32,10 @@
 #include <kv/interval.hpp>
 #include <kv/interval-vector.hpp>
 #include <kv/interval-conv.hpp>
+#include <kv/jet.hpp>
 #include <kv/jointrange.hpp>
 #include <kv/kkt.hpp>
+#include <kv/kraw-approx-sparse.hpp>
 #include <kv/kraw-approx.hpp>
 #include <kv/lobachevsky.hpp>
 #include <kv/lp.hpp>
@@ -38,11 +43,13 @@
 #include <kv/matplotlib.hpp>
 #include <kv/matrix-inversion.hpp>
 #include <kv/mpfr.hpp>
+#include <kv/mpsa.hpp>
 #include <kv/newton.hpp>
 #include <kv/ode-affine-wrapper.hpp>
 #include <kv/ode-affine.hpp>
 #include <kv/ode-autodif-nv.hpp>
 #include <kv/ode-autodif.hpp>
+#include <kv/ode-batch.hpp>
 #include <kv/ode-callback.hpp>
 #include <kv/ode-lohner.hpp>
 #include <kv/ode-maffine.hpp>
@@ -51,6 +58,7 @@
 #include <kv/ode-param.hpp>
 #include <kv/ode-qr-lohner.hpp>
 #include <kv/ode-qr.hpp>
+#include <kv/ode-trajectory.hpp>
 #include <kv/ode.hpp>
 #include <kv/odescale.hpp>
 #include <kv/optimize.hpp>
@@ -7,6 +7,9 @@
 
 #include <iostream>
 #include <list>
+#include <string>
+#include <exception>
+#include <stdexcept>
 #include <kv/interval.hpp>
 #include <kv/rdouble.hpp>
 #include <kv/interval-vector.hpp>
@@ -16,6 +19,7 @@
 #include <kv/matrix-inversion.hpp>
 #include <kv/affine.hpp>
 #include <kv/lp.hpp>
+#include <kv/allsol-workpool.hpp>
 
 
 #ifndef USE_TRIM
@@ -93,6 +97,70 @@ template <class T> T widthratio_min (const ub::vector< interval<T> >& I, const u
 	return r;
 }
 
+// the first exception thrown in the parallel region. it is thrown
+// again after the region by rethrow. before C++11 there is no
+// std::exception_ptr, so the exception is thrown at once if OpenMP is
+// disabled, and otherwise only the message of a std::exception is kept
+// and std::runtime_error is thrown.
+
+class parallel_error {
+	#if __cplusplus >= 201103L
+	std::exception_ptr e;
+	#else
+	bool kept;
+	std::string msg;
+	#endif
+
+	public:
+
+	#if __cplusplus >= 201103L
+	parallel_error() {}
+	#else
+	parallel_error() : kept(false) {}
+	#endif
+
+	// called in a handler
+	void keep() {
+		#if __cplusplus >= 201103L
+		if (!e) e = std::current_exception();
+		#elif !defined(_OPENMP)
+		throw;
+		#else
+		if (kept) return;
+		kept = true;
+		try {
+			throw;
+		}
+		catch (std::exception& x) {
+			msg = x.what();
+		}
+		catch (...) {
+			msg = "allsol_list_affine: unknown exception";
+		}
+		#endif
+	}
+
+	void rethrow() const {
+		#if __cplusplus >= 201103L
+		if (e) std::rethrow_exception(e);
+		#else
+		if (kept) throw std::runtime_error(msg);
+		#endif
+	}
+};
+
+// called in the handler of an exception thrown in the parallel region.
+// keep the first one in error and make all the threads stop.
+
+inline void keep_error(parallel_error& error, int& stop) {
+	#pragma omp critical (allsol_affine_error)
+	{
+	error.keep();
+	}
+	#pragma omp atomic write
+	stop = 1;
+}
+
 } // namespace allsol_affine_sub
 
 
@@ -113,19 +181,58 @@ template <class T, class F> std::list< ub::vector< interval<T> > >
 allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verbose=1)
 {
 	int s = (targets.front()).size();
-	ub::vector< interval<T> > I, fc, fi, C, CK, K, mvf, I1, I2;
-	ub::matrix< interval<T> > fdi, M;
-	ub::matrix<T> L, R, E;
 	std::list< ub::vector< interval<T> > > solutions, solutions_big;
-	typename std::list< ub::vector< interval<T> > >::iterator p, p2;
-	int i, j, k, mi;
-	T tmp;
-	bool r, M_calculated, flag, flag2;
 	int count_ne_test = 0;
 	int count_ex_test = 0;
 	int count_unknown = targets.size();
 	int count_ne = 0;
 	int count_ex = 0;
+	typename std::list< ub::vector< interval<T> > >::iterator pt;
+	int nt;
+	// exception thrown in the parallel region. it is rethrown after
+	// the region, and stop makes all threads leave.
+	allsol_affine_sub::parallel_error error;
+	int stop = 0;
+
+	// count_unknown is the number of intervals which are in the pool
+	// or being processed. search is finished when it becomes 0.
+	// it is increased before the new intervals are pushed so that it
+	// does not become 0 while an interval is in the pool.
+
+#ifdef _OPENMP
+	nt = omp_get_max_threads();
+#else
+	nt = 1;
+#endif
+	allsol_sub::workpool< ub::vector< interval<T> > > pool(nt);
+	for (pt=targets.begin(), nt=0; pt!=targets.end(); pt++, nt++) {
+		pool.push(nt % pool.size(), *pt);
+	}
+	targets.clear();
+
+	#pragma omp parallel
+	{
+
+	// statistics are counted by each thread and summed up at the end
+	int my_ne_test = 0;
+	int my_ex_test = 0;
+	int my_ne = 0;
+	int my_ex = 0;
+	int tid, idle = 0, unknown, stopped;
+#ifdef _OPENMP
+	tid = omp_get_thread_num();
+#else
+	tid = 0;
+#endif
+
+	// affine<T>::maxnum() is threadprivate, so each thread has its own
+	// noise symbols.
+	ub::vector< interval<T> > I, fi, K, I1, I2;
+	ub::matrix<T> L, R;
+	typename std::list< ub::vector< interval<T> > >::iterator p, p2;
+	int i, j, mi;
+	T tmp;
+	bool r, flag, flag2;
 	ub::vector< affine<T> > ax, ay, ak;
 	ub::vector< interval<T> > IR;
 	T trim_tmp;
@@ -139,24 +246,43 @@ allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verb
 	std::list< ub::vector<T> > constraints;
 	ub::vector<T> c_tmp;
 	int ep_size, lp_size;
-	bool lp_flag;
+	bool lp_flag, lp_ne;
 	T lp_return;
+	// dual solution of the last LP which proved non-existence.
+	// neighboring intervals have similar LPs, so it may prove
+	// non-existence by lp_lower_bound without solving the LP.
+	ub::vector<T> lp_dual, lp_dual_new;
 
-	E = ub::identity_matrix<T>(s);
 	L.resize(s,s);
 
-	while (!targets.empty()) {
+	while (true) {
+		#pragma omp atomic read
+		stopped = stop;
+		if (stopped) break;
+
 		if (verbose >= 2) {
-			std::cout << "ne_test: " << count_ne_test << ", ex_test: " << count_ex_test << ", unknown: " << count_unknown << ", ne: " << count_ne << ", ex: " << count_ex << "    \r" << std::flush;
+			#pragma omp atomic read
+			unknown = count_unknown;
+			// the counters except unknown are of this thread
+			#pragma omp critical (cout)
+			{
+			if (pool.size() > 1) std::cout << "thread " << tid << ": ";
+			std::cout << "ne_test: " << my_ne_test << ", ex_test: " << my_ex_test << ", unknown: " << unknown << ", ne: " << my_ne << ", ex: " << my_ex << "    \r" << std::flush;
+			}
 		}
 
-		I = targets.front();
-		targets.pop_front();
-		count_unknown--;
+		if (!pool.pop(tid, I)) {
+			#pragma omp atomic read
+			unknown = count_unknown;
+			if (unknown == 0) break;
+			allsol_sub::idle_wait(idle);
+			continue;
+		}
+		idle = 0;
 
 		// non-existence test
 
-		count_ne_test++;
+		my_ne_test++;
 
 #if USE_FI == 1
 		try {
@@ -165,9 +291,15 @@ allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verb
 		catch (std::domain_error& e) {
 			goto label;
 		}
+		catch (...) {
+			allsol_affine_sub::keep_error(error, stop);
+			break;
+		}
 
 		if (!zero_in(fi)) {
-			count_ne++;
+			my_ne++;
+			#pragma omp atomic
+			count_unknown--;
 			continue;
 		}
 #endif
@@ -180,10 +312,16 @@ allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verb
 		catch (std::domain_error& e) {
 			goto label;
 		}
+		catch (...) {
+			allsol_affine_sub::keep_error(error, stop);
+			break;
+		}
 
 		fi = to_interval(ay);
 		if (!zero_in(fi)) {
-			count_ne++;
+			my_ne++;
+			#pragma omp atomic
+			count_unknown--;
 			continue;
 		}
 
@@ -193,7 +331,9 @@ allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verb
 			sum_abs += abs(ay(i));
 		}
 		if (to_interval(sum_abs).lower() > 0.) {
-			count_ne++;
+			my_ne++;
+			#pragma omp atomic
+			count_unknown--;
 			continue;
 		}
 #endif
@@ -299,10 +439,39 @@ allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verb
 			constraints.push_back(c_tmp);
 		}
 
+		// all the variables of the LP are in [0, 2]
+		try {
+			lp_ne = lp_flag && lp_lower_bound(objfunc, constraints, lp_dual, T(2.)) > 0.;
+		}
+		catch (...) {
+			allsol_affine_sub::keep_error(error, stop);
+			break;
+		}
+		if (lp_ne) {
+			my_ne++;
+			#pragma omp atomic
+			count_unknown--;
+			continue;
+		}
+
 		if (lp_flag) {
-			lp_return = lp_minimize_verified(objfunc, constraints, -1);
+			// if the LP can not be solved, the interval is left
+			// undecided
+			try {
+				lp_return = lp_minimize_verified(objfunc, constraints, -1, &lp_dual_new);
+			}
+			catch (std::domain_error& e) {
+				lp_return = 0.;
+			}
+			catch (...) {
+				allsol_affine_sub::keep_error(error, stop);
+				break;
+			}
 			if (lp_return > 0.) {
-				count_ne++;
+				lp_dual.swap(lp_dual_new);
+				my_ne++;
+				#pragma omp atomic
+				count_unknown--;
 				continue;
 			}
 		}
@@ -337,7 +506,9 @@ allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verb
 		}
 
 		if (flag == true) {
-			count_ne++;
+			my_ne++;
+			#pragma omp atomic
+			count_unknown--;
 			continue;
 		}
 #endif
@@ -350,31 +521,87 @@ allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verb
 			}
 		}
 
-		count_ex_test++;
+		my_ex_test++;
 
-		r = invert(L, R);
+		try {
+			r = invert(L, R);
+			if (r) {
+				ak = ax - prod(R, ay);
+				K = to_interval(ak);
+			}
+		}
+		catch (...) {
+			allsol_affine_sub::keep_error(error, stop);
+			break;
+		}
 		if (!r) goto label;
 
-		ak = ax - prod(R, ay);
-		K = to_interval(ak);
-
 		if (!overlap(K, I)) {
-			count_ne++;
+			my_ne++;
+			#pragma omp atomic
+			count_unknown--;
 			continue;
 		}
 
 		if (proper_subset(K, I)) {
-			// check whether the solution is already found or not
-			flag = true;
-			p = solutions.begin();
-			p2 = solutions_big.begin();
-			while (p != solutions.end()) {
-				if (overlap(K, *p)) {
-					if (subset(K, *p2)||subset(*p, I)) {
-						flag = false;
-						break;
+			#pragma omp critical (solutions)
+			{
+			try {
+				// check whether the solution is already found or not
+				flag = true;
+				p = solutions.begin();
+				p2 = solutions_big.begin();
+				while (p != solutions.end()) {
+					if (overlap(K, *p)) {
+						if (subset(K, *p2)||subset(*p, I)) {
+							flag = false;
+							break;
+						}
+						while (true) {
+							affine<T>::maxnum() = 0;
+							ax = K;
+							ay = f(ax);
+							#if 0
+							for (i=0; i<s; i++) {
+								for (j=0; j<s; j++) {
+									L(i, j) = ay(i).get_coef(j+1) / ax(j).get_coef(j+1);
+								}
+							}
+							invert(L, R);
+							#endif
+							ak = ax - prod(R, ay);
+							I1 = to_interval(ak);
+							K = intersect(K, I1);
+							if (subset(K, *p2)) {
+								flag2 = true;
+								break;
+							}
+							if (!overlap(K, *p)) {
+								flag2 = false;
+								break;
+							}
+						}
+						if (flag2 == true) {
+							flag = false;
+							break;
+						} else {
+							/* never reach? */
+							std::cout << "two overlap intervals includes different solutions";
+						}
+					}
+					p++;
+					p2++;
+				}
+				if (flag) { // new solution found
+					if (verbose >= 1) {
+						#pragma omp critical (cout)
+						{
+						std::cout << I << "(ex)\n";
+						}
 					}
-					while (true) {
+					solutions_big.push_back(I);
+					// iterative refinement
+					while (1) {
 						affine<T>::maxnum() = 0;
 						ax = K;
 						ay = f(ax);
@@ -384,72 +611,47 @@ allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verb
 								L(i, j) = ay(i).get_coef(j+1) / ax(j).get_coef(j+1);
 							}
 						}
-						invert(L, R);
+						r = invert(L, R);
 						#endif
 						ak = ax - prod(R, ay);
 						I1 = to_interval(ak);
-						K = intersect(K, I1);
-						if (subset(K, *p2)) {
-							flag2 = true;
-							break;
-						}
-						if (!overlap(K, *p)) {
-							flag2 = false;
-							break;
-						}
+						I1 = intersect(K, I1);
+						tmp = allsol_affine_sub::widthratio_min(I1, K);
+						K = I1;
+						if (tmp > 0.9) break;
 					}
-					if (flag2 == true) {
-						flag = false;
-						break;
-					} else {
-						/* never reach? */
-						std::cout << "two overlap intervals includes different solutions";
-					}
-				}
-				p++;
-				p2++;
-			}
-			if (flag) { // new solution found
-				if (verbose >= 1) std::cout << I << "(ex)\n";
-				solutions_big.push_back(I);
-				// iterative refinement
-				while (1) {
-					affine<T>::maxnum() = 0;
-					ax = K;
-					ay = f(ax);
-					#if 0
-					for (i=0; i<s; i++) {
-						for (j=0; j<s; j++) {
-							L(i, j) = ay(i).get_coef(j+1) / ax(j).get_coef(j+1);
+					solutions.push_back(K);
+					my_ex++;
+					if (verbose >= 1) {
+						#pragma omp critical (cout)
+						{
+						std::cout << K << "(ex:improved)\n";
 						}
 					}
-					r = invert(L, R);
-					#endif
-					ak = ax - prod(R, ay);
-					I1 = to_interval(ak);
-					I1 = intersect(K, I1);
-					tmp = allsol_affine_sub::widthratio_min(I1, K);
-					K = I1;
-					if (tmp > 0.9) break;
 				}
-				solutions.push_back(K);
-				count_ex++;
-				if (verbose >= 1) std::cout << K << "(ex:improved)\n";
 			}
+			catch (...) {
+				// leave the critical section normally
+				allsol_affine_sub::keep_error(error, stop);
+			}
+			} // pragma omp critical (solutions)
+			#pragma omp atomic
+			count_unknown--;
 			continue;
 		}
 
 		// check the case that solution may exist near boundary.
 		// If so, use K as next interval
 		if (allsol_affine_sub::widthratio_max(K, I) < 0.9) {
-			targets.push_back(K);
-			count_unknown++;
+			pool.push(tid, K);
 			continue;
 		}
 
 #if USE_TRIM == 1
 		if (!overlap(IR, K)) {
-			count_ne++;
+			my_ne++;
+			#pragma omp atomic
+			count_unknown--;
 			continue;
 		} else {
 			I = intersect(IR, K);
@@ -466,18 +668,37 @@ allsol_list_affine(F f, std::list< ub::vector< interval<T> > > targets, int verb
 
 		tmp = mid(I(mi));
 		if (tmp == I(mi).lower() || tmp == I(mi).upper()) {
+			#pragma omp critical (cout)
+			{
 			std::cout << "too small interval (may be multiple root?):\n" << I << "\n";
+			}
+			#pragma omp atomic
+			count_unknown--;
 			continue;
 		}
 
 		I1 = I; I2 = I;
 		I1(mi).assign(I1(mi).lower(), tmp);
 		I2(mi).assign(tmp, I2(mi).upper());
-		targets.push_back(I1);
-		targets.push_back(I2);
-		count_unknown += 2;
+		#pragma omp atomic
+		count_unknown += 1;
+		pool.push(tid, I1);
+		pool.push(tid, I2);
 	}
 
+	#pragma omp atomic
+	count_ne_test += my_ne_test;
+	#pragma omp atomic
+	count_ex_test += my_ex_test;
+	#pragma omp atomic
+	count_ne += my_ne;
+	#pragma omp atomic
+	count_ex += my_ex;
+
+	} // pragma omp parallel
+
+	error.rethrow();
+
 	if (verbose >= 1) {
 			std::cout << "ne_test: " << count_ne_test << ", ex_test: " << count_ex_test << ", ne: " << count_ne << ", ex: " << count_ex << "    \n";
 	}
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef ALLSOL_WORKPOOL_HPP
+#define ALLSOL_WORKPOOL_HPP
+
+// pool of intervals shared by the threads of allsol_list and
+// allsol_list_affine
+
+#include <deque>
+#include <vector>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <sched.h>
+#endif
+
+
+namespace kv {
+
+namespace allsol_sub {
+
+// pool of intervals to be processed.
+// each thread has its own deque: the owner pushes to the back and
+// pops from the front (the same order as serial version), and a
+// thread whose deque is empty steals from the back of others.
+// each deque is protected by its own lock, so threads contend only
+// when stealing. without OpenMP, this is a simple queue.
+
+template <class V> class workpool {
+	std::vector< std::deque<V> > q;
+#ifdef _OPENMP
+	std::vector<omp_lock_t> lk;
+#endif
+
+	workpool(const workpool&);
+	workpool& operator=(const workpool&);
+
+	public:
+
+	explicit workpool(int n) : q(n) {
+#ifdef _OPENMP
+		lk.resize(n);
+		for (int i=0; i<n; i++) omp_init_lock(&lk[i]);
+#endif
+	}
+
+	~workpool() {
+#ifdef _OPENMP
+		for (int i=0; i<(int)lk.size(); i++) omp_destroy_lock(&lk[i]);
+#endif
+	}
+
+	int size() const {
+		return q.size();
+	}
+
+	void push(int t, const V& x) {
+#ifdef _OPENMP
+		omp_set_lock(&lk[t]);
+#endif
+		q[t].push_back(x);
+#ifdef _OPENMP
+		omp_unset_lock(&lk[t]);
+#endif
+	}
+
+	bool pop(int t, V& x) {
+		int i, j, n = q.size();
+		bool r = false;
+
+		for (i=0; i<n; i++) {
+			j = (t + i) % n;
+#ifdef _OPENMP
+			omp_set_lock(&lk[j]);
+#endif
+			if (!q[j].empty()) {
+				if (i == 0) {
+					x = q[j].front();
+					q[j].pop_front();
+				} else {
+					x = q[j].back();
+					q[j].pop_back();
+				}
+				r = true;
+			}
+#ifdef _OPENMP
+			omp_unset_lock(&lk[j]);
+#endif
+			if (r) return true;
+		}
+
+		return false;
+	}
+};
+
+// wait a little while before retrying to find work.
+// the number of spins doubles for each failure up to a limit.
+// after that, the processor is given to other threads for each
+// failure (where sched_yield is available), so that a thread waiting
+// long does not keep a core busy.
+
+inline void idle_wait(int& n) {
+	volatile int d = 0;
+	int i, m;
+
+#if defined(__unix__) || defined(__APPLE__)
+	if (n >= 12) {
+		sched_yield();
+		return;
+	}
+#endif
+	m = 1 << n;
+	for (i=0; i<m; i++) d = d + 1;
+	if (n < 12) n++;
+}
+
+} // namespace allsol_sub
+
+} // namespace kv
+
+#endif // ALLSOL_WORKPOOL_HPP
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2016 Masahide Kashiwagi (kashi@waseda.jp)
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
  */
 
 #ifndef ALLSOL_HPP
@@ -7,6 +7,8 @@
 
 #include <iostream>
 #include <list>
+#include <deque>
+#include <vector>
 #include <limits>
 #include <kv/interval.hpp>
 #include <kv/rdouble.hpp>
@@ -19,7 +21,9 @@
 #endif
 // #include <boost/random.hpp>
 #include <kv/matrix-inversion.hpp>
+#include <kv/interval-blas.hpp>
 #include <kv/autodif.hpp>
+#include <kv/allsol-workpool.hpp>
 
 
 #ifndef EDGE_RATIO
@@ -449,10 +453,41 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 	int count_ne = 0;
 	int count_ex = 0;
 	int count_giveup = 0;
+	typename std::list< ub::vector< interval<T> > >::iterator pt;
+	int nt;
+
+	// count_unknown is the number of intervals which are in the pool
+	// or being processed. search is finished when it becomes 0.
+	// it is increased before the new intervals are pushed so that it
+	// does not become 0 while an interval is in the pool.
+
+#ifdef _OPENMP
+	nt = omp_get_max_threads();
+#else
+	nt = 1;
+#endif
+	allsol_sub::workpool< ub::vector< interval<T> > > pool(nt);
+	for (pt=targets.begin(), nt=0; pt!=targets.end(); pt++, nt++) {
+		pool.push(nt % pool.size(), *pt);
+	}
+	targets.clear();
 
 	#pragma omp parallel
 	{
 
+	// statistics are counted by each thread and summed up at the end
+	int my_ne_test = 0;
+	int my_ex_test = 0;
+	int my_ne = 0;
+	int my_ex = 0;
+	int my_giveup = 0;
+	int tid, idle = 0, unknown;
+#ifdef _OPENMP
+	tid = omp_get_thread_num();
+#else
+	tid = 0;
+#endif
+
 	ub::vector< interval<T> > I, fc, fi, C, CK, K, mvf, I1, I2, IR, Iorg, g;
 	ub::vector<T> v;
 	ub::matrix< interval<T> > fdi, M, L2;
@@ -473,44 +508,30 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 
 	while (true) {
 		if (verbose >= 2) {
+			// the counters except unknown are of this thread
+			#pragma omp atomic read
+			unknown = count_unknown;
 			#pragma omp critical (cout)
 			{
-			std::cout << "ne_test: " << count_ne_test << ", ex_test: " << count_ex_test << ", unknown: " << count_unknown << ", ne: " << count_ne << ", ex: " << count_ex << ", giveup: " << count_giveup << "    \r" << std::flush;
+			if (pool.size() > 1) std::cout << "thread " << tid << ": ";
+			std::cout << "ne_test: " << my_ne_test << ", ex_test: " << my_ex_test << ", unknown: " << unknown << ", ne: " << my_ne << ", ex: " << my_ex << ", giveup: " << my_giveup << "    \r" << std::flush;
 			}
 		}
 
-		#ifdef _OPENMP
-
-		int iflag = 0;
-		#pragma omp critical (targets)
-		{
-		if (count_unknown == 0) iflag = 2;
-		else {
-			if (targets.empty()) {
-				iflag = 1;
-			} else {
-				I = targets.front();
-				targets.pop_front();
-			}
-		}
+		if (!pool.pop(tid, I)) {
+			#pragma omp atomic read
+			unknown = count_unknown;
+			if (unknown == 0) break;
+			allsol_sub::idle_wait(idle);
+			continue;
 		}
-		if (iflag == 2)  break;
-		if (iflag == 1) continue;
-
-		#else // _OPENMP
-
-		if (targets.empty()) break;
-		I = targets.front();
-		targets.pop_front();
-
-		#endif // _OPENMP
+		idle = 0;
 
 		Iorg = I;
 
 		// non-existence test
 
-		#pragma omp atomic
-		count_ne_test++;
+		my_ne_test++;
 
 #if USE_FI == 1
 		try {
@@ -521,12 +542,9 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 		}
 
 		if (!zero_in(fi)) {
+			my_ne++;
 			#pragma omp atomic
-			count_ne++;
-			#pragma omp critical (targets)
-			{
 			count_unknown--;
-			}
 			continue;
 		}
 #endif
@@ -540,12 +558,9 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 
 #if USE_FI != 1
 		if (!zero_in(fi)) {
+			my_ne++;
 			#pragma omp atomic
-			count_ne++;
-			#pragma omp critical (targets)
-			{
 			count_unknown--;
-			}
 			continue;
 		}
 #endif
@@ -564,12 +579,9 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 
 		mvf = fc + prod(fdi, I - C);
 		if (!zero_in(mvf)) {
+			my_ne++;
 			#pragma omp atomic
-			count_ne++;
-			#pragma omp critical (targets)
-			{
 			count_unknown--;
-			}
 			continue;
 		}
 
@@ -668,12 +680,10 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 							I2(j) = intersect(IR(j), J2);
 							allsol_sub::recovery_inflation(I1, Iorg, (T)RECOVER_RATIO);
 							allsol_sub::recovery_inflation(I2, Iorg, (T)RECOVER_RATIO);
-							#pragma omp critical (targets)
-							{
-							targets.push_back(I1);
-							targets.push_back(I2);
+							#pragma omp atomic
 							count_unknown += 1;
-							}
+							pool.push(tid, I1);
+							pool.push(tid, I2);
 							flag3 = true;
 							break;
 #else
@@ -725,12 +735,9 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 
 		// non-existence in I turns out
 		if (flag == true) {
+			my_ne++;
 			#pragma omp atomic
-			count_ne++;
-			#pragma omp critical (targets)
-			{
 			count_unknown--;
-			}
 			continue;
 		}
 
@@ -743,10 +750,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 			// shrinking again.
 			mi = allsol_sub::search_maxwidth(I);
 			if (rad(IR(mi)) <= 0.5 * rad(I(mi))) {
-				#pragma omp critical (targets)
-				{
-				targets.push_back(IR);
-				}
+				pool.push(tid, IR);
 				continue;
 			}
 #endif
@@ -765,12 +769,9 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 			// re-check mvf
 			mvf = fc + prod(fdi, I - C);
 			if (!zero_in(mvf)) {
+				my_ne++;
 				#pragma omp atomic
-				count_ne++;
-				#pragma omp critical (targets)
-				{
 				count_unknown--;
-				}
 				continue;
 			}
 		}
@@ -786,12 +787,9 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 		I1 = fc + prod(fdi - L2, I - C);
 		I2 = prod(g, L2);
 		if (inner_prod(mag(g), mig(I1)) - inner_prod(mag(I2), rad(I)) > 0.) {
+			my_ne++;
 			#pragma omp atomic
-			count_ne++;
-			#pragma omp critical (targets)
-			{
 			count_unknown--;
-			}
 			continue;
 		}
 #endif
@@ -836,23 +834,23 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 		if (flag == false) goto label;
 #endif
 
-		#pragma omp atomic
-		count_ex_test++;
+		my_ex_test++;
 
 		r = invert(L, R);
 		if (!r) goto label;
 
-		M = E - prod(R, fdi);
+		{
+		// Krawczyk operator in one rounding scope
+		rop_scope<T> scope;
+		M = E - iblas::gemm(R, fdi);
+		CK = C - iblas::gemv(R, fc);
+		K = CK + iblas::gemv<T>(M, I - C);
+		}
 		M_calculated = true;
-		CK = C - prod(R, fc);
-		K = CK +  prod(M, I - C);
 		if (!overlap(K, I)) {
+			my_ne++;
 			#pragma omp atomic
-			count_ne++;
-			#pragma omp critical (targets)
-			{
 			count_unknown--;
-			}
 			continue;
 		}
 
@@ -881,7 +879,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 					}
 					while (true) {
 						C = mid(K);
-						I1 = C - prod(R, f(C)) + prod(M, K - C);
+						I1 = C - iblas::gemv<T>(R, f(C)) + iblas::gemv<T>(M, K - C);
 						K = intersect(K, I1);
 						if (subset(K, *p2)) {
 							flag2 = true;
@@ -918,16 +916,16 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 					autodif< interval<T> >::split(f(autodif< interval<T> >::init(K)), fi, fdi);
 					L = mid(fdi);
 					r = invert(L, R);
-					M = E - prod(R, fdi);
+					M = E - iblas::gemm(R, fdi);
 					#endif
-					I1 = C - prod(R, f(C)) + prod(M, K - C);
+					I1 = C - iblas::gemv<T>(R, f(C)) + iblas::gemv<T>(M, K - C);
 					I1 = intersect(K, I1);
 					tmp = allsol_sub::widthratio_min(I1, K);
 					K = I1;
 					if (tmp > ITER_STOP_RATIO) break;
 				}
 				solutions.push_back(K);
-				count_ex++;
+				my_ex++;
 				if (verbose >= 1) {
 					#pragma omp critical (cout)
 					{
@@ -936,10 +934,8 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 				}
 			}
 			} // pragma omp critical (solutions)
-			#pragma omp critical (targets)
-			{
+			#pragma omp atomic
 			count_unknown--;
-			}
 			continue;
 		}
 
@@ -952,10 +948,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 #endif
 		{
 			allsol_sub::recovery_inflation2(K, Iorg, (T)RECOVER_RATIO);
-			#pragma omp critical (targets)
-			{
-			targets.push_back(K);
-			}
+			pool.push(tid, K);
 			continue;
 		}
 
@@ -979,10 +972,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 		if (allsol_sub::widthratio_max(I, Iorg) <= 0.5)
 #endif
 		{
-			#pragma omp critical (targets)
-			{
-			targets.push_back(I);
-			}
+			pool.push(tid, I);
 			continue;
 		}
 #endif
@@ -995,10 +985,7 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 
 		mi = allsol_sub::search_maxwidth(Iorg);
 		if (rad(I(mi)) <= 0.5 * rad(Iorg(mi))) {
-			#pragma omp critical (targets)
-			{
-			targets.push_back(I);
-			}
+			pool.push(tid, I);
 			continue;
 		}
 #else
@@ -1045,12 +1032,9 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 				#endif // UNIFY_REST == 1
 				}
 			}
+			my_giveup++;
 			#pragma omp atomic
-			count_giveup++;
-			#pragma omp critical (targets)
-			{
 			count_unknown--;
-			}
 			continue;
 		}
 
@@ -1067,11 +1051,9 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 				tmp = mid(I1(mi2));
 				I1(mi2).assign(I1(mi2).lower(), tmp);
 				I3(mi2).assign(tmp, I3(mi2).upper());
-				#pragma omp critical (targets)
-				{
-				targets.push_back(I3);
+				#pragma omp atomic
 				count_unknown += 1;
-				}
+				pool.push(tid, I3);
 			}
 		}
 		if (allsol_sub::include_infinity(I2(mi))) {
@@ -1081,22 +1063,29 @@ std::list< ub::vector < interval<T> > >* rest = NULL
 				tmp = mid(I2(mi2));
 				I2(mi2).assign(I2(mi2).lower(), tmp);
 				I3(mi2).assign(tmp, I3(mi2).upper());
-				#pragma omp critical (targets)
-				{
-				targets.push_back(I3);
+				#pragma omp atomic
 				count_unknown += 1;
-				}
+				pool.push(tid, I3);
 			}
 		}
 #endif
-		#pragma omp critical (targets)
-		{
-		targets.push_back(I1);
-		targets.push_back(I2);
+		#pragma omp atomic
 		count_unknown += 1;
-		}
+		pool.push(tid, I1);
+		pool.push(tid, I2);
 	}
 
+	#pragma omp atomic
+	count_ne_test += my_ne_test;
+	#pragma omp atomic
+	count_ex_test += my_ex_test;
+	#pragma omp atomic
+	count_ne += my_ne;
+	#pragma omp atomic
+	count_ex += my_ex;
+	#pragma omp atomic
+	count_giveup += my_giveup;
+
 	} // pragma omp parallel
 
 	if (verbose >= 1) {
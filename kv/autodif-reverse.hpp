@@ -0,0 +1,478 @@
+/*
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef AUTODIF_REVERSE_HPP
+#define AUTODIF_REVERSE_HPP
+
+// Automatic Differentiation by top down (reverse) algorithm
+//
+//  autodif_reverse<T> records each operation with its partial
+//  derivatives on a tape, and split computes the derivatives by one
+//  backward sweep over the tape for each component of the output.
+//  the gradient of a function R^n -> R costs a constant multiple of
+//  the function, independent of n, while autodif<T> costs O(n) for
+//  each operation.
+//
+//  the API is the same as autodif for init and split:
+//   kv::autodif_reverse<T>::split(f(kv::autodif_reverse<T>::init(x)), v, d);
+//
+//  the tape belongs to each T (and to each thread if OpenMP is
+//  enabled). init clears the tape, so the values made before the last
+//  init must not be used after it. the memory of the tape is kept and
+//  reused by the next init.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <cmath>
+
+#include <kv/convert.hpp>
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+namespace autodif_reverse_sub {
+
+// an operation on the tape: the indices of at most two arguments
+// (-1 if none) and the partial derivatives with respect to them.
+
+template <class T> struct node {
+	int a, b;
+	T da, db;
+};
+
+template <class T> struct tape {
+	std::vector< node<T> > nodes;
+	std::vector<T> adjoint;
+	int n; // number of independent variables
+
+	tape() : n(0) {}
+
+	void clear() {
+		nodes.clear();
+		n = 0;
+	}
+
+	int push(int a, const T& da, int b, const T& db) {
+		node<T> x;
+
+		x.a = a;
+		x.b = b;
+		x.da = da;
+		x.db = db;
+		nodes.push_back(x);
+
+		return nodes.size() - 1;
+	}
+
+	// derivatives of the node k with respect to the independent
+	// variables
+	void backward(int k, ub::vector<T>& d) {
+		int i;
+
+		d.resize(n);
+		if (k < 0) {
+			for (i=0; i<n; i++) d(i) = 0.;
+			return;
+		}
+
+		// k < n - 1 if the node is an independent variable itself
+		adjoint.assign(std::max(k + 1, n), T(0.));
+		adjoint[k] = 1.;
+		for (i=k; i>=n; i--) {
+			const node<T>& x = nodes[i];
+			if (x.a >= 0) adjoint[x.a] += adjoint[i] * x.da;
+			if (x.b >= 0) adjoint[x.b] += adjoint[i] * x.db;
+		}
+		for (i=0; i<n; i++) d(i) = adjoint[i];
+	}
+};
+
+} // namespace autodif_reverse_sub
+
+
+template <class T> class autodif_reverse;
+template <class C, class T> struct convertible<C, autodif_reverse<T> > {
+	static const bool value = convertible<C, T>::value || boost::is_same<C, autodif_reverse<T> >::value;
+};
+template <class C, class T> struct acceptable_n<C, autodif_reverse<T> > {
+	static const bool value = convertible<C, T>::value;
+};
+
+
+template <class T> class autodif_reverse {
+	public:
+	T v;
+	int i; // index on the tape, -1 if constant
+
+	typedef T base_type;
+
+	autodif_reverse() {
+		v = 0.;
+		i = -1;
+	}
+
+	template <class C> explicit autodif_reverse(const C& x, typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value >::type* =0) {
+		v = x;
+		i = -1;
+	}
+
+	template <class C> typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse& >::type operator=(const C& x) {
+		v = x;
+		i = -1;
+		return *this;
+	}
+
+	static autodif_reverse_sub::tape<T>& tape() {
+#ifdef _OPENMP // hack for non-POD thread local storage
+		static autodif_reverse_sub::tape<T>* t = NULL;
+		#pragma omp threadprivate (t)
+		if (t == NULL) {
+			t = new autodif_reverse_sub::tape<T>();
+		}
+		return *t;
+#else
+		static autodif_reverse_sub::tape<T> t;
+		return t;
+#endif
+	}
+
+	// allocate the tape for size operations in advance
+	static void reserve(int size) {
+		tape().nodes.reserve(size);
+		tape().adjoint.reserve(size);
+	}
+
+	// result of a function of x whose derivative is dx
+	static autodif_reverse unary(const T& v, const autodif_reverse& x, const T& dx) {
+		autodif_reverse r;
+
+		r.v = v;
+		if (x.i >= 0) r.i = tape().push(x.i, dx, -1, T(0.));
+
+		return r;
+	}
+
+	// result of a function of x and y whose partial derivatives are
+	// dx and dy
+	static autodif_reverse binary(const T& v, const autodif_reverse& x, const T& dx, const autodif_reverse& y, const T& dy) {
+		autodif_reverse r;
+
+		r.v = v;
+		if (x.i < 0) {
+			if (y.i >= 0) r.i = tape().push(y.i, dy, -1, T(0.));
+		} else if (y.i < 0) {
+			r.i = tape().push(x.i, dx, -1, T(0.));
+		} else {
+			r.i = tape().push(x.i, dx, y.i, dy);
+		}
+
+		return r;
+	}
+
+	friend autodif_reverse operator+(const autodif_reverse& a, const autodif_reverse& b) {
+		return binary(a.v + b.v, a, T(1.), b, T(1.));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator+(const autodif_reverse& a, const C& b) {
+		return unary(a.v + b, a, T(1.));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator+(const C& a, const autodif_reverse& b) {
+		return unary(a + b.v, b, T(1.));
+	}
+
+	friend autodif_reverse& operator+=(autodif_reverse& a, const autodif_reverse& b) {
+		a = a + b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse& >::type operator+=(autodif_reverse& a, const C& b) {
+		a.v += b;
+		return a;
+	}
+
+	friend autodif_reverse operator-(const autodif_reverse& a, const autodif_reverse& b) {
+		return binary(a.v - b.v, a, T(1.), b, T(-1.));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator-(const autodif_reverse& a, const C& b) {
+		return unary(a.v - b, a, T(1.));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator-(const C& a, const autodif_reverse& b) {
+		return unary(a - b.v, b, T(-1.));
+	}
+
+	friend autodif_reverse& operator-=(autodif_reverse& a, const autodif_reverse& b) {
+		a = a - b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse& >::type operator-=(autodif_reverse& a, const C& b) {
+		a.v -= b;
+		return a;
+	}
+
+	friend autodif_reverse operator-(const autodif_reverse& a) {
+		return unary(- a.v, a, T(-1.));
+	}
+
+	friend autodif_reverse operator*(const autodif_reverse& a, const autodif_reverse& b) {
+		return binary(a.v * b.v, a, b.v, b, a.v);
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator*(const autodif_reverse& a, const C& b) {
+		return unary(a.v * b, a, T(b));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator*(const C& a, const autodif_reverse& b) {
+		return unary(a * b.v, b, T(a));
+	}
+
+	friend autodif_reverse& operator*=(autodif_reverse& a, const autodif_reverse& b) {
+		a = a * b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse& >::type operator*=(autodif_reverse& a, const C& b) {
+		a = a * b;
+		return a;
+	}
+
+	friend autodif_reverse operator/(const autodif_reverse& a, const autodif_reverse& b) {
+		T r = a.v / b.v;
+		T tmp = 1. / b.v;
+		return binary(r, a, tmp, b, - r * tmp);
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator/(const autodif_reverse& a, const C& b) {
+		return unary(a.v / b, a, 1. / T(b));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type operator/(const C& a, const autodif_reverse& b) {
+		return unary(a / b.v, b, -a / (b.v * b.v));
+	}
+
+	friend autodif_reverse& operator/=(autodif_reverse& a, const autodif_reverse& b) {
+		a = a / b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse& >::type operator/=(autodif_reverse& a, const C& b) {
+		a = a / b;
+		return a;
+	}
+
+	friend std::ostream& operator<<(std::ostream& s, const autodif_reverse& x) {
+		s << x.v;
+		return s;
+	}
+
+	friend autodif_reverse pow(const autodif_reverse& x, int y) {
+		using std::pow;
+		if (y == 0) {
+			return unary(pow(x.v, y), x, T(0.));
+		} else {
+			return unary(pow(x.v, y), x, y * pow(x.v, y - 1));
+		}
+	}
+
+	friend autodif_reverse pow(const autodif_reverse& x, const autodif_reverse& y) {
+		return exp(y * log(x));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value && ! boost::is_integral<C>::value, autodif_reverse >::type pow(const autodif_reverse& a, const C& b) {
+		return pow(a, autodif_reverse(b));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_reverse>::value, autodif_reverse >::type pow(const C& a, const autodif_reverse& b) {
+		return pow(autodif_reverse(a), b);
+	}
+
+	friend autodif_reverse exp (const autodif_reverse& x) {
+		using std::exp;
+		T r = exp(x.v);
+		return unary(r, x, r);
+	}
+
+	friend autodif_reverse log (const autodif_reverse& x) {
+		using std::log;
+		return unary(log(x.v), x, 1. / x.v);
+	}
+
+	friend autodif_reverse sqrt (const autodif_reverse& x) {
+		using std::sqrt;
+		T r = sqrt(x.v);
+		return unary(r, x, 1. / (2. * r));
+	}
+
+	friend autodif_reverse sin (const autodif_reverse& x) {
+		using std::sin;
+		using std::cos;
+		return unary(sin(x.v), x, cos(x.v));
+	}
+
+	friend autodif_reverse cos (const autodif_reverse& x) {
+		using std::sin;
+		using std::cos;
+		return unary(cos(x.v), x, -sin(x.v));
+	}
+
+	friend autodif_reverse tan (const autodif_reverse& x) {
+		T tmp;
+
+		using std::tan;
+		using std::cos;
+		tmp = cos(x.v);
+		tmp = 1. / (tmp * tmp);
+		return unary(tan(x.v), x, tmp);
+	}
+
+	friend autodif_reverse asin (const autodif_reverse& x) {
+		using std::asin;
+		using std::sqrt;
+		return unary(asin(x.v), x, 1. / sqrt(1. - x.v * x.v));
+	}
+
+	friend autodif_reverse acos (const autodif_reverse& x) {
+		using std::acos;
+		using std::sqrt;
+		return unary(acos(x.v), x, -1. / sqrt(1. - x.v * x.v));
+	}
+
+	friend autodif_reverse atan (const autodif_reverse& x) {
+		using std::atan;
+		return unary(atan(x.v), x, 1. / (1. + x.v * x.v));
+	}
+
+	friend autodif_reverse sinh (const autodif_reverse& x) {
+		using std::sinh;
+		using std::cosh;
+		return unary(sinh(x.v), x, cosh(x.v));
+	}
+
+	friend autodif_reverse cosh (const autodif_reverse& x) {
+		using std::sinh;
+		using std::cosh;
+		return unary(cosh(x.v), x, sinh(x.v));
+	}
+
+	friend autodif_reverse tanh (const autodif_reverse& x) {
+		T tmp;
+
+		using std::tanh;
+		using std::cosh;
+		tmp = cosh(x.v);
+		tmp = 1. / (tmp * tmp);
+		return unary(tanh(x.v), x, tmp);
+	}
+
+	friend autodif_reverse asinh (const autodif_reverse& x) {
+		// using std::asinh;
+		using std::sqrt;
+		return unary(asinh(x.v), x, 1. / sqrt(x.v * x.v + 1.));
+	}
+
+	friend autodif_reverse acosh (const autodif_reverse& x) {
+		// using std::acosh;
+		using std::sqrt;
+		return unary(acosh(x.v), x, 1. / sqrt(x.v * x.v - 1.));
+	}
+
+	friend autodif_reverse atanh (const autodif_reverse& x) {
+		// using std::atanh;
+		return unary(atanh(x.v), x, 1. / (1. - x.v * x.v));
+	}
+
+	// n-dimensional version
+	static ub::vector<autodif_reverse> init (const ub::vector<T>& in) {
+		int i;
+		int n = in.size();
+		ub::vector<autodif_reverse> out(n);
+
+		tape().clear();
+		for (i=0; i<n; i++) {
+			out(i).v = in(i);
+			out(i).i = tape().push(-1, T(0.), -1, T(0.));
+		}
+		tape().n = n;
+
+		return out;
+	}
+
+	// 1-dimensional version
+	static autodif_reverse init (const T& in) {
+		autodif_reverse out;
+
+		tape().clear();
+		out.v = in;
+		out.i = tape().push(-1, T(0.), -1, T(0.));
+		tape().n = 1;
+
+		return out;
+	}
+
+	// for functions R^n -> R^m
+	static void split (const ub::vector<autodif_reverse>& in, ub::vector<T>& v, ub::matrix<T>& d) {
+		int i, j;
+		int m = in.size();
+		int n = tape().n;
+		ub::vector<T> g;
+
+		if (in.size() == 0) return;
+
+		v.resize(m);
+		d.resize(m, n);
+		for (i=0; i<m; i++) {
+			v(i) = in(i).v;
+			tape().backward(in(i).i, g);
+			for (j=0; j<n; j++) {
+				d(i, j) = g(j);
+			}
+		}
+	}
+
+	// for functions R^n -> R
+	static void split (const autodif_reverse& in, T& v, ub::vector<T>& d) {
+		v = in.v;
+		tape().backward(in.i, d);
+	}
+
+	// for functions R -> R^m
+	static void split (const ub::vector<autodif_reverse>& in, ub::vector<T>& v, ub::vector<T>& d) {
+		int i;
+		int m = in.size();
+		ub::vector<T> g;
+
+		if (in.size() == 0) return;
+
+		v.resize(m);
+		d.resize(m);
+		for (i=0; i<m; i++) {
+			v(i) = in(i).v;
+			tape().backward(in(i).i, g);
+			d(i) = g(0);
+		}
+	}
+
+	// for functions R -> R
+	static void split (const autodif_reverse& in, T& v, T& d) {
+		ub::vector<T> g;
+
+		v = in.v;
+		tape().backward(in.i, g);
+		d = g(0);
+	}
+};
+
+} // namespace kv
+
+#endif // AUTODIF_REVERSE_HPP
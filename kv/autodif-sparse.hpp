@@ -0,0 +1,550 @@
+/*
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef AUTODIF_SPARSE_HPP
+#define AUTODIF_SPARSE_HPP
+
+// Automatic Differentiation by bottom up algorithm with sparse
+// derivatives
+//
+//  same as autodif<T> except that the derivative is stored as sorted
+//  (index, value) pairs. only the variables on which the value depends
+//  are stored, so the cost of each operation is proportional to the
+//  number of them instead of the number of all the variables. this is
+//  useful for large systems whose equations depend on a few variables
+//  each, such as discretized boundary value problems.
+//
+//  the Jacobian can be obtained as ub::compressed_matrix (row major)
+//  as well as ub::matrix.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <cmath>
+
+#include <kv/convert.hpp>
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+template <class T> class autodif_sparse;
+template <class C, class T> struct convertible<C, autodif_sparse<T> > {
+	static const bool value = convertible<C, T>::value || boost::is_same<C, autodif_sparse<T> >::value;
+};
+template <class C, class T> struct acceptable_n<C, autodif_sparse<T> > {
+	static const bool value = convertible<C, T>::value;
+};
+
+
+template <class T> class autodif_sparse {
+	public:
+	T v;
+	std::vector<int> idx; // indices of the variables, increasing
+	std::vector<T> d;     // derivatives with respect to them
+	int n;                // number of all the variables
+
+	typedef T base_type;
+
+	autodif_sparse() {
+		v = 0.;
+		n = 0;
+	}
+
+	template <class C> explicit autodif_sparse(const C& x, typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value >::type* =0) {
+		v = x;
+		n = 0;
+	}
+
+	template <class C> typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse& >::type operator=(const C& x) {
+		v = x;
+		idx.clear();
+		d.clear();
+		n = 0;
+		return *this;
+	}
+
+	// r.d = ca * a.d + cb * b.d.
+	// the index stored in only one of a and b is multiplied only.
+
+	static void lincomb(const autodif_sparse& a, const T& ca, const autodif_sparse& b, const T& cb, autodif_sparse& r) {
+		int as = a.idx.size();
+		int bs = b.idx.size();
+		int i = 0, j = 0;
+
+		r.idx.clear();
+		r.d.clear();
+		r.idx.reserve(as + bs);
+		r.d.reserve(as + bs);
+		while (i < as && j < bs) {
+			if (a.idx[i] < b.idx[j]) {
+				r.idx.push_back(a.idx[i]);
+				r.d.push_back(ca * a.d[i]);
+				i++;
+			} else if (a.idx[i] > b.idx[j]) {
+				r.idx.push_back(b.idx[j]);
+				r.d.push_back(cb * b.d[j]);
+				j++;
+			} else {
+				r.idx.push_back(a.idx[i]);
+				r.d.push_back(ca * a.d[i] + cb * b.d[j]);
+				i++;
+				j++;
+			}
+		}
+		for ( ; i<as; i++) {
+			r.idx.push_back(a.idx[i]);
+			r.d.push_back(ca * a.d[i]);
+		}
+		for ( ; j<bs; j++) {
+			r.idx.push_back(b.idx[j]);
+			r.d.push_back(cb * b.d[j]);
+		}
+		r.n = std::max(a.n, b.n);
+	}
+
+	// r.d = a.d + b.d (or a.d - b.d)
+
+	static void addsub(const autodif_sparse& a, const autodif_sparse& b, bool sub, autodif_sparse& r) {
+		int as = a.idx.size();
+		int bs = b.idx.size();
+		int i = 0, j = 0;
+
+		r.idx.clear();
+		r.d.clear();
+		r.idx.reserve(as + bs);
+		r.d.reserve(as + bs);
+		while (i < as && j < bs) {
+			if (a.idx[i] < b.idx[j]) {
+				r.idx.push_back(a.idx[i]);
+				r.d.push_back(a.d[i]);
+				i++;
+			} else if (a.idx[i] > b.idx[j]) {
+				r.idx.push_back(b.idx[j]);
+				r.d.push_back(sub ? T(-b.d[j]) : b.d[j]);
+				j++;
+			} else {
+				r.idx.push_back(a.idx[i]);
+				r.d.push_back(sub ? T(a.d[i] - b.d[j]) : T(a.d[i] + b.d[j]));
+				i++;
+				j++;
+			}
+		}
+		for ( ; i<as; i++) {
+			r.idx.push_back(a.idx[i]);
+			r.d.push_back(a.d[i]);
+		}
+		for ( ; j<bs; j++) {
+			r.idx.push_back(b.idx[j]);
+			r.d.push_back(sub ? T(-b.d[j]) : b.d[j]);
+		}
+		r.n = std::max(a.n, b.n);
+	}
+
+	// result of a function of x whose derivative is dx
+
+	static autodif_sparse unary(const T& v, const autodif_sparse& x, const T& dx) {
+		autodif_sparse r;
+		int i;
+		int s = x.idx.size();
+
+		r.v = v;
+		r.idx = x.idx;
+		r.d.resize(s);
+		for (i=0; i<s; i++) r.d[i] = dx * x.d[i];
+		r.n = x.n;
+
+		return r;
+	}
+
+	friend autodif_sparse operator+(const autodif_sparse& a, const autodif_sparse& b) {
+		autodif_sparse r;
+
+		r.v = a.v + b.v;
+		addsub(a, b, false, r);
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse >::type operator+(const autodif_sparse& a, const C& b) {
+		autodif_sparse r(a);
+
+		r.v += b;
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse >::type operator+(const C& a, const autodif_sparse& b) {
+		autodif_sparse r(b);
+
+		r.v = a + b.v;
+
+		return r;
+	}
+
+	friend autodif_sparse& operator+=(autodif_sparse& a, const autodif_sparse& b) {
+		a = a + b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse& >::type operator+=(autodif_sparse& a, const C& b) {
+		a.v += b;
+		return a;
+	}
+
+	friend autodif_sparse operator-(const autodif_sparse& a, const autodif_sparse& b) {
+		autodif_sparse r;
+
+		r.v = a.v - b.v;
+		addsub(a, b, true, r);
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse >::type operator-(const autodif_sparse& a, const C& b) {
+		autodif_sparse r(a);
+
+		r.v -= b;
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse >::type operator-(const C& a, const autodif_sparse& b) {
+		autodif_sparse r(-b);
+
+		r.v = a - b.v;
+
+		return r;
+	}
+
+	friend autodif_sparse& operator-=(autodif_sparse& a, const autodif_sparse& b) {
+		a = a - b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse& >::type operator-=(autodif_sparse& a, const C& b) {
+		a.v -= b;
+		return a;
+	}
+
+	friend autodif_sparse operator-(const autodif_sparse& a) {
+		autodif_sparse r(a);
+		int i;
+		int s = r.d.size();
+
+		r.v = - a.v;
+		for (i=0; i<s; i++) r.d[i] = - r.d[i];
+
+		return r;
+	}
+
+	friend autodif_sparse operator*(const autodif_sparse& a, const autodif_sparse& b) {
+		autodif_sparse r;
+
+		r.v = a.v * b.v;
+		lincomb(a, b.v, b, a.v, r);
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse >::type operator*(const autodif_sparse& a, const C& b) {
+		return unary(a.v * b, a, T(b));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse >::type operator*(const C& a, const autodif_sparse& b) {
+		return unary(a * b.v, b, T(a));
+	}
+
+	friend autodif_sparse& operator*=(autodif_sparse& a, const autodif_sparse& b) {
+		a = a * b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse& >::type operator*=(autodif_sparse& a, const C& b) {
+		a = a * b;
+		return a;
+	}
+
+	friend autodif_sparse operator/(const autodif_sparse& a, const autodif_sparse& b) {
+		autodif_sparse r;
+		T tmp = 1. / b.v;
+
+		r.v = a.v / b.v;
+		lincomb(a, tmp, b, - r.v * tmp, r);
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse >::type operator/(const autodif_sparse& a, const C& b) {
+		return unary(a.v / b, a, 1. / T(b));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse >::type operator/(const C& a, const autodif_sparse& b) {
+		return unary(a / b.v, b, -a / (b.v * b.v));
+	}
+
+	friend autodif_sparse& operator/=(autodif_sparse& a, const autodif_sparse& b) {
+		a = a / b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse& >::type operator/=(autodif_sparse& a, const C& b) {
+		a = a / b;
+		return a;
+	}
+
+	friend std::ostream& operator<<(std::ostream& s, const autodif_sparse& x) {
+		int i;
+		int k = x.idx.size();
+		s << x.v;
+		s << '<';
+		for (i=0; i<k; i++) {
+			s << x.idx[i] << ':' << x.d[i];
+			if (i != k-1) {
+				s << ',';
+			}
+		}
+		s << '>';
+		return s;
+	}
+
+	friend autodif_sparse pow(const autodif_sparse& x, int y) {
+		using std::pow;
+		if (y == 0) {
+			return unary(pow(x.v, y), x, T(0.));
+		} else {
+			return unary(pow(x.v, y), x, y * pow(x.v, y - 1));
+		}
+	}
+
+	friend autodif_sparse pow(const autodif_sparse& x, const autodif_sparse& y) {
+		return exp(y * log(x));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value && ! boost::is_integral<C>::value, autodif_sparse >::type pow(const autodif_sparse& a, const C& b) {
+		return pow(a, autodif_sparse(b));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, autodif_sparse>::value, autodif_sparse >::type pow(const C& a, const autodif_sparse& b) {
+		return pow(autodif_sparse(a), b);
+	}
+
+	friend autodif_sparse exp (const autodif_sparse& x) {
+		using std::exp;
+		T r = exp(x.v);
+		return unary(r, x, r);
+	}
+
+	friend autodif_sparse log (const autodif_sparse& x) {
+		using std::log;
+		return unary(log(x.v), x, 1. / x.v);
+	}
+
+	friend autodif_sparse sqrt (const autodif_sparse& x) {
+		using std::sqrt;
+		T r = sqrt(x.v);
+		return unary(r, x, 1. / (2. * r));
+	}
+
+	friend autodif_sparse sin (const autodif_sparse& x) {
+		using std::sin;
+		using std::cos;
+		return unary(sin(x.v), x, cos(x.v));
+	}
+
+	friend autodif_sparse cos (const autodif_sparse& x) {
+		using std::sin;
+		using std::cos;
+		return unary(cos(x.v), x, -sin(x.v));
+	}
+
+	friend autodif_sparse tan (const autodif_sparse& x) {
+		T tmp;
+
+		using std::tan;
+		using std::cos;
+		tmp = cos(x.v);
+		tmp = 1. / (tmp * tmp);
+		return unary(tan(x.v), x, tmp);
+	}
+
+	friend autodif_sparse asin (const autodif_sparse& x) {
+		using std::asin;
+		using std::sqrt;
+		return unary(asin(x.v), x, 1. / sqrt(1. - x.v * x.v));
+	}
+
+	friend autodif_sparse acos (const autodif_sparse& x) {
+		using std::acos;
+		using std::sqrt;
+		return unary(acos(x.v), x, -1. / sqrt(1. - x.v * x.v));
+	}
+
+	friend autodif_sparse atan (const autodif_sparse& x) {
+		using std::atan;
+		return unary(atan(x.v), x, 1. / (1. + x.v * x.v));
+	}
+
+	friend autodif_sparse sinh (const autodif_sparse& x) {
+		using std::sinh;
+		using std::cosh;
+		return unary(sinh(x.v), x, cosh(x.v));
+	}
+
+	friend autodif_sparse cosh (const autodif_sparse& x) {
+		using std::sinh;
+		using std::cosh;
+		return unary(cosh(x.v), x, sinh(x.v));
+	}
+
+	friend autodif_sparse tanh (const autodif_sparse& x) {
+		T tmp;
+
+		using std::tanh;
+		using std::cosh;
+		tmp = cosh(x.v);
+		tmp = 1. / (tmp * tmp);
+		return unary(tanh(x.v), x, tmp);
+	}
+
+	friend autodif_sparse asinh (const autodif_sparse& x) {
+		// using std::asinh;
+		using std::sqrt;
+		return unary(asinh(x.v), x, 1. / sqrt(x.v * x.v + 1.));
+	}
+
+	friend autodif_sparse acosh (const autodif_sparse& x) {
+		// using std::acosh;
+		using std::sqrt;
+		return unary(acosh(x.v), x, 1. / sqrt(x.v * x.v - 1.));
+	}
+
+	friend autodif_sparse atanh (const autodif_sparse& x) {
+		// using std::atanh;
+		return unary(atanh(x.v), x, 1. / (1. - x.v * x.v));
+	}
+
+	// n-dimensional version
+	static ub::vector<autodif_sparse> init (const ub::vector<T>& in) {
+		int i;
+		int n = in.size();
+		ub::vector<autodif_sparse> out(n);
+
+		for (i=0; i<n; i++) {
+			out(i).v = in(i);
+			out(i).idx.assign(1, i);
+			out(i).d.assign(1, T(1.));
+			out(i).n = n;
+		}
+
+		return out;
+	}
+
+	// 1-dimensional version
+	static autodif_sparse init (const T& in) {
+		autodif_sparse out;
+
+		out.v = in;
+		out.idx.assign(1, 0);
+		out.d.assign(1, T(1.));
+		out.n = 1;
+
+		return out;
+	}
+
+	// for functions R^n -> R^m (sparse Jacobian)
+	static void split (const ub::vector<autodif_sparse>& in, ub::vector<T>& v, ub::compressed_matrix<T>& d) {
+		int i, j, n, nnz;
+		int m = in.size();
+
+		if (in.size() == 0) return;
+		n = 0;
+		nnz = 0;
+		for (i=0; i<m; i++) {
+			if (in(i).n > n) n = in(i).n;
+			nnz += in(i).idx.size();
+		}
+
+		v.resize(m);
+		d.resize(m, n, false);
+		d.clear();
+		d.reserve(nnz);
+		for (i=0; i<m; i++) {
+			v(i) = in(i).v;
+			for (j=0; j<(int)in(i).idx.size(); j++) {
+				d.push_back(i, in(i).idx[j], in(i).d[j]);
+			}
+		}
+		d.complete_index1_data();
+	}
+
+	// for functions R^n -> R^m
+	static void split (const ub::vector<autodif_sparse>& in, ub::vector<T>& v, ub::matrix<T>& d) {
+		int i, j, n;
+		int m = in.size();
+
+		if (in.size() == 0) return;
+		n = 0;
+		for (i=0; i<m; i++) {
+			if (in(i).n > n) n = in(i).n;
+		}
+
+		v.resize(m);
+		d.resize(m, n);
+		for (i=0; i<m; i++) {
+			v(i) = in(i).v;
+			for (j=0; j<n; j++) {
+				d(i, j) = 0.;
+			}
+			for (j=0; j<(int)in(i).idx.size(); j++) {
+				d(i, in(i).idx[j]) = in(i).d[j];
+			}
+		}
+	}
+
+	// for functions R^n -> R
+	static void split (const autodif_sparse& in, T& v, ub::vector<T>& d) {
+		int j;
+
+		v = in.v;
+		d.resize(in.n);
+		for (j=0; j<in.n; j++) {
+			d(j) = 0.;
+		}
+		for (j=0; j<(int)in.idx.size(); j++) {
+			d(in.idx[j]) = in.d[j];
+		}
+	}
+
+	// for functions R -> R^m
+	static void split (const ub::vector<autodif_sparse>& in, ub::vector<T>& v, ub::vector<T>& d) {
+		int i;
+		int m = in.size();
+
+		if (in.size() == 0) return;
+
+		v.resize(m);
+		d.resize(m);
+		for (i=0; i<m; i++) {
+			v(i) = in(i).v;
+			d(i) = in(i).idx.empty() ? T(0.) : in(i).d[0];
+		}
+	}
+
+	// for functions R -> R
+	static void split (const autodif_sparse& in, T& v, T& d) {
+		v = in.v;
+		d = in.idx.empty() ? T(0.) : in.d[0];
+	}
+};
+
+} // namespace kv
+
+#endif // AUTODIF_SPARSE_HPP
@@ -10,9 +10,16 @@
 #include <cmath>
 #include <limits>
 #include <algorithm>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <exception>
 #include <kv/interval.hpp>
 #include <kv/rdouble.hpp>
 #include <kv/psa.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 #ifndef DEFINT_FAST
@@ -23,16 +30,133 @@
 #define RESTART_MAX 10
 #endif
 
+// 0: evaluate the subintervals serially (default)
+// 1: distribute the subintervals of defint over threads and pipeline
+//    the steps of defint_autostep over two threads if OpenMP is enabled.
+//    both give the same result as the serial evaluation. an exception
+//    thrown on a thread is carried by std::exception_ptr, so this needs
+//    C++11. it is ignored before C++11.
+
+#ifndef DEFINT_PARALLEL
+#define DEFINT_PARALLEL 0
+#endif
+
+// defint uses threads only if n >= DEFINT_PARALLEL_MIN
+
+#ifndef DEFINT_PARALLEL_MIN
+#define DEFINT_PARALLEL_MIN 4
+#endif
+
 
 namespace kv {
 
+#if DEFINT_PARALLEL && defined(_OPENMP) && __cplusplus >= 201103L
+
+namespace defint_sub {
+
+/*
+ * each subinterval is evaluated by a copy of f with the psa context
+ * (mode, history flags and domain) of its own thread. the integrals of
+ * the subintervals are summed in ascending order after all of them have
+ * been computed, so the result does not depend on the number of threads.
+ */
+
+template <class T, class F>
+interval<T>
+defint_parallel(F f, interval<T> start, interval<T> end, int order, int n) {
+	interval<T> r, step, result;
+	std::vector< interval<T> > z(n);
+	int i, err;
+	std::exception_ptr error;
+
+	step = (end - start) / (T)n;
+	r = step * 0.5;
+	err = n;
+
+	#pragma omp parallel private(i)
+	{
+	F g(f);
+	psa< interval<T> > x, y;
+	int save_mode;
+	bool save_uh, save_rh, ok;
+
+	// exceptions must not leave the parallel region. they are kept and
+	// thrown again after it.
+	ok = true;
+	try {
+		x.v.resize(2);
+		// x.v(0) = 0.;
+		x.v(1) = 1.;
+		x = setorder(x, order);
+	}
+	catch (...) {
+		// the same in all the threads and before any subinterval
+		#pragma omp critical (defint)
+		if (err >= 0) {
+			err = -1;
+			error = std::current_exception();
+		}
+		ok = false;
+	}
+
+	save_mode = psa< interval<T> >::mode();
+	save_uh = psa< interval<T> >::use_history();
+	save_rh = psa< interval<T> >::record_history();
+	psa< interval<T> >::mode() = 2;
+	psa< interval<T> >::use_history() = false;
+	psa< interval<T> >::record_history() = false;
+
+	// psa< interval<T> >::domain() = interval<T>(-r.upper(), r.upper());
+	psa< interval<T> >::domain() = interval<T>::hull(-r, r);
+
+	#pragma omp for schedule(dynamic)
+	for (i=0; i<n; i++) {
+		if (!ok) continue;
+		try {
+			x.v(0) = start + (T)i * step + r;
+			y = integrate(g(x));
+			z[i] = eval(y, r) - eval(y, -r);
+		}
+		catch (...) {
+			// keep the error of the first subinterval as the serial loop
+			#pragma omp critical (defint)
+			if (i < err) {
+				err = i;
+				error = std::current_exception();
+			}
+		}
+	}
+
+	psa< interval<T> >::mode() = save_mode;
+	psa< interval<T> >::use_history() = save_uh;
+	psa< interval<T> >::record_history() = save_rh;
+	}
+
+	if (err < n) std::rethrow_exception(error);
+
+	result = 0.;
+	for (i=0; i<n; i++) result += z[i];
+
+	return result;
+}
+
+} // namespace defint_sub
+
+#endif
+
 template <class T, class F>
 interval<T>
 defint(F f, interval<T> start, interval<T> end, int order, int n) {
-	interval<T> r, step, c, z, result;
+	interval<T> r, step, result;
 	psa< interval<T> > x, y;
-	int i, j, s;
-	bool save_mode, save_uh, save_rh;
+	int i, save_mode;
+	bool save_uh, save_rh;
+
+#if DEFINT_PARALLEL && defined(_OPENMP) && __cplusplus >= 201103L
+	if (n >= DEFINT_PARALLEL_MIN && !omp_in_parallel() && omp_get_max_threads() > 1) {
+		return defint_sub::defint_parallel(f, start, end, order, n);
+	}
+#endif
 
 	step = (end - start) / (T)n;
 	r = step * 0.5;
@@ -53,51 +177,331 @@ defint(F f, interval<T> start, interval<T> end, int order, int n) {
 	psa< interval<T> >::domain() = interval<T>::hull(-r, r);
 
 	result = 0.;
-
 	for (i=0; i<n; i++) {
-		c = start + (T)i * step + r;
-		x.v(0) = c;
+		x.v(0) = start + (T)i * step + r;
 		y = integrate(f(x));
+		result += eval(y, r) - eval(y, -r);
+	}
+
+	psa< interval<T> >::mode() = save_mode;
+	psa< interval<T> >::use_history() = save_uh;
+	psa< interval<T> >::record_history() = save_rh;
 
-		z = eval(y, r) - eval(y, -r);
+	return result;
+}
+
+namespace defint_sub {
+
+// Taylor coefficients of the integral of f at t in mode 1. the history
+// is recorded for the mode 2 evaluations of the step on the same thread.
+
+template <class T, class F>
+void autostep_taylor(F& f, psa< interval<T> >& x, const interval<T>& t, int order, psa< interval<T> >& y) {
+	x.v(0) = t;
+	psa< interval<T> >::mode() = 1;
+	#if DEFINT_FAST == 1
+	psa< interval<T> >::use_history() = false;
+	psa< interval<T> >::record_history() = true;
+	psa< interval<T> >::history().clear();
+	#endif
+	y = integrate(f(x));
+
+	// set order preparing for constant function
+	y = setorder(y, order);
+}
+
+// first estimate of the step size from the Taylor coefficients
+
+template <class T>
+T autostep_radius(const psa< interval<T> >& y, int order, T tolerance) {
+	T radius, radius_tmp, m;
+	int i, n_rad;
+
+	radius = 0.;
+	n_rad = 0;
+	for (i=order; i>=1; i--) {
+		#ifdef DEFINT_STEPSIZE_MAG
+		m = mag(y.v(i));
+		#else
+		m = mig(y.v(i));
+		#endif
+		if (m == 0.) continue;
+		radius_tmp = std::pow((double)m, 1./i);
+		if (radius_tmp > radius) radius = radius_tmp;
+		n_rad++;
+		if (n_rad == 2) break;
+	}
+	return std::pow((double)tolerance, 1./order) / radius;
+}
+
+// end point t1 of the step of size radius from t toward end.
+// returns true if the step reaches end.
+
+template <class T>
+bool autostep_next(const interval<T>& t, const interval<T>& end, T radius, interval<T>& t1) {
+	interval<T> step;
+
+	step = end - t;
+	if (subset(step, interval<T>(-radius, radius))) {
+		t1 = end;
+		return true;
+	}
+	if (step.lower() > 0.) {
+		t1 = mid(t + radius);
+	} else {
+		t1 = mid(t - radius);
+	}
+	return false;
+}
 
-		#if 0
-		s = y.v.size() - 1;
-		z = (s % 2 == 0) ? y.v(s) - y.v(s) : y.v(s) * 2.;
-		for (j=s-1; j>=0; j--) {
-			if (j % 2 == 0) {
-				z *= r;
-			} else {
-				z = z * r + y.v(j) * 2.;
+// enclosure of the integral over [t, t1] in mode 2
+
+template <class T, class F>
+interval<T> autostep_eval(F& f, psa< interval<T> >& x, const interval<T>& t, const interval<T>& t1) {
+	interval<T> step;
+	psa< interval<T> > y;
+
+	step = t1 - t;
+
+	// psa< interval<T> >::domain() = interval<T,P>(0., step.upper());
+	psa< interval<T> >::domain() = interval<T>::hull(0., step);
+
+	y = integrate(f(x));
+
+	// z = eval(y, step) - eval(y, 0.);
+	// eval(y, 0.) should be 0
+	return eval(y, step);
+}
+
+// shrink the step after the evaluation failed
+
+template <class T>
+void autostep_restart(T& radius, int& restart) {
+	if (restart < RESTART_MAX) {
+		psa< interval<T> >::use_history() = false;
+		radius *= 0.5;
+		restart++;
+	} else {
+		throw std::domain_error("defint_autostep: evaluation error");
+	}
+}
+
+// adjust the step so that the width of its integral z meets tolerance
+
+template <class T>
+void autostep_resize(T& radius, const interval<T>& z, T tolerance, int order, int restart) {
+	T m;
+
+	m = rad(z) / tolerance;
+	if (restart > 0) {
+		radius /= std::max(1., std::pow((double)m, 1. / order));
+	} else {
+		radius /= std::pow((double)m, 1. / order);
+	}
+}
+
+#if DEFINT_PARALLEL && defined(_OPENMP) && __cplusplus >= 201103L
+
+/*
+ * defint_autostep on two threads. a step needs the Taylor coefficients
+ * at its start point t, a trial evaluation, and the final evaluation
+ * over [t, t1]. the coefficients do not depend on the tolerance, so the
+ * other thread computes the coefficients at t1 speculatively while the
+ * owner of the step does the final evaluation, and then owns the next
+ * step (the history of psa is thread local). if the final evaluation
+ * fails, t1 is changed, so the speculation is discarded and the owner
+ * continues alone. every step is computed exactly as in the serial
+ * loop, so the result is the same. an exception is kept and thrown
+ * again after the parallel region.
+ */
+
+template <class T, class F>
+interval<T> autostep_parallel(F f, interval<T> start, interval<T> end, int order, T epsilon) {
+	interval<T> t, t1, z, result;
+	T radius;
+	int owner, restart;
+	bool flag, ready, done, error, final_ok, spec_error, setup_error;
+	std::exception_ptr eptr, spec_eptr;
+
+	t = start;
+	result = 0.;
+	owner = 0;
+	ready = false;
+	done = false;
+	error = false;
+	flag = false;
+	final_ok = true;
+	spec_error = false;
+	setup_error = false;
+
+	#pragma omp parallel num_threads(2)
+	{
+	int me = omp_get_thread_num();
+	int other = omp_get_num_threads() - 1 - me;
+	F g(f);
+	psa< interval<T> > x, y;
+	T tolerance;
+	int save_mode;
+	bool save_uh, save_rh, own;
+
+	save_mode = psa< interval<T> >::mode();
+	save_uh = psa< interval<T> >::use_history();
+	save_rh = psa< interval<T> >::record_history();
+	psa< interval<T> >::use_history() = false;
+	psa< interval<T> >::record_history() = false;
+
+	try {
+		x.v.resize(2);
+		// x.v(0) = 0.;
+		x.v(1) = 1.;
+		x = setorder(x, order-1);
+	}
+	catch (...) {
+		#pragma omp critical (defint)
+		{
+		setup_error = true;
+		error = true;
+		eptr = std::current_exception();
+		}
+	}
+	#pragma omp barrier
+
+	// error may be set by the other thread in the loop at any time, but
+	// setup_error is not changed after the barrier.
+	while (!setup_error) {
+		// owner is changed in the last phase
+		own = (me == owner);
+
+		// trial evaluation and the end point of the step
+		if (own) {
+			try {
+				tolerance = std::max((T)1., norm(result)) * epsilon;
+				if (!ready) autostep_taylor(g, x, t, order, y);
+				radius = autostep_radius(y, order, tolerance);
+
+				psa< interval<T> >::mode() = 2;
+				#if DEFINT_FAST == 1
+				psa< interval<T> >::use_history() = true;
+				#endif
+
+				restart = 0;
+				while (true) {
+					flag = autostep_next(t, end, radius, t1);
+					try {
+						z = autostep_eval(g, x, t, t1);
+						break;
+					}
+					catch (std::domain_error& e) {
+						autostep_restart(radius, restart);
+					}
+				}
+				autostep_resize(radius, z, tolerance, order, restart);
+				flag = autostep_next(t, end, radius, t1);
+			}
+			catch (...) {
+				error = true;
+				eptr = std::current_exception();
 			}
 		}
-		#endif
-		
-		result += z;
+		#pragma omp barrier
+		if (error) break;
+
+		// final evaluation and the speculative coefficients at t1
+		if (own) {
+			try {
+				z = autostep_eval(g, x, t, t1);
+				final_ok = true;
+			}
+			catch (std::domain_error& e) {
+				final_ok = false;
+			}
+			catch (...) {
+				error = true;
+				eptr = std::current_exception();
+			}
+		} else if (!flag) {
+			try {
+				autostep_taylor(g, x, t1, order, y);
+				spec_error = false;
+			}
+			catch (...) {
+				spec_error = true;
+				spec_eptr = std::current_exception();
+			}
+		}
+		#pragma omp barrier
+		if (error) break;
+
+		if (own) {
+			try {
+				ready = final_ok && !flag && other != me;
+				while (!final_ok) {
+					autostep_restart(radius, restart);
+					flag = autostep_next(t, end, radius, t1);
+					try {
+						z = autostep_eval(g, x, t, t1);
+						final_ok = true;
+					}
+					catch (std::domain_error& e) {
+					}
+				}
+				#ifdef DEFINT_SHOW_STEPSIZE
+				std::cout << "stepsize: " << t1 - t << "\n";
+				#endif
+
+				result += z;
+				done = flag;
+				t = t1;
+				if (ready) {
+					owner = other;
+					if (spec_error) {
+						error = true;
+						eptr = spec_eptr;
+					}
+				}
+			}
+			catch (...) {
+				error = true;
+				eptr = std::current_exception();
+			}
+		}
+		#pragma omp barrier
+		if (error || done) break;
 	}
 
 	psa< interval<T> >::mode() = save_mode;
 	psa< interval<T> >::use_history() = save_uh;
 	psa< interval<T> >::record_history() = save_rh;
+	}
+
+	if (error) std::rethrow_exception(eptr);
 
 	return result;
 }
 
+#endif
+
+} // namespace defint_sub
+
 template <class T, class F>
 interval<T>
 defint_autostep(F f, interval<T> start, interval<T> end, int order, T epsilon = std::numeric_limits<T>::epsilon()) {
-	interval<T> t, t1, z, step, result;
+	interval<T> t, t1, z, result;
 	psa< interval<T> > x, y;
-	int i;
 	bool flag;
 	bool save_mode, save_uh, save_rh;
 
-	T radius, radius_tmp, m;
+	T radius;
 	T tolerance;
-	int n_rad;
 	bool resized;
 	int restart;
 
+#if DEFINT_PARALLEL && defined(_OPENMP) && __cplusplus >= 201103L
+	if (!omp_in_parallel() && omp_get_max_threads() > 1) {
+		return defint_sub::autostep_parallel(f, start, end, order, epsilon);
+	}
+#endif
+
 	save_mode = psa< interval<T> >::mode();
 	save_uh = psa< interval<T> >::use_history();
 	save_rh = psa< interval<T> >::record_history();
@@ -115,35 +519,9 @@ defint_autostep(F f, interval<T> start, interval<T> end, int order, T epsilon =
 	while (1) {
 		tolerance = std::max((T)1., norm(result)) * epsilon;
 
-		x.v(0) = t;
-		psa< interval<T> >::mode() = 1;
-		#if DEFINT_FAST == 1
-		psa< interval<T> >::use_history() = false;
-		psa< interval<T> >::record_history() = true;
-		psa< interval<T> >::history().clear();
-		#endif
-		y = integrate(f(x));
-
-		// set order preparing for constant function
-		y = setorder(y, order);
-
-		radius = 0.;
-		n_rad = 0;
-		for (i=order; i>=1; i--) {
-			#ifdef DEFINT_STEPSIZE_MAG
-			m = mag(y.v(i));
-			#else
-			m = mig(y.v(i));
-			#endif
-			if (m == 0.) continue;
-			radius_tmp = std::pow((double)m, 1./i);
-			if (radius_tmp > radius) radius = radius_tmp;
-			n_rad++;
-			if (n_rad == 2) break;
-		}
-		radius = std::pow((double)tolerance, 1./order) / radius;
+		defint_sub::autostep_taylor(f, x, t, order, y);
+		radius = defint_sub::autostep_radius(y, order, tolerance);
 
-		// x.v(0) = t;
 		psa< interval<T> >::mode() = 2;
 		#if DEFINT_FAST == 1
 		psa< interval<T> >::use_history() = true;
@@ -153,54 +531,23 @@ defint_autostep(F f, interval<T> start, interval<T> end, int order, T epsilon =
 		resized = false;
 		restart = 0;
 		while (true) {
-			step = end - t;
-
-			if (subset(step, interval<T>(-radius, radius))) {
-				flag = true;
-				t1 = end;
-			} else {
-				flag = false;
-				if (step.lower() > 0.) {
-					t1 = mid(t + radius);
-				} else {
-					t1 = mid(t - radius);
-				}
-				step = t1 - t;
-			}
-
-			// psa< interval<T> >::domain() = interval<T,P>(0., step.upper());
-			psa< interval<T> >::domain() = interval<T>::hull(0., step);
+			flag = defint_sub::autostep_next(t, end, radius, t1);
 
 			try {
-				y = integrate(f(x));
+				z = defint_sub::autostep_eval(f, x, t, t1);
 			}
 			catch (std::domain_error& e) {
-				if (restart < RESTART_MAX) {
-					psa< interval<T> >::use_history() = false;
-					radius *= 0.5;
-					restart++;
-					continue;
-				} else {
-					throw std::domain_error("defint_autostep: evaluation error");
-				}
+				defint_sub::autostep_restart(radius, restart);
+				continue;
 			}
 
-			// z = eval(y, step) - eval(y, 0.);
-			// eval(y, 0.) should be 0
-			z = eval(y, step);
-
 			if (resized == true) break;
 
 			resized = true;
-			m = rad(z) / tolerance;
-			if (restart > 0) {
-				radius /= std::max(1., std::pow((double)m, 1. / order));
-			} else {
-				radius /= std::pow((double)m, 1. / order);
-			}
+			defint_sub::autostep_resize(radius, z, tolerance, order, restart);
 		}
 		#ifdef DEFINT_SHOW_STEPSIZE
-		std::cout << "stepsize: " << step << "\n";
+		std::cout << "stepsize: " << t1 - t << "\n";
 		#endif
 
 		result += z;
@@ -5,7 +5,10 @@
 #ifndef DOUBLEINT_SINGULAR_HPP
 #define DOUBLEINT_SINGULAR_HPP
 
+#include <vector>
+#include <algorithm>
 #include <kv/defint-singular.hpp>
+#include <kv/doubleintegral.hpp>
 
 namespace kv {
 
@@ -52,6 +55,81 @@ template <class F> class Doubleint_Reverse12 {
  *         0         not zero    : singular with edge start2=0
  */          
 
+#if DOUBLEINTEGRAL_MPSA
+
+// f and g are evaluated in mpsa<interval<T>, 2> of total degree order.
+// the factor x1^multiplicity1 x2^multiplicity2 of f must be kept for
+// div_tn, so order is raised to keep(0) + keep(1) (at least
+// multiplicity1 + multiplicity2) if it is smaller.
+
+template <class T, class F1, class F2>
+interval<T>
+doubleintegral_power3
+(F1 f, F2 g, interval<T> start1, interval<T> end1, interval<T> start2, interval<T> end2, int order, interval<T> power, int multiplicity1 = 1, int multiplicity2 = 1) {
+	typedef mpsa< interval<T>, 2 > series;
+	interval<T> step1, step2, result;
+	series x1, x2, y;
+	int i, k, m;
+	int a[2];
+	interval<T> tx, tp;
+
+
+	step1 = end1 - start1;
+	step2 = end2 - start2;
+
+	series::domain(0) = interval<T>(0., step1.upper());
+	series::domain(1) = interval<T>(0., step2.upper());
+
+	// the factor x1^multiplicity1 x2^multiplicity2 of f must not be
+	// folded away before div_tn. the caller may have set keep already
+	// for div_tn in g (doubleintegral_singular_point).
+	typename series::keep_scope keep1(0, multiplicity1), keep2(1, multiplicity2);
+	// see above: the order is raised, not checked
+	order = std::max(order, series::keep(0) + series::keep(1));
+
+	x1 = series::variable(start1, 0, order);
+	x2 = series::variable(start2, 1, order);
+
+	y = f(x1, x2);
+	y = div_tn(y, 0, multiplicity1);
+	y = div_tn(y, 1, multiplicity2);
+
+	y = pow(y, power) * g(x1, x2);
+
+	// w1[i] = \int_0^step1 t^(power * multiplicity1 + i) dt
+	std::vector< interval<T> > w1(y.n + 1), w2(y.n + 1);
+
+	tp = power * multiplicity1 + 1.;
+	tx = pow(step1, tp);
+	for (i=0; i<=y.n; i++) {
+		w1[i] = tx / tp;
+		tp += 1.;
+		tx *= step1;
+	}
+
+	tp = power * multiplicity2 + 1.;
+	tx = pow(step2, tp);
+	for (i=0; i<=y.n; i++) {
+		w2[i] = tx / tp;
+		tp += 1.;
+		tx *= step2;
+	}
+
+	result = 0.;
+	k = 0;
+	for (m=0; m<=y.n; m++) {
+		series::first(a, m);
+		do {
+			result += y.v(k) * w1[a[0]] * w2[a[1]];
+			k++;
+		} while (series::next(a));
+	}
+
+	return result;
+}
+
+#else
+
 template <class T, class F1, class F2>
 interval<T>
 doubleintegral_power3
@@ -143,6 +221,8 @@ doubleintegral_power3
 	return result;
 }
 
+#endif // DOUBLEINTEGRAL_MPSA
+
 /*
  * doubleintegral_power3 with reversed 1st argument
  */
@@ -222,6 +302,11 @@ doubleintegral_singular_point
 	using std::abs;
 	det = abs((x1-x0) * (y2-y1) - (x2-x1) * (y1-y0));
 
+#if DOUBLEINTEGRAL_MPSA
+	// g divides f(x, y) by r^multiplicity
+	typename mpsa< interval<T>, 2 >::keep_scope keep(0, multiplicity);
+#endif
+
 	r = 0.;
 	for (i=0; i<div; i++) {
 
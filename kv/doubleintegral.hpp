@@ -9,8 +9,77 @@
 #include <kv/rdouble.hpp>
 #include <kv/psa.hpp>
 
+// how doubleintegral expands f in each cell
+//
+// 0: nested psa< psa<T> > of order in each variable (default)
+// 1: mpsa<T, 2> of total degree order. faster and uses less memory,
+//    but the terms of an elementary function beyond the order are
+//    bounded on the whole cell in both variables at once, so near a
+//    singularity of f the enclosure is wider (raising the order helps
+//    little there; use more cells instead).
+
+#ifndef DOUBLEINTEGRAL_MPSA
+#define DOUBLEINTEGRAL_MPSA 0
+#endif
+
+#if DOUBLEINTEGRAL_MPSA
+#include <kv/mpsa.hpp>
+#endif
+
 namespace kv {
 
+// \int \int f over [start1, end1] x [start2, end2] divided into n x n
+// cells.
+
+#if DOUBLEINTEGRAL_MPSA
+
+template <class T, class F>
+interval<T>
+doubleintegral(F f, interval<T> start1, interval<T> end1, interval<T> start2, interval<T> end2, int order, int n, bool triangle = false) {
+	typedef mpsa< interval<T>, 2 > series;
+	interval<T> r1, r2, step1, step2, c1, c2, result, w;
+	series x1, x2, y, z;
+	series upper_bound;
+	int i, j;
+
+
+	step1 = (end1 - start1) / (T)n;
+	step2 = (end2 - start2) / (T)n;
+	r1 = step1 / 2.;
+	r2 = step2 / 2.;
+
+	series::domain(0) = interval<T>(-r1.upper(), r1.upper());
+	series::domain(1) = interval<T>(-r2.upper(), r2.upper());
+
+	if (triangle) {
+		upper_bound = series::variable(interval<T>(0.), 1, order) * (-(end1 - start1) / (end2 - start2));
+	}
+
+	result = 0.;
+
+	for (i=0; i<n; i++) {
+		c2 = start2 + (T)i * step2 + r2;
+		x2 = series::variable(c2, 1, order);
+		for (j=0; j<n; j++) {
+			if (triangle && i+j > n-1) continue;
+			c1 = start1 + (T)j * step1 + r1;
+			x1 = series::variable(c1, 0, order);
+			y = integrate(f(x1, x2), 0);
+			if (triangle && i+j == n-1) {
+				z = integrate(eval(y, 0, upper_bound) - eval(y, 0, -r1), 1);
+			} else {
+				z = integrate(eval(y, 0, r1) - eval(y, 0, -r1), 1);
+			}
+			w = (eval(z, 1, r2) - eval(z, 1, -r2)).v(0);
+			result += w;
+		}
+	}
+
+	return result;
+}
+
+#else // DOUBLEINTEGRAL_MPSA
+
 template <class T, class F>
 interval<T>
 doubleintegral(F f, interval<T> start1, interval<T> end1, interval<T> start2, interval<T> end2, int order, int n, bool triangle = false) {
@@ -97,6 +166,8 @@ doubleintegral(F f, interval<T> start1, interval<T> end1, interval<T> start2, in
 	return result;
 }
 
+#endif // DOUBLEINTEGRAL_MPSA
+
 template <class F, class TT> class DoubleIntegralTriangleConv {
 	public:
 	F f;
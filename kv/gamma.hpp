@@ -6,6 +6,7 @@
 #define GAMMA_HPP
 
 #include <cmath>
+#include <vector>
 #include <kv/defint.hpp>
 #include <kv/defint-singular.hpp>
 
@@ -37,12 +38,336 @@ class Gamma_nopower {
 #define GAMMA_ORDER 18
 #endif
 
+/*
+ * GAMMA_CACHE
+ *
+ * how gamma on [1,2] (gamma_r, and digamma_plus through gamma'/gamma)
+ * is evaluated
+ *
+ *  0: by the integral for each call
+ *  1: by piecewise Taylor polynomials of gamma on [1,2] with verified
+ *     remainders, which are computed at the first call for each T.
+ *     used for T of at most GAMMA_CACHE_DIGITS digits and x contained
+ *     in one piece. otherwise by the integral.
+ *     the first call is slow: building the table takes about 0.5 s
+ *     for double but one to a few minutes for dd (about 80 s of CPU
+ *     time with -O2), so it pays off only for many calls.
+ */
+
+#ifndef GAMMA_CACHE
+#define GAMMA_CACHE 0
+#endif
+
+#ifndef GAMMA_CACHE_DIGITS
+#define GAMMA_CACHE_DIGITS 106
+#endif
+
+// number of pieces of [1,2] (power of 2)
+#ifndef GAMMA_CACHE_PIECES
+#define GAMMA_CACHE_PIECES 8
+#endif
+
+namespace gamma_sub {
+
+// integrals over [start, end] of v^j exp(c v - exp(v)) for c = c[i]
+// and j = j0[i], ..., j1[i] (the integral over R is the j-th
+// derivative of gamma at c). all the integrands have the common factor
+// exp(-exp(v)), so they are integrated together by one sequence of
+// steps chosen as in defint_autostep.
+
+template <class T>
+void moments(const std::vector< interval<T> >& c, const std::vector<int>& j0, const std::vector<int>& j1, const interval<T>& start, const interval<T>& end, int order, std::vector< interval<T> >& result)
+{
+	int nc = c.size();
+	int i, j, k, m, kmax;
+	interval<T> t, t1;
+	psa< interval<T> > x, e, p;
+	std::vector< psa< interval<T> > > y;
+	std::vector< interval<T> > z;
+	std::vector<T> tol;
+	T radius, r, w, wmax;
+	T epsilon = std::numeric_limits<T>::epsilon();
+	bool flag, resized, error;
+	int restart;
+	int save_mode;
+	bool save_uh, save_rh;
+
+	m = 0;
+	for (i=0; i<nc; i++) m += j1[i] - j0[i] + 1;
+	result.assign(m, interval<T>(0.));
+	y.resize(m);
+	z.resize(m);
+	tol.resize(m);
+
+	save_mode = psa< interval<T> >::mode();
+	save_uh = psa< interval<T> >::use_history();
+	save_rh = psa< interval<T> >::record_history();
+	psa< interval<T> >::use_history() = false;
+	psa< interval<T> >::record_history() = false;
+
+	x.v.resize(2);
+	x.v(1) = 1.;
+	x = setorder(x, order-1);
+
+	t = start;
+	while (1) {
+		x.v(0) = t;
+		psa< interval<T> >::mode() = 1;
+		e = exp(-exp(x));
+		for (i=0, k=0; i<nc; i++) {
+			p = exp(c[i] * x) * e;
+			if (j0[i] > 0) p *= pow(x, j0[i]);
+			for (j=j0[i]; j<=j1[i]; j++, k++) {
+				y[k] = setorder(integrate(p), order);
+				if (j < j1[i]) p *= x;
+			}
+		}
+
+		radius = std::numeric_limits<T>::infinity();
+		for (k=0; k<m; k++) {
+			using std::max;
+			using std::min;
+			tol[k] = max((T)1., norm(result[k])) * epsilon;
+			radius = min(radius, defint_sub::autostep_radius(y[k], order, tol[k]));
+		}
+
+		psa< interval<T> >::mode() = 2;
+		resized = false;
+		restart = 0;
+		while (true) {
+			flag = defint_sub::autostep_next(t, end, radius, t1);
+
+			psa< interval<T> >::domain() = interval<T>::hull(0., t1 - t);
+			error = false;
+			try {
+				e = exp(-exp(x));
+				for (i=0, k=0; i<nc; i++) {
+					p = exp(c[i] * x) * e;
+					if (j0[i] > 0) p *= pow(x, j0[i]);
+					for (j=j0[i]; j<=j1[i]; j++, k++) {
+						z[k] = eval(integrate(p), t1 - t);
+						if (j < j1[i]) p *= x;
+					}
+				}
+			}
+			catch (std::domain_error& ex) {
+				error = true;
+			}
+
+			// the step may be much too large at first since the
+			// integrands are very small for v << 0
+			wmax = 0.;
+			kmax = 0;
+			for (k=0; k<m && !error; k++) {
+				w = rad(z[k]) / tol[k];
+				if (!(w < std::numeric_limits<T>::infinity())) error = true;
+				if (w > wmax) {
+					wmax = w;
+					kmax = k;
+				}
+			}
+			if (error) {
+				// shrink the step as defint_sub::autostep_restart
+				if (restart >= RESTART_MAX) {
+					psa< interval<T> >::mode() = save_mode;
+					psa< interval<T> >::use_history() = save_uh;
+					psa< interval<T> >::record_history() = save_rh;
+					throw std::domain_error("gamma: evaluation error");
+				}
+				radius *= 0.5;
+				restart++;
+				continue;
+			}
+
+			if (resized == true) break;
+
+			resized = true;
+			defint_sub::autostep_resize(radius, z[kmax], tol[kmax], order, restart);
+		}
+
+		for (k=0; k<m; k++) result[k] += z[k];
+		if (flag) break;
+		t = t1;
+	}
+
+	psa< interval<T> >::mode() = save_mode;
+	psa< interval<T> >::use_history() = save_uh;
+	psa< interval<T> >::record_history() = save_rh;
+}
+
+// the Taylor polynomial of gamma at the center of each piece and
+// the enclosure of its remainder.
+//   gamma(x) = a_0 + a_1 d + ... + a_(n-1) d^(n-1) + a_n d^n, d = x - c
+// where a_n encloses gamma^(n)(xi) / n! for xi in the piece.
+
+template <class T> class taylor_table {
+	int n;
+	std::vector< interval<T> > a;
+
+	// bound of the integral of |v|^j exp(x v - exp(v)) over
+	// (-inf, -l] and [r, inf) for 1 <= x <= 2
+	static interval<T> tail(int j, const interval<T>& l, const interval<T>& r) {
+		interval<T> s1, s2, t, a, f;
+		int i;
+
+		// (-inf, -l]: exp(x v) <= exp(v), exp(-exp(v)) <= 1
+		//   int_l^inf u^j exp(-u) du = exp(-l) sum_i j!/i! l^i
+		s1 = 0.;
+		t = 1.;
+		for (i=j; i>=0; i--) {
+			s1 += t;
+			t *= i;
+			if (i > 0) t /= l;
+		}
+		s1 *= exp(-l) * pow(l, j);
+
+		// [r, inf): exp(x v) <= exp(2 v),
+		//  exp(-exp(v)) <= exp(-exp(r) (1 + v - r))
+		//   exp(2r - exp(r)) sum_i C(j,i) r^(j-i) i! / a^(i+1),
+		//   a = exp(r) - 2
+		a = exp(r) - 2.;
+		s2 = 0.;
+		f = 1.;
+		for (i=0; i<=j; i++) {
+			// f = C(j,i) i! = j! / (j-i)!
+			s2 += f * pow(r, j - i) / pow(a, i + 1);
+			f *= j - i;
+		}
+		s2 *= exp(2. * r - exp(r));
+
+		return s1 + s2;
+	}
+
+	public:
+
+	taylor_table() {
+		int k = GAMMA_CACHE_PIECES;
+		int digits = std::numeric_limits<T>::digits;
+		int i, j;
+		interval<T> l, r, b, f, m0, m1;
+		std::vector< interval<T> > c, d;
+		std::vector<int> j0, j1;
+
+		// the pieces have the radius 1/(2k) and the Taylor
+		// coefficients are at most about 1 in magnitude. n must be
+		// even for the bound of the remainder below.
+		n = (int)std::ceil(digits * std::log(2.) / std::log(2. * k)) + 2;
+		if (n % 2 != 0) n++;
+
+		l = interval<T>(4. * digits * std::log(2.));
+		r = log(interval<T>(2. * digits * std::log(2.) + 50.));
+
+		// derivatives of order 0, ..., n-1 at the centers of the
+		// pieces, and of order n at the ends of the pieces
+		for (i=0; i<k; i++) {
+			c.push_back(1. + (interval<T>(i) + 0.5) / k);
+			j0.push_back(0);
+			j1.push_back(n - 1);
+		}
+		for (i=0; i<=k; i++) {
+			c.push_back(1. + interval<T>(i) / k);
+			j0.push_back(n);
+			j1.push_back(n);
+		}
+		moments(c, j0, j1, -l, r, GAMMA_ORDER, d);
+
+		a.resize(k * (n + 1));
+		for (i=0; i<k; i++) {
+			f = 1.;
+			for (j=0; j<n; j++) {
+				b = tail(j, l, r);
+				a[i * (n + 1) + j] = (d[i * n + j] + interval<T>(-b.upper(), b.upper())) / f;
+				f *= j + 1;
+			}
+		}
+
+		// gamma^(n) is positive and convex, so it is bounded on a
+		// piece by the larger of the values at the ends
+		b = tail(n, l, r);
+		for (i=0; i<k; i++) {
+			using std::max;
+			m0 = d[k * n + i] + b;
+			m1 = d[k * n + i + 1] + b;
+			a[i * (n + 1) + n] = interval<T>(0., max(m0.upper(), m1.upper())) / f;
+		}
+	}
+
+	static const taylor_table& get() {
+		static const taylor_table t;
+		return t;
+	}
+
+	// index of the piece containing x, -1 if none
+	int piece(const interval<T>& x) const {
+		int k = GAMMA_CACHE_PIECES;
+		int i;
+
+		if (!(x.lower() >= 1. && x.upper() <= 2.)) return -1;
+		i = (int)std::floor(((double)x.lower() - 1.) * k);
+		if (i > k - 1) i = k - 1;
+		if (i > 0 && x.lower() < (1. + interval<T>(i) / k).lower()) i--;
+		if (x.upper() > (1. + interval<T>(i + 1) / k).upper()) return -1;
+
+		return i;
+	}
+
+	// gamma(x)
+	bool eval(const interval<T>& x, interval<T>& g) const {
+		int i, j;
+		interval<T> d;
+
+		i = piece(x);
+		if (i < 0) return false;
+		d = x - (1. + (interval<T>(i) + 0.5) / GAMMA_CACHE_PIECES);
+
+		const interval<T>* p = &a[i * (n + 1)];
+		g = p[n];
+		for (j=n-1; j>=0; j--) g = g * d + p[j];
+
+		return true;
+	}
+
+	// gamma(x) and gamma'(x). the remainder of gamma' of degree
+	// n-2 is gamma^(n)(xi) / (n-1)! d^(n-1), enclosed by n a_n d^(n-1).
+	bool eval(const interval<T>& x, interval<T>& g, interval<T>& dg) const {
+		int i, j;
+		interval<T> d;
+
+		i = piece(x);
+		if (i < 0) return false;
+		d = x - (1. + (interval<T>(i) + 0.5) / GAMMA_CACHE_PIECES);
+
+		const interval<T>* p = &a[i * (n + 1)];
+		g = p[n];
+		dg = p[n] * n;
+		for (j=n-1; j>=1; j--) {
+			g = g * d + p[j];
+			dg = dg * d + p[j] * j;
+		}
+		g = g * d + p[0];
+
+		return true;
+	}
+};
+
+template <class T> bool cached() {
+	return GAMMA_CACHE && std::numeric_limits<T>::digits <= GAMMA_CACHE_DIGITS;
+}
+
+} // namespace gamma_sub
+
 // 1 \le x \le 2
 template <class T>
 interval<T> gamma_r(const interval<T>& x) {
 	interval<T> result;
 	interval<T> th(std::numeric_limits<T>::digits * std::log(2.));
 
+	#if GAMMA_CACHE
+	if (gamma_sub::cached<T>() && gamma_sub::taylor_table<T>::get().eval(x, result)) {
+		return result;
+	}
+	#endif
+
 	/*
 	result = defint_power(Gamma_nopower(), interval<T>(0.), interval<T>(GAMMA_TH1), GAMMA_ORDER, x - 1);
 
@@ -244,6 +569,12 @@ template <class TT> struct Digamma {
 template <class T> interval<T> digamma_plus(const interval<T>& x) {
 	interval<T> result, tmp;
 	interval<T> th(std::numeric_limits<T>::digits * std::log(2.));
+
+	#if GAMMA_CACHE
+	if (gamma_sub::cached<T>() && gamma_sub::taylor_table<T>::get().eval(x, result, tmp)) {
+		return tmp / result;
+	}
+	#endif
 	
 	/*
 	result = defint_singular(Digamma_0< interval<T> >(x), (interval<T>)0., (interval<T>)DIGAMMA_TH1, DIGAMMA_ORDER);
@@ -412,8 +743,14 @@ template <class T> interval<T> digamma_zero(T x) {
 		n = -(int)floor((double)x);
 	}
 
-	if (n <= DIGAMMA_ZERO_MAX && is_calculated[n] == true) {
-		return cache[n];
+	if (n <= DIGAMMA_ZERO_MAX) {
+		bool found = false;
+		#pragma omp critical (digamma_zero)
+		if (is_calculated[n] == true) {
+			found = true;
+			K = cache[n];
+		}
+		if (found) return K;
 	}
 
 	// set initial value
@@ -451,8 +788,11 @@ template <class T> interval<T> digamma_zero(T x) {
 	}
 
 	if (n <= DIGAMMA_ZERO_MAX) {
-		is_calculated[n] = true;
-		cache[n] = K;
+		#pragma omp critical (digamma_zero)
+		{
+			is_calculated[n] = true;
+			cache[n] = K;
+		}
 	}
 
 	return K;
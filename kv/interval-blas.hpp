@@ -0,0 +1,934 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef INTERVAL_BLAS_HPP
+#define INTERVAL_BLAS_HPP
+
+// interval vector/matrix products (dot, axpy, gemv, gemm) and
+// Cauchy product of coefficient sequences (conv, conv_tail, horner)
+// and of multivariate polynomials (mconv)
+//
+// Each call enters the rounding mode only once and works on contiguous
+// (inf[], sup[]) arrays. Lower endpoints are accumulated negated so that
+// only upward rounding is needed, which makes the kernel for double
+// vectorizable (SSE2/AVX/AVX-512, selected by the compiler flags).
+// Every element is summed in the same order as ub::prod, so results are
+// identical to those of ub::prod with interval operators.
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+
+#if defined(USE_LAPACK) || defined(USE_ATLAS)
+#include <kv/matrix-inversion.hpp>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// number of columns of the result processed at once by gemm
+
+#ifndef KV_IBLAS_BLOCK
+#define KV_IBLAS_BLOCK 256
+#endif
+
+// minimum number of multiplications of gemm to use multiple threads
+
+#ifndef KV_IBLAS_PARALLEL_MIN
+#define KV_IBLAS_PARALLEL_MIN 1000000
+#endif
+
+#if defined(__SSE2__) && !defined(KV_NOHWROUND)
+#define KV_IBLAS_SIMD
+#include <kv/hwround.hpp>
+#include <immintrin.h>
+#endif
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+namespace iblas_sub {
+
+// x is stored as (-inf, sup).
+// if point is true, the data is point data and nl == -u.
+
+template <class T> struct soa {
+	std::vector<T> nl, u;
+	bool point;
+};
+
+template <class T> void from_matrix(const ub::matrix< interval<T> >& a, soa<T>& r, bool transpose = false) {
+	int s1 = a.size1(), s2 = a.size2();
+	int i, j, k;
+	r.nl.resize(s1 * s2);
+	r.u.resize(s1 * s2);
+	r.point = false;
+	for (i=0; i<s1; i++) {
+		for (j=0; j<s2; j++) {
+			k = transpose ? j * s1 + i : i * s2 + j;
+			r.nl[k] = -a(i, j).lower();
+			r.u[k] = a(i, j).upper();
+		}
+	}
+}
+
+template <class T> void from_matrix(const ub::matrix<T>& a, soa<T>& r, bool transpose = false) {
+	int s1 = a.size1(), s2 = a.size2();
+	int i, j, k;
+	r.nl.resize(s1 * s2);
+	r.u.resize(s1 * s2);
+	r.point = true;
+	for (i=0; i<s1; i++) {
+		for (j=0; j<s2; j++) {
+			k = transpose ? j * s1 + i : i * s2 + j;
+			r.nl[k] = -a(i, j);
+			r.u[k] = a(i, j);
+		}
+	}
+}
+
+template <class T> void from_vector(const ub::vector< interval<T> >& a, soa<T>& r) {
+	int s = a.size();
+	int i;
+	r.nl.resize(s);
+	r.u.resize(s);
+	r.point = false;
+	for (i=0; i<s; i++) {
+		r.nl[i] = -a(i).lower();
+		r.u[i] = a(i).upper();
+	}
+}
+
+template <class T> void from_vector(const ub::vector<T>& a, soa<T>& r) {
+	int s = a.size();
+	int i;
+	r.nl.resize(s);
+	r.u.resize(s);
+	r.point = true;
+	for (i=0; i<s; i++) {
+		r.nl[i] = -a(i);
+		r.u[i] = a(i);
+	}
+}
+
+// avoid printing -0 for the lower endpoint of zero results
+template <class T> interval<T> to_interval(const T& nl, const T& u) {
+	T l = -nl;
+	if (l == 0.) l = T(0.);
+	return interval<T>(l, u);
+}
+
+// m = mid([-nl, u]), r = radius rounded upward.
+// must be called between rop<T>::begin() and rop<T>::end().
+template <class T> void midrad_up(const T& nl, const T& u, T& m, T& r) {
+	T tmp;
+	m = mid(interval<T>(-nl, u));
+	r = rop<T>::sub_up(u, m);
+	tmp = rop<T>::add_up(m, nl);
+	if (tmp > r) r = tmp;
+}
+
+template <class T> bool all_finite(const soa<T>& a) {
+	using std::abs;
+	int i;
+	int s = a.u.size();
+	for (i=0; i<s; i++) {
+		if (!(abs(a.nl[i]) < std::numeric_limits<T>::infinity())) return false;
+		if (!(abs(a.u[i]) < std::numeric_limits<T>::infinity())) return false;
+	}
+	return true;
+}
+
+// [rl, ru] = [xl, xu] * [yl, yu]
+// same case analysis as interval<T>::operator*.
+// must be called between rop<T>::begin() and rop<T>::end().
+
+template <class T> void mul(const T& xl, const T& xu, const T& yl, const T& yu, T& rl, T& ru) {
+	T tl, tu;
+
+	if (xl >= 0.) {
+		if (xu == 0.) {
+			rl = 0.; ru = 0.;
+		} else {
+			if (yl >= 0.) {
+				if (yu == 0.) {
+					rl = 0.; ru = 0.;
+				} else {
+					rop_pair<T>::mul(xl, yl, xu, yu, rl, ru);
+				}
+			} else if (yu <= 0.) {
+				rop_pair<T>::mul(xu, yl, xl, yu, rl, ru);
+			} else {
+				rop_pair<T>::mul(xu, yl, xu, yu, rl, ru);
+			}
+		}
+	} else if (xu <= 0.) {
+		if (yl >= 0.) {
+			if (yu == 0.) {
+				rl = 0.; ru = 0.;
+			} else {
+				rop_pair<T>::mul(xl, yu, xu, yl, rl, ru);
+			}
+		} else if (yu <= 0.) {
+			rop_pair<T>::mul(xu, yu, xl, yl, rl, ru);
+		} else {
+			rop_pair<T>::mul(xl, yu, xl, yl, rl, ru);
+		}
+	} else {
+		if (yl >= 0.) {
+			if (yu == 0.) {
+				rl = 0.; ru = 0.;
+			} else {
+				rop_pair<T>::mul(xl, yu, xu, yu, rl, ru);
+			}
+		} else if (yu <= 0.) {
+			rop_pair<T>::mul(xu, yl, xl, yl, rl, ru);
+		} else {
+			rop_pair<T>::mul(xl, yu, xl, yl, rl, ru);
+			rop_pair<T>::mul(xu, yl, xu, yu, tl, tu);
+			if (tl < rl) rl = tl;
+			if (tu > ru) ru = tu;
+		}
+	}
+}
+
+// [rl, ru] = x * [yl, yu] for point x
+// same case analysis as interval<T>::operator*(const C&, const interval&).
+
+template <class T> void mul_point(const T& x, const T& yl, const T& yu, T& rl, T& ru) {
+	if (x > 0.) {
+		rop_pair<T>::mul(x, yl, x, yu, rl, ru);
+	} else if (x < 0.) {
+		rop_pair<T>::mul(x, yu, x, yl, rl, ru);
+	} else {
+		rl = 0.; ru = 0.;
+	}
+}
+
+// c(j) += a * b(j), j = 0, ..., n-1.
+// a, b and c are stored as (-inf, sup).
+
+template <class T> struct kernel {
+	static void begin() {
+		rop<T>::begin();
+	}
+
+	static void end() {
+		rop<T>::end();
+	}
+
+	static void axpy(int n, const T& anl, const T& au, bool apoint, const T* bnl, const T* bu, bool bpoint, T* cnl, T* cu, bool) {
+		int j;
+		T rl, ru;
+
+		for (j=0; j<n; j++) {
+			if (apoint) {
+				mul_point(au, -bnl[j], bu[j], rl, ru);
+			} else if (bpoint) {
+				mul_point(bu[j], -anl, au, rl, ru);
+			} else {
+				mul(-anl, au, -bnl[j], bu[j], rl, ru);
+			}
+			cnl[j] = rop<T>::add_up(cnl[j], -rl);
+			cu[j] = rop<T>::add_up(cu[j], ru);
+		}
+	}
+};
+
+#ifdef KV_IBLAS_SIMD
+
+// packed double operations. the kernel below relies on upward rounding
+// of MXCSR, so the rounding mode is set by hwround even if the backend
+// rounds by other means.
+
+struct simd {
+#if defined(__AVX512F__)
+	typedef __m512d vec;
+	static const int width = 8;
+	static vec load(const double* p) { return _mm512_loadu_pd(p); }
+	static void store(double* p, vec x) { _mm512_storeu_pd(p, x); }
+	static vec set1(double x) { return _mm512_set1_pd(x); }
+	static vec add(vec x, vec y) { return _mm512_add_pd(x, y); }
+	static vec mul(vec x, vec y) { return _mm512_mul_pd(x, y); }
+	static vec max(vec x, vec y) { return _mm512_max_pd(x, y); }
+#elif defined(__AVX__)
+	typedef __m256d vec;
+	static const int width = 4;
+	static vec load(const double* p) { return _mm256_loadu_pd(p); }
+	static void store(double* p, vec x) { _mm256_storeu_pd(p, x); }
+	static vec set1(double x) { return _mm256_set1_pd(x); }
+	static vec add(vec x, vec y) { return _mm256_add_pd(x, y); }
+	static vec mul(vec x, vec y) { return _mm256_mul_pd(x, y); }
+	static vec max(vec x, vec y) { return _mm256_max_pd(x, y); }
+#else
+	typedef __m128d vec;
+	static const int width = 2;
+	static vec load(const double* p) { return _mm_loadu_pd(p); }
+	static void store(double* p, vec x) { _mm_storeu_pd(p, x); }
+	static vec set1(double x) { return _mm_set1_pd(x); }
+	static vec add(vec x, vec y) { return _mm_add_pd(x, y); }
+	static vec mul(vec x, vec y) { return _mm_mul_pd(x, y); }
+	static vec max(vec x, vec y) { return _mm_max_pd(x, y); }
+#endif
+};
+
+template <> struct kernel<double> {
+	static void begin() {
+		#if defined(KV_USE_AVX512)
+		hwround::roundup();
+		#else
+		rop<double>::begin();
+		#endif
+	}
+
+	static void end() {
+		#if defined(KV_USE_AVX512)
+		hwround::roundnear();
+		#else
+		rop<double>::end();
+		#endif
+	}
+
+	// upper endpoint of a product is the maximum of the endpoint products
+	// rounded upward, and the negated lower endpoint is the maximum of
+	// (-x) * y rounded upward. with finite inputs this gives the same
+	// result as the case analysis of interval<double>::operator*.
+	// simd must be false if the inputs may contain non-finite numbers.
+
+	static void axpy(int n, const double& anl, const double& au, bool apoint, const double* bnl, const double* bu, bool bpoint, double* cnl, double* cu, bool use_simd) {
+		int j = 0;
+
+		if (use_simd) {
+			simd::vec va_nl = simd::set1(anl), va_u = simd::set1(au);
+			simd::vec va_l = simd::set1(-anl), va_nu = simd::set1(-au);
+			simd::vec vb_nl, vb_u, vb_l, r_nl, r_u;
+
+			for (j=0; j + simd::width <= n; j += simd::width) {
+				vb_u = simd::load(bu + j);
+				if (apoint) {
+					vb_nl = simd::load(bnl + j);
+					r_u = simd::max(simd::mul(va_u, vb_u), simd::mul(va_nu, vb_nl));
+					r_nl = simd::max(simd::mul(va_nu, vb_u), simd::mul(va_u, vb_nl));
+				} else if (bpoint) {
+					r_u = simd::max(simd::mul(va_u, vb_u), simd::mul(va_l, vb_u));
+					r_nl = simd::max(simd::mul(va_nl, vb_u), simd::mul(va_nu, vb_u));
+				} else {
+					vb_nl = simd::load(bnl + j);
+					vb_l = simd::mul(vb_nl, simd::set1(-1.));
+					r_u = simd::max(
+						simd::max(simd::mul(va_l, vb_l), simd::mul(va_l, vb_u)),
+						simd::max(simd::mul(va_u, vb_l), simd::mul(va_u, vb_u)));
+					r_nl = simd::max(
+						simd::max(simd::mul(va_nl, vb_l), simd::mul(va_nl, vb_u)),
+						simd::max(simd::mul(va_nu, vb_l), simd::mul(va_nu, vb_u)));
+				}
+				simd::store(cnl + j, simd::add(simd::load(cnl + j), r_nl));
+				simd::store(cu + j, simd::add(simd::load(cu + j), r_u));
+			}
+		}
+
+		if (j < n) {
+			kernel<double>::axpy_scalar(n - j, anl, au, apoint, bnl + j, bu + j, bpoint, cnl + j, cu + j);
+		}
+	}
+
+	static void axpy_scalar(int n, const double& anl, const double& au, bool apoint, const double* bnl, const double* bu, bool bpoint, double* cnl, double* cu) {
+		int j;
+		double rl, ru;
+
+		for (j=0; j<n; j++) {
+			if (apoint) {
+				mul_point(au, -bnl[j], bu[j], rl, ru);
+			} else if (bpoint) {
+				mul_point(bu[j], -anl, au, rl, ru);
+			} else {
+				mul(-anl, au, -bnl[j], bu[j], rl, ru);
+			}
+			cnl[j] = rop<double>::add_up(cnl[j], -rl);
+			cu[j] = rop<double>::add_up(cu[j], ru);
+		}
+	}
+};
+
+inline bool simd_usable(const soa<double>& a, const soa<double>& b) {
+	return all_finite(a) && all_finite(b);
+}
+
+#endif // KV_IBLAS_SIMD
+
+template <class T> bool simd_usable(const soa<T>&, const soa<T>&) {
+	return false;
+}
+
+// work area for conv: w = (anl, au, bnl, bu) of length n each,
+// c = (cnl, cu) of length n each.
+
+template <class T, class V> void load_conv(int n, const V& a, const V& b, T* w) {
+	int i;
+	for (i=0; i<n; i++) {
+		w[i] = -a(i).lower();
+		w[n + i] = a(i).upper();
+		w[2 * n + i] = -b(i).lower();
+		w[3 * n + i] = b(i).upper();
+	}
+}
+
+template <class T, class V> void store_conv(int n, int from, const T* c, V& r) {
+	int i;
+	for (i=from; i<n; i++) r(i) = to_interval(c[i], c[n + i]);
+}
+
+template <class T> bool all_finite(const T* p, int n) {
+	using std::abs;
+	int i;
+	for (i=0; i<n; i++) {
+		if (!(abs(p[i]) < std::numeric_limits<T>::infinity())) return false;
+	}
+	return true;
+}
+
+template <class T> bool simd_usable(const T*, int) {
+	return false;
+}
+
+#ifdef KV_IBLAS_SIMD
+inline bool simd_usable(const double* p, int n) {
+	return all_finite(p, n);
+}
+#endif
+
+// c(i) = sum_{j=0}^{i} a(j) b(i-j), i = from, ..., n-1
+
+template <class T> inline void conv_soa(int n, int from, const T* w, T* c) {
+	int i, j, i0;
+	bool use_simd = simd_usable(w, 4 * n);
+
+	for (i=0; i<2*n; i++) c[i] = T(0.);
+
+	kernel<T>::begin();
+	for (j=0; j<n; j++) {
+		i0 = std::max(j, from);
+		kernel<T>::axpy(n - i0, w[j], w[n + j], false, w + 2 * n + i0 - j, w + 3 * n + i0 - j, false, c + i0, c + n + i0, use_simd);
+	}
+	kernel<T>::end();
+}
+
+// c(i) = sum_{j=i}^{n-1} a(j) b(i-j+n-1), i = 1, ..., n-1
+
+template <class T> inline void conv_tail_soa(int n, const T* w, T* c) {
+	int i, j;
+	bool use_simd = simd_usable(w, 4 * n);
+
+	for (i=0; i<2*n; i++) c[i] = T(0.);
+
+	kernel<T>::begin();
+	for (j=1; j<n; j++) {
+		kernel<T>::axpy(j, w[j], w[n + j], false, w + 3 * n - j, w + 4 * n - j, false, c + 1, c + n + 1, use_simd);
+	}
+	kernel<T>::end();
+}
+
+// conv and conv_tail for compile-time size N.
+// the work area is on the stack and the loops have constant trip counts.
+
+template <class T, int N> struct conv_fixed {
+	template <class V> static void conv(const V& a, const V& b, V& r, int from) {
+		T w[4 * N], c[2 * N];
+		load_conv(N, a, b, w);
+		conv_soa(N, from, w, c);
+		store_conv(N, from, c, r);
+	}
+
+	template <class V> static void conv_tail(const V& a, const V& b, V& r) {
+		T w[4 * N], c[2 * N];
+		load_conv(N, a, b, w);
+		conv_tail_soa(N, w, c);
+		store_conv(N, 1, c, r);
+	}
+};
+
+// number of monomials of d variables with total degree < k,
+// i.e. binomial(k+d-1, d). mono_size(d, n) = binomial(n+d, d) is the
+// number of coefficients of a polynomial of total degree <= n.
+
+inline int mono_offset(int d, int k) {
+	int i, r = 1;
+	for (i=1; i<=d; i++) r = r * (k - 1 + i) / i;
+	return r;
+}
+
+inline int mono_size(int d, int n) {
+	return mono_offset(d, n + 1);
+}
+
+// c += a * b for polynomials of d variables of total degree <= da, db
+// (c: <= da+db) stored in graded lexicographic order. the block of
+// degree k starts at mono_offset(d, k) and is itself a polynomial of the
+// remaining d-1 variables of total degree <= k in the same order, so the
+// product of two blocks is a product of d-1 variables. for d = 1 it is
+// an axpy for each coefficient of a.
+// must be called between kernel<T>::begin() and kernel<T>::end().
+
+template <class T> void mconv_soa(int d, int da, int db, const T* anl, const T* au, const T* bnl, const T* bu, T* cnl, T* cu, bool use_simd) {
+	int p, q, op, oq, oc;
+
+	if (d == 1) {
+		for (p=0; p<=da; p++) {
+			kernel<T>::axpy(db + 1, anl[p], au[p], false, bnl, bu, false, cnl + p, cu + p, use_simd);
+		}
+		return;
+	}
+
+	for (p=0; p<=da; p++) {
+		op = mono_offset(d, p);
+		for (q=0; q<=db; q++) {
+			oq = mono_offset(d, q);
+			oc = mono_offset(d, p + q);
+			mconv_soa(d - 1, p, q, anl + op, au + op, bnl + oq, bu + oq, cnl + oc, cu + oc, use_simd);
+		}
+	}
+}
+
+// C (n x m) = A (n x k) * B (k x m), all stored row-major as (-inf, sup).
+// the columns of C are processed in blocks of KV_IBLAS_BLOCK so that the
+// block of B stays in cache. with OpenMP, the pairs of (column block,
+// row) are distributed to threads if the product has at least
+// KV_IBLAS_PARALLEL_MIN multiplications. each element is computed by one
+// thread in the same order, so the result does not depend on the number
+// of threads.
+
+template <class T> void gemm_soa(int n, int k, int m, const soa<T>& a, const soa<T>& b, std::vector<T>& cnl, std::vector<T>& cu) {
+	int i, p, jb, l, nb, w;
+	bool use_simd = simd_usable(a, b);
+
+	cnl.assign(n * m, T(0.));
+	cu.assign(n * m, T(0.));
+	if (n == 0 || k == 0 || m == 0) return;
+
+	nb = (m + KV_IBLAS_BLOCK - 1) / KV_IBLAS_BLOCK;
+
+#ifdef _OPENMP
+	bool par = (double)n * k * m >= KV_IBLAS_PARALLEL_MIN && n * nb > 1 && !omp_in_parallel();
+#endif
+
+	#pragma omp parallel if (par) private(i, p, jb, l, w)
+	{
+	kernel<T>::begin();
+	#pragma omp for schedule(static)
+	for (l=0; l<nb*n; l++) {
+		jb = (l / n) * KV_IBLAS_BLOCK;
+		i = l % n;
+		w = std::min(KV_IBLAS_BLOCK, m - jb);
+		for (p=0; p<k; p++) {
+			kernel<T>::axpy(w, a.nl[i * k + p], a.u[i * k + p], a.point, &b.nl[p * m + jb], &b.u[p * m + jb], b.point, &cnl[i * m + jb], &cu[i * m + jb], use_simd);
+		}
+	}
+	kernel<T>::end();
+	}
+}
+
+// point matrix product rounded upward.
+// c (n x m) = a (n x k) * b (k x m), all row-major.
+// must be called between kernel<T>::begin() and kernel<T>::end().
+// the product rounded downward is obtained as -((-a) * b).
+
+template <class T> struct point_gemm {
+	static void up(int n, int k, int m, const T* a, const T* b, T* c) {
+		int i, j, p;
+		for (i=0; i<n*m; i++) c[i] = 0.;
+		for (i=0; i<n; i++) {
+			for (p=0; p<k; p++) {
+				for (j=0; j<m; j++) {
+					c[i * m + j] = rop<T>::add_up(c[i * m + j], rop<T>::mul_up(a[i * k + p], b[p * m + j]));
+				}
+			}
+		}
+	}
+};
+
+#ifdef KV_IBLAS_SIMD
+
+// uses the BLAS through mm_mult if USE_LAPACK or USE_ATLAS is defined.
+// the BLAS must respect the rounding mode of the calling thread.
+// otherwise uses a blocked loop in the current (upward) rounding mode.
+
+template <> struct point_gemm<double> {
+	static void up(int n, int k, int m, const double* a, const double* b, double* c) {
+		#if defined(USE_LAPACK) || defined(USE_ATLAS)
+		int i, j;
+		ub::matrix<double> ma(n, k), mb(k, m), mc;
+		for (i=0; i<n; i++) for (j=0; j<k; j++) ma(i, j) = a[i * k + j];
+		for (i=0; i<k; i++) for (j=0; j<m; j++) mb(i, j) = b[i * m + j];
+		mm_mult(ma, mb, mc);
+		for (i=0; i<n; i++) for (j=0; j<m; j++) c[i * m + j] = mc(i, j);
+		#else
+		const int bk = 128, bm = 256;
+		int i, j, p, p0, j0, p1, j1;
+		double aip;
+		double *ci;
+		const double *bp;
+
+		for (i=0; i<n*m; i++) c[i] = 0.;
+		for (j0=0; j0<m; j0+=bm) {
+			j1 = std::min(j0 + bm, m);
+			for (p0=0; p0<k; p0+=bk) {
+				p1 = std::min(p0 + bk, k);
+				for (i=0; i<n; i++) {
+					ci = c + i * m;
+					for (p=p0; p<p1; p++) {
+						aip = a[i * k + p];
+						bp = b + p * m;
+						for (j=j0; j<j1; j++) ci[j] += aip * bp[j];
+					}
+				}
+			}
+		}
+		#endif
+	}
+};
+
+#endif // KV_IBLAS_SIMD
+
+} // namespace iblas_sub
+
+
+namespace iblas {
+
+// x^T y
+
+template <class T> interval<T> dot(const ub::vector< interval<T> >& x, const ub::vector< interval<T> >& y) {
+	int i;
+	int s = x.size();
+	T sl(0.), su(0.), rl, ru;
+
+	rop<T>::begin();
+	for (i=0; i<s; i++) {
+		iblas_sub::mul(x(i).lower(), x(i).upper(), y(i).lower(), y(i).upper(), rl, ru);
+		rop_pair<T>::add(sl, rl, su, ru, sl, su);
+	}
+	rop<T>::end();
+
+	return iblas_sub::to_interval(T(-sl), su);
+}
+
+// y += a * x
+
+template <class T> void axpy(const interval<T>& a, const ub::vector< interval<T> >& x, ub::vector< interval<T> >& y) {
+	int i;
+	int s = x.size();
+	iblas_sub::soa<T> xs, ys, as;
+
+	if (s == 0) return;
+
+	iblas_sub::from_vector(x, xs);
+	iblas_sub::from_vector(y, ys);
+	as.nl.assign(1, -a.lower());
+	as.u.assign(1, a.upper());
+	as.point = false;
+
+	bool use_simd = iblas_sub::simd_usable(as, xs) && iblas_sub::all_finite(ys);
+
+	iblas_sub::kernel<T>::begin();
+	iblas_sub::kernel<T>::axpy(s, as.nl[0], as.u[0], false, &xs.nl[0], &xs.u[0], false, &ys.nl[0], &ys.u[0], use_simd);
+	iblas_sub::kernel<T>::end();
+
+	for (i=0; i<s; i++) y(i) = iblas_sub::to_interval(ys.nl[i], ys.u[i]);
+}
+
+// Cauchy product of power series coefficients.
+// r(i) = sum_{j=0}^{i} a(j) b(i-j) for i = from, ..., n-1 (n = r.size()).
+// a and b must have at least n elements. r(i) for i < from is not changed.
+// computed as axpy's for j = 0, ..., n-1, so every r(i) is summed in
+// ascending order of j.
+
+template <class V> void conv(const V& a, const V& b, V& r, int from = 0) {
+	typedef typename V::value_type::base_type T;
+	int n = r.size();
+
+	if (from >= n) return;
+
+	// sizes used by the ODE solvers with order 12, 16, 20, 24, 30
+	switch (n) {
+		case 13: iblas_sub::conv_fixed<T, 13>::conv(a, b, r, from); return;
+		case 17: iblas_sub::conv_fixed<T, 17>::conv(a, b, r, from); return;
+		case 21: iblas_sub::conv_fixed<T, 21>::conv(a, b, r, from); return;
+		case 25: iblas_sub::conv_fixed<T, 25>::conv(a, b, r, from); return;
+		case 31: iblas_sub::conv_fixed<T, 31>::conv(a, b, r, from); return;
+	}
+
+	std::vector<T> w(6 * n);
+	iblas_sub::load_conv(n, a, b, &w[0]);
+	iblas_sub::conv_soa(n, from, &w[0], &w[4 * n]);
+	iblas_sub::store_conv(n, from, &w[4 * n], r);
+}
+
+// higher part of the Cauchy product.
+// r(i) = sum_{j=i}^{n-1} a(j) b(i-j+n-1) for i = 1, ..., n-1
+// (n = a.size()), i.e. the coefficient of degree i+n-1. r(0) is not changed.
+
+template <class V> void conv_tail(const V& a, const V& b, V& r) {
+	typedef typename V::value_type::base_type T;
+	int n = a.size();
+
+	if (n <= 1) return;
+
+	switch (n) {
+		case 13: iblas_sub::conv_fixed<T, 13>::conv_tail(a, b, r); return;
+		case 17: iblas_sub::conv_fixed<T, 17>::conv_tail(a, b, r); return;
+		case 21: iblas_sub::conv_fixed<T, 21>::conv_tail(a, b, r); return;
+		case 25: iblas_sub::conv_fixed<T, 25>::conv_tail(a, b, r); return;
+		case 31: iblas_sub::conv_fixed<T, 31>::conv_tail(a, b, r); return;
+	}
+
+	std::vector<T> w(6 * n);
+	iblas_sub::load_conv(n, a, b, &w[0]);
+	iblas_sub::conv_tail_soa(n, &w[0], &w[4 * n]);
+	iblas_sub::store_conv(n, 1, &w[4 * n], r);
+}
+
+// product of multivariate polynomials (see iblas_sub::mconv_soa).
+// a and b are polynomials of d variables of total degree <= da and db
+// in graded lexicographic order. r is resized to the full product of
+// degree <= da+db.
+
+template <class V> void mconv(int d, const V& a, int da, const V& b, int db, V& r) {
+	typedef typename V::value_type::base_type T;
+	int i;
+	int na = iblas_sub::mono_size(d, da);
+	int nb = iblas_sub::mono_size(d, db);
+	int nr = iblas_sub::mono_size(d, da + db);
+
+	std::vector<T> w(2 * na + 2 * nb), c(2 * nr, T(0.));
+	for (i=0; i<na; i++) {
+		w[i] = -a(i).lower();
+		w[na + i] = a(i).upper();
+	}
+	for (i=0; i<nb; i++) {
+		w[2 * na + i] = -b(i).lower();
+		w[2 * na + nb + i] = b(i).upper();
+	}
+	bool use_simd = iblas_sub::simd_usable(&w[0], 2 * na + 2 * nb);
+
+	iblas_sub::kernel<T>::begin();
+	iblas_sub::mconv_soa(d, da, db, &w[0], &w[na], &w[2 * na], &w[2 * na + nb], &c[0], &c[nr], use_simd);
+	iblas_sub::kernel<T>::end();
+
+	r.resize(nr);
+	for (i=0; i<nr; i++) r(i) = iblas_sub::to_interval(c[i], c[nr + i]);
+}
+
+// p(x) + p(x+1) d + ... + p(y) d^(y-x) by Horner's method
+// in one rounding scope. same result as with interval operators.
+
+template <class V, class T> interval<T> horner(const V& p, int x, int y, const interval<T>& d) {
+	int i;
+	T rl, ru, tl, tu;
+
+	rl = p(y).lower();
+	ru = p(y).upper();
+	rop<T>::begin();
+	for (i=y-1; i>=x; i--) {
+		iblas_sub::mul(rl, ru, d.lower(), d.upper(), tl, tu);
+		rop_pair<T>::add(tl, p(i).lower(), tu, p(i).upper(), rl, ru);
+	}
+	rop<T>::end();
+
+	return interval<T>(rl, ru);
+}
+
+// y = A x. A is interval or point matrix.
+
+template <class M, class T> ub::vector< interval<T> > gemv_impl(const M& a, const ub::vector< interval<T> >& x) {
+	int n = a.size1();
+	int k = a.size2();
+	int i;
+	iblas_sub::soa<T> as, xs;
+	std::vector<T> cnl, cu;
+	ub::vector< interval<T> > r(n);
+
+	// y = sum_p x(p) * A(:,p) as a 1 x k times k x n product with A^T
+	iblas_sub::from_matrix(a, as, true);
+	iblas_sub::from_vector(x, xs);
+	iblas_sub::gemm_soa(1, k, n, xs, as, cnl, cu);
+
+	for (i=0; i<n; i++) r(i) = iblas_sub::to_interval(cnl[i], cu[i]);
+
+	return r;
+}
+
+template <class T> ub::vector< interval<T> > gemv(const ub::matrix< interval<T> >& a, const ub::vector< interval<T> >& x) {
+	return gemv_impl(a, x);
+}
+
+template <class T> ub::vector< interval<T> > gemv(const ub::matrix<T>& a, const ub::vector< interval<T> >& x) {
+	return gemv_impl(a, x);
+}
+
+// C = A B by interval arithmetic for each element.
+
+template <class M1, class M2, class T> ub::matrix< interval<T> > gemm_impl(const M1& a, const M2& b, const T&) {
+	int n = a.size1();
+	int k = a.size2();
+	int m = b.size2();
+	int i, j;
+	iblas_sub::soa<T> as, bs;
+	std::vector<T> cnl, cu;
+	ub::matrix< interval<T> > r(n, m);
+
+	iblas_sub::from_matrix(a, as);
+	iblas_sub::from_matrix(b, bs);
+	iblas_sub::gemm_soa(n, k, m, as, bs, cnl, cu);
+
+	for (i=0; i<n; i++) {
+		for (j=0; j<m; j++) {
+			r(i, j) = iblas_sub::to_interval(cnl[i * m + j], cu[i * m + j]);
+		}
+	}
+
+	return r;
+}
+
+// C = A B by midpoint-radius arithmetic (S. M. Rump, BIT 39 (1999)).
+// the product is computed by three or four point matrix products rounded
+// upward, so it can use an optimized BLAS, but the result may be wider
+// than gemm (at most by a factor 1.5 in radius).
+// falls back to gemm if the operands contain non-finite numbers.
+
+template <class M1, class M2, class T> ub::matrix< interval<T> > gemm_midrad_impl(const M1& a, const M2& b, const T&) {
+	using std::abs;
+	int n = a.size1();
+	int k = a.size2();
+	int m = b.size2();
+	int i, j;
+	iblas_sub::soa<T> as, bs;
+	bool ap, bp;
+	ub::matrix< interval<T> > r(n, m);
+
+	iblas_sub::from_matrix(a, as);
+	iblas_sub::from_matrix(b, bs);
+	if (n == 0 || k == 0 || m == 0 || !iblas_sub::all_finite(as) || !iblas_sub::all_finite(bs)) {
+		return gemm_impl(a, b, T());
+	}
+	ap = as.point;
+	bp = bs.point;
+
+	std::vector<T> ma(n * k), na(n * k), ra, mb(k * m), rb;
+	std::vector<T> cs(n * m), cn(n * m), cr;
+	std::vector<T> a2, b2;
+
+	rop_scope< T, iblas_sub::kernel<T> > scope;
+
+	// midpoint and radius (rounded upward) of the operands
+	if (!ap) ra.resize(n * k);
+	for (i=0; i<n*k; i++) {
+		if (ap) {
+			ma[i] = as.u[i];
+		} else {
+			iblas_sub::midrad_up(as.nl[i], as.u[i], ma[i], ra[i]);
+		}
+		na[i] = -ma[i];
+	}
+	if (!bp) rb.resize(k * m);
+	for (i=0; i<k*m; i++) {
+		if (bp) {
+			mb[i] = bs.u[i];
+		} else {
+			iblas_sub::midrad_up(bs.nl[i], bs.u[i], mb[i], rb[i]);
+		}
+	}
+
+	// cs = up(ma mb), cn = up((-ma) mb) = -down(ma mb)
+	iblas_sub::point_gemm<T>::up(n, k, m, &ma[0], &mb[0], &cs[0]);
+	iblas_sub::point_gemm<T>::up(n, k, m, &na[0], &mb[0], &cn[0]);
+
+	// cr = up(|ma| rb + ra (|mb| + rb))
+	if (!ap || !bp) {
+		cr.resize(n * m);
+		if (ap) {
+			for (i=0; i<n*k; i++) na[i] = abs(ma[i]);
+			iblas_sub::point_gemm<T>::up(n, k, m, &na[0], &rb[0], &cr[0]);
+		} else if (bp) {
+			for (i=0; i<k*m; i++) mb[i] = abs(mb[i]);
+			iblas_sub::point_gemm<T>::up(n, k, m, &ra[0], &mb[0], &cr[0]);
+		} else {
+			a2.resize(n * 2 * k);
+			b2.resize(2 * k * m);
+			for (i=0; i<n; i++) {
+				for (j=0; j<k; j++) {
+					a2[i * 2 * k + j] = abs(ma[i * k + j]);
+					a2[i * 2 * k + k + j] = ra[i * k + j];
+				}
+			}
+			for (i=0; i<k*m; i++) {
+				b2[i] = rb[i];
+				b2[k * m + i] = rop<T>::add_up(abs(mb[i]), rb[i]);
+			}
+			iblas_sub::point_gemm<T>::up(n, 2 * k, m, &a2[0], &b2[0], &cr[0]);
+		}
+	}
+
+	// mc = up(c1 + (c2 - c1) / 2), rc = up(mc - c1) + cr
+	// where c1 = -cn and c2 = cs
+	T mc, rc;
+	for (i=0; i<n; i++) {
+		for (j=0; j<m; j++) {
+			const T& c1n = cn[i * m + j];
+			mc = rop<T>::add_up(-c1n, rop<T>::mul_up(rop<T>::add_up(cs[i * m + j], c1n), T(0.5)));
+			rc = rop<T>::add_up(mc, c1n);
+			if (!cr.empty()) rc = rop<T>::add_up(rc, cr[i * m + j]);
+			r(i, j) = iblas_sub::to_interval(rop<T>::add_up(rc, -mc), rop<T>::add_up(mc, rc));
+		}
+	}
+
+	return r;
+}
+
+template <class T> ub::matrix< interval<T> > gemm_midrad(const ub::matrix< interval<T> >& a, const ub::matrix< interval<T> >& b) {
+	return gemm_midrad_impl(a, b, T());
+}
+
+template <class T> ub::matrix< interval<T> > gemm_midrad(const ub::matrix<T>& a, const ub::matrix< interval<T> >& b) {
+	return gemm_midrad_impl(a, b, T());
+}
+
+template <class T> ub::matrix< interval<T> > gemm_midrad(const ub::matrix< interval<T> >& a, const ub::matrix<T>& b) {
+	return gemm_midrad_impl(a, b, T());
+}
+
+// C = A B. at least one of A and B is an interval matrix.
+// if KV_IBLAS_MIDRAD is defined, gemm uses midpoint-radius arithmetic.
+
+#ifdef KV_IBLAS_MIDRAD
+#define KV_IBLAS_GEMM gemm_midrad_impl
+#else
+#define KV_IBLAS_GEMM gemm_impl
+#endif
+
+template <class T> ub::matrix< interval<T> > gemm(const ub::matrix< interval<T> >& a, const ub::matrix< interval<T> >& b) {
+	return KV_IBLAS_GEMM(a, b, T());
+}
+
+template <class T> ub::matrix< interval<T> > gemm(const ub::matrix<T>& a, const ub::matrix< interval<T> >& b) {
+	return KV_IBLAS_GEMM(a, b, T());
+}
+
+template <class T> ub::matrix< interval<T> > gemm(const ub::matrix< interval<T> >& a, const ub::matrix<T>& b) {
+	return KV_IBLAS_GEMM(a, b, T());
+}
+
+#undef KV_IBLAS_GEMM
+
+} // namespace iblas
+
+} // namespace kv
+
+#endif // INTERVAL_BLAS_HPP
@@ -90,6 +90,60 @@ template <class T> struct rop {
 };
 
 
+// compute lower endpoint (rounded down) and upper endpoint (rounded up)
+// at once. rounding backends may specialize this to use packed
+// instructions. must be called between rop<T>::begin() and rop<T>::end().
+
+template <class T> struct rop_pair {
+
+	static void add(const T& x1, const T& y1, const T& x2, const T& y2, T& rl, T& ru) {
+		rl = rop<T>::add_down(x1, y1);
+		ru = rop<T>::add_up(x2, y2);
+	}
+
+	static void sub(const T& x1, const T& y1, const T& x2, const T& y2, T& rl, T& ru) {
+		rl = rop<T>::sub_down(x1, y1);
+		ru = rop<T>::sub_up(x2, y2);
+	}
+
+	static void mul(const T& x1, const T& y1, const T& x2, const T& y2, T& rl, T& ru) {
+		rl = rop<T>::mul_down(x1, y1);
+		ru = rop<T>::mul_up(x2, y2);
+	}
+
+	static void div(const T& x1, const T& y1, const T& x2, const T& y2, T& rl, T& ru) {
+		rl = rop<T>::div_down(x1, y1);
+		ru = rop<T>::div_up(x2, y2);
+	}
+
+	static void sqrt(const T& x1, const T& x2, T& rl, T& ru) {
+		rl = rop<T>::sqrt_down(x1);
+		ru = rop<T>::sqrt_up(x2);
+	}
+};
+
+
+// calls R::begin() at construction and R::end() at destruction, so that
+// the rounding mode is restored also when an exception is thrown.
+// use this instead of the bare begin()/end() pair for the regions which
+// may throw (e.g. allocate memory).
+
+template <class T, class R = rop<T> > class rop_scope {
+	rop_scope(const rop_scope&);
+	rop_scope& operator=(const rop_scope&);
+
+	public:
+
+	rop_scope() {
+		R::begin();
+	}
+
+	~rop_scope() {
+		R::end();
+	}
+};
+
+
 template <class T> class interval;
 template <class C, class T> struct convertible<C, interval<T> > {
 	static const bool value = convertible<C, T>::value || boost::is_same<C, interval<T> >::value || boost::is_convertible<C, std::string>::value;
@@ -151,8 +205,7 @@ template <class T> class interval {
 		interval r;
 
 		rop<T>::begin();
-		r.inf = rop<T>::add_down(x.inf, y.inf);
-		r.sup = rop<T>::add_up(x.sup, y.sup);
+		rop_pair<T>::add(x.inf, y.inf, x.sup, y.sup, r.inf, r.sup);
 		rop<T>::end();
 
 		return r;
@@ -162,8 +215,7 @@ template <class T> class interval {
 		interval r;
 
 		rop<T>::begin();
-		r.inf = rop<T>::add_down(x.inf, T(y));
-		r.sup = rop<T>::add_up(x.sup, T(y));
+		rop_pair<T>::add(x.inf, T(y), x.sup, T(y), r.inf, r.sup);
 		rop<T>::end();
 		return r;
 	}
@@ -176,8 +228,7 @@ template <class T> class interval {
 		interval r;
 
 		rop<T>::begin();
-		r.inf = rop<T>::add_down(T(x), y.inf);
-		r.sup = rop<T>::add_up(T(x), y.sup);
+		rop_pair<T>::add(T(x), y.inf, T(x), y.sup, r.inf, r.sup);
 		rop<T>::end();
 
 		return r;
@@ -195,8 +246,7 @@ template <class T> class interval {
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, interval>::value, interval& >::type operator+=(interval& x, const C& y) {
 
 		rop<T>::begin();
-		x.inf = rop<T>::add_down(x.inf, T(y));
-		x.sup = rop<T>::add_up(x.sup, T(y));
+		rop_pair<T>::add(x.inf, T(y), x.sup, T(y), x.inf, x.sup);
 		rop<T>::end();
 
 		return x;
@@ -211,8 +261,7 @@ template <class T> class interval {
 		interval r;
 
 		rop<T>::begin();
-		r.inf = rop<T>::sub_down(x.inf, y.sup);
-		r.sup = rop<T>::sub_up(x.sup, y.inf);
+		rop_pair<T>::sub(x.inf, y.sup, x.sup, y.inf, r.inf, r.sup);
 		rop<T>::end();
 
 		return r;
@@ -222,8 +271,7 @@ template <class T> class interval {
 		interval r;
 
 		rop<T>::begin();
-		r.inf = rop<T>::sub_down(x.inf, T(y));
-		r.sup = rop<T>::sub_up(x.sup, T(y));
+		rop_pair<T>::sub(x.inf, T(y), x.sup, T(y), r.inf, r.sup);
 		rop<T>::end();
 
 		return r;
@@ -237,8 +285,7 @@ template <class T> class interval {
 		interval r;
 
 		rop<T>::begin();
-		r.inf = rop<T>::sub_down(T(x), y.sup);
-		r.sup = rop<T>::sub_up(T(x), y.inf);
+		rop_pair<T>::sub(T(x), y.sup, T(x), y.inf, r.inf, r.sup);
 		rop<T>::end();
 
 		return r;
@@ -256,8 +303,7 @@ template <class T> class interval {
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, interval>::value, interval& >::type operator-=(interval& x, const C& y) {
 
 		rop<T>::begin();
-		x.inf = rop<T>::sub_down(x.inf, T(y));
-		x.sup = rop<T>::sub_up(x.sup, T(y));
+		rop_pair<T>::sub(x.inf, T(y), x.sup, T(y), x.inf, x.sup);
 		rop<T>::end();
 
 		return x;
@@ -292,15 +338,12 @@ template <class T> class interval {
 					if (y.sup == 0.) {
 						r = interval(0., 0.);
 					} else {
-						r.inf = rop<T>::mul_down(x.inf, y.inf);
-						r.sup = rop<T>::mul_up(x.sup, y.sup);
+						rop_pair<T>::mul(x.inf, y.inf, x.sup, y.sup, r.inf, r.sup);
 					}
 				} else if (y.sup <= 0.) {
-					r.inf = rop<T>::mul_down(x.sup, y.inf);
-					r.sup = rop<T>::mul_up(x.inf, y.sup);
+					rop_pair<T>::mul(x.sup, y.inf, x.inf, y.sup, r.inf, r.sup);
 				} else {
-					r.inf = rop<T>::mul_down(x.sup, y.inf);
-					r.sup = rop<T>::mul_up(x.sup, y.sup);
+					rop_pair<T>::mul(x.sup, y.inf, x.sup, y.sup, r.inf, r.sup);
 				}
 			}
 		} else if (x.sup <= 0.) {
@@ -308,27 +351,22 @@ template <class T> class interval {
 				if (y.sup == 0.) {
 					r = interval(0., 0.);
 				} else {
-					r.inf = rop<T>::mul_down(x.inf, y.sup);
-					r.sup = rop<T>::mul_up(x.sup, y.inf);
+					rop_pair<T>::mul(x.inf, y.sup, x.sup, y.inf, r.inf, r.sup);
 				}
 			} else if (y.sup <= 0.) {
-				r.inf = rop<T>::mul_down(x.sup, y.sup);
-				r.sup = rop<T>::mul_up(x.inf, y.inf);
+				rop_pair<T>::mul(x.sup, y.sup, x.inf, y.inf, r.inf, r.sup);
 			} else {
-				r.inf = rop<T>::mul_down(x.inf, y.sup);
-				r.sup = rop<T>::mul_up(x.inf, y.inf);
+				rop_pair<T>::mul(x.inf, y.sup, x.inf, y.inf, r.inf, r.sup);
 			}
 		} else {
 			if (y.inf >= 0.) {
 				if (y.sup == 0.) {
 					r = interval(0., 0.);
 				} else {
-					r.inf = rop<T>::mul_down(x.inf, y.sup);
-					r.sup = rop<T>::mul_up(x.sup, y.sup);
+					rop_pair<T>::mul(x.inf, y.sup, x.sup, y.sup, r.inf, r.sup);
 				}
 			} else if (y.sup <= 0.) {
-				r.inf = rop<T>::mul_down(x.sup, y.inf);
-				r.sup = rop<T>::mul_up(x.inf, y.inf);
+				rop_pair<T>::mul(x.sup, y.inf, x.inf, y.inf, r.inf, r.sup);
 			} else {
 				r.inf = rop<T>::mul_down(x.inf, y.sup);
 				tmp = rop<T>::mul_down(x.sup, y.inf);
@@ -350,11 +388,9 @@ template <class T> class interval {
 
 		rop<T>::begin();
 		if (y > 0.) {
-			r.inf = rop<T>::mul_down(x.inf, T(y));
-			r.sup = rop<T>::mul_up(x.sup, T(y));
+			rop_pair<T>::mul(x.inf, T(y), x.sup, T(y), r.inf, r.sup);
 		} else if (y < 0.) {
-			r.inf = rop<T>::mul_down(x.sup, T(y));
-			r.sup = rop<T>::mul_up(x.inf, T(y));
+			rop_pair<T>::mul(x.sup, T(y), x.inf, T(y), r.inf, r.sup);
 		} else {
 			r = interval(0., 0.);
 		}
@@ -374,11 +410,9 @@ template <class T> class interval {
 
 		rop<T>::begin();
 		if (x > 0.) {
-			r.inf = rop<T>::mul_down(T(x), y.inf);
-			r.sup = rop<T>::mul_up(T(x), y.sup);
+			rop_pair<T>::mul(T(x), y.inf, T(x), y.sup, r.inf, r.sup);
 		} else if (x < 0.) {
-			r.inf = rop<T>::mul_down(T(x), y.sup);
-			r.sup = rop<T>::mul_up(T(x), y.inf);
+			rop_pair<T>::mul(T(x), y.sup, T(x), y.inf, r.inf, r.sup);
 		} else {
 			r = interval(0., 0.);
 		}
@@ -412,25 +446,19 @@ template <class T> class interval {
 		rop<T>::begin();
 		if (y.inf > 0.) {
 			if (x.inf >= 0.) {
-				r.inf = rop<T>::div_down(x.inf, y.sup);
-				r.sup = rop<T>::div_up(x.sup, y.inf);
+				rop_pair<T>::div(x.inf, y.sup, x.sup, y.inf, r.inf, r.sup);
 			} else if (x.sup <= 0.) {
-				r.inf = rop<T>::div_down(x.inf, y.inf);
-				r.sup = rop<T>::div_up(x.sup, y.sup);
+				rop_pair<T>::div(x.inf, y.inf, x.sup, y.sup, r.inf, r.sup);
 			} else {
-				r.inf = rop<T>::div_down(x.inf, y.inf);
-				r.sup = rop<T>::div_up(x.sup, y.inf);
+				rop_pair<T>::div(x.inf, y.inf, x.sup, y.inf, r.inf, r.sup);
 			}
 		} else if (y.sup < 0.) {
 			if (x.inf >= 0.) {
-				r.inf = rop<T>::div_down(x.sup, y.sup);
-				r.sup = rop<T>::div_up(x.inf, y.inf);
+				rop_pair<T>::div(x.sup, y.sup, x.inf, y.inf, r.inf, r.sup);
 			} else if (x.sup <= 0.) {
-				r.inf = rop<T>::div_down(x.sup, y.inf);
-				r.sup = rop<T>::div_up(x.inf, y.sup);
+				rop_pair<T>::div(x.sup, y.inf, x.inf, y.sup, r.inf, r.sup);
 			} else {
-				r.inf = rop<T>::div_down(x.sup, y.sup);
-				r.sup = rop<T>::div_up(x.inf, y.sup);
+				rop_pair<T>::div(x.sup, y.sup, x.inf, y.sup, r.inf, r.sup);
 			}
 		} else {
 			rop<T>::end();
@@ -446,11 +474,9 @@ template <class T> class interval {
 
 		rop<T>::begin();
 		if (y > 0.) {
-			r.inf = rop<T>::div_down(x.inf, T(y));
-			r.sup = rop<T>::div_up(x.sup, T(y));
+			rop_pair<T>::div(x.inf, T(y), x.sup, T(y), r.inf, r.sup);
 		} else if (y < 0.) {
-			r.inf = rop<T>::div_down(x.sup, T(y));
-			r.sup = rop<T>::div_up(x.inf, T(y));
+			rop_pair<T>::div(x.sup, T(y), x.inf, T(y), r.inf, r.sup);
 		} else {
 			rop<T>::end();
 			throw std::domain_error("interval: division by 0");
@@ -470,11 +496,9 @@ template <class T> class interval {
 		rop<T>::begin();
 		if (y.inf > 0. || y.sup < 0.) {
 			if (x >= 0.) {
-				r.inf = rop<T>::div_down(T(x), y.sup);
-				r.sup = rop<T>::div_up(T(x), y.inf);
+				rop_pair<T>::div(T(x), y.sup, T(x), y.inf, r.inf, r.sup);
 			} else {
-				r.inf = rop<T>::div_down(T(x), y.inf);
-				r.sup = rop<T>::div_up(T(x), y.sup);
+				rop_pair<T>::div(T(x), y.inf, T(x), y.sup, r.inf, r.sup);
 			}
 		} else {
 			rop<T>::end();
@@ -521,8 +545,7 @@ template <class T> class interval {
 		}
 
 		rop<T>::begin();
-		r.inf = rop<T>::sqrt_down(x.inf);
-		r.sup = rop<T>::sqrt_up(x.sup);
+		rop_pair<T>::sqrt(x.inf, x.sup, r.inf, r.sup);
 		rop<T>::end();
 
 		return r;
@@ -0,0 +1,604 @@
+/*
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef JET_HPP
+#define JET_HPP
+
+// value and at most N first derivatives stored in place.
+//
+// same arithmetic as autodif<T> (the results are identical), but the
+// derivatives are kept in a bounded array instead of a heap vector.
+// so psa< jet<T, N> >, the Taylor series of a solution together with
+// its Jacobian, is one contiguous block of (order+1) x (N+1) elements
+// and its arithmetic does not allocate.
+//
+// as autodif<T>, d.size() == 0 means that all the derivatives are 0.
+
+#include <iostream>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/storage.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <cmath>
+
+#include <kv/convert.hpp>
+#include <kv/interval.hpp>
+#include <kv/interval-blas.hpp>
+#include <kv/autodif.hpp>
+#include <kv/psa.hpp>
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+template <class T, int N> class jet;
+template <class C, class T, int N> struct convertible<C, jet<T, N> > {
+	static const bool value = convertible<C, T>::value || boost::is_same<C, jet<T, N> >::value;
+};
+template <class C, class T, int N> struct acceptable_n<C, jet<T, N> > {
+	static const bool value = convertible<C, T>::value;
+};
+
+
+template <class T, int N> class jet {
+	public:
+	typedef ub::vector< T, ub::bounded_array<T, N> > vector_type;
+
+	T v;
+	vector_type d;
+
+	typedef T base_type;
+
+	jet() {
+		v = 0.;
+		d.resize(0);
+	}
+
+	template <class C> explicit jet(const C& x, typename boost::enable_if_c< kv::acceptable_n<C, jet>::value >::type* =0) {
+		v = x;
+		d.resize(0);
+	}
+
+	// x must have at most N derivatives
+	explicit jet(const autodif<T>& x) {
+		int i;
+		int n = x.d.size();
+
+		v = x.v;
+		d.resize(n);
+		for (i=0; i<n; i++) d(i) = x.d(i);
+	}
+
+	template <class C> typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet& >::type operator=(const C& x) {
+		v = x;
+		d.resize(0);
+		return *this;
+	}
+
+	friend autodif<T> to_autodif(const jet& x) {
+		autodif<T> r;
+		int i;
+		int n = x.d.size();
+
+		r.v = x.v;
+		r.d.resize(n);
+		for (i=0; i<n; i++) r.d(i) = x.d(i);
+
+		return r;
+	}
+
+	friend jet operator+(const jet& a, const jet& b) {
+		jet r;
+
+		r.v = a.v + b.v;
+
+		if (a.d.size() == 0) {
+			r.d = b.d;
+		} else if (b.d.size() == 0) {
+			r.d = a.d;
+		} else {
+			r.d = a.d + b.d;
+		}
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet >::type operator+(const jet& a, const C& b) {
+		jet r;
+
+		r.v = a.v + b;
+		r.d = a.d;
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet >::type operator+(const C& a, const jet& b) {
+		jet r;
+
+		r.v = a + b.v;
+		r.d = b.d;
+
+		return r;
+	}
+
+	friend jet& operator+=(jet& a, const jet& b) {
+		a = a + b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet& >::type operator+=(jet& a, const C& b) {
+		a.v += b;
+		return a;
+	}
+
+	friend jet operator-(const jet& a, const jet& b) {
+		jet r;
+
+		r.v = a.v - b.v;
+
+		if (a.d.size() == 0) {
+			r.d = - b.d;
+		} else if (b.d.size() == 0) {
+			r.d = a.d;
+		} else {
+			r.d = a.d - b.d;
+		}
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet >::type operator-(const jet& a, const C& b) {
+		jet r;
+
+		r.v = a.v - b;
+		r.d = a.d;
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet >::type operator-(const C& a, const jet& b) {
+		jet r;
+
+		r.v = a - b.v;
+		r.d = - b.d;
+
+		return r;
+	}
+
+	friend jet& operator-=(jet& a, const jet& b) {
+		a = a - b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet& >::type operator-=(jet& a, const C& b) {
+		a.v -= b;
+		return a;
+	}
+
+	friend jet operator-(const jet& a) {
+		jet r;
+
+		r.v = - a.v;
+		r.d = - a.d;
+
+		return r;
+	}
+
+	friend jet operator*(const jet& a, const jet& b) {
+		jet r;
+
+		r.v = a.v * b.v;
+
+		if (a.d.size() == 0) {
+			r.d = a.v * b.d;
+		} else if (b.d.size() == 0) {
+			r.d = b.v * a.d;
+		} else {
+			r.d = b.v * a.d + a.v * b.d;
+		}
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet >::type operator*(const jet& a, const C& b) {
+		jet r;
+
+		r.v = a.v * b;
+		r.d = T(b) * a.d;
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet >::type operator*(const C& a, const jet& b) {
+		jet r;
+
+		r.v = a * b.v;
+		r.d = T(a) * b.d;
+
+		return r;
+	}
+
+	friend jet& operator*=(jet& a, const jet& b) {
+		a = a * b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet& >::type operator*=(jet& a, const C& b) {
+		a.v *= b;
+		a.d *= T(b);
+		return a;
+	}
+
+	friend jet operator/(const jet& a, const jet& b) {
+		jet r;
+
+		r.v = a.v / b.v;
+
+		if (a.d.size() == 0) {
+			r.d = b.d * (-a.v/(b.v*b.v));
+		} else if (b.d.size() == 0) {
+			r.d = a.d / b.v;
+		} else {
+			r.d = a.d / b.v + b.d * (-a.v/(b.v*b.v));
+		}
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet >::type operator/(const jet& a, const C& b) {
+		jet r;
+
+		r.v = a.v / b;
+		r.d = a.d / T(b);
+
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet >::type operator/(const C& a, const jet& b) {
+		jet r;
+
+		r.v = a / b.v;
+		r.d = b.d * (-a/(b.v*b.v));
+
+		return r;
+	}
+
+	friend jet& operator/=(jet& a, const jet& b) {
+		a = a / b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet& >::type operator/=(jet& a, const C& b) {
+		a.v /= b;
+		a.d /= T(b);
+		return a;
+	}
+
+	friend std::ostream& operator<<(std::ostream& s, const jet& x) {
+		int i;
+		int n = x.d.size();
+		s << x.v;
+		s << '<';
+		for (i=0; i<n; i++) {
+			s << x.d(i);
+			if (i != n-1) {
+				s << ',';
+			}
+		}
+		s << '>';
+		return s;
+	}
+
+	friend jet pow(const jet& x, int y) {
+		jet r;
+
+		using std::pow;
+		r.v = pow(x.v, y);
+		if (y == 0) {
+			r.d = T(0.) * x.d;
+		} else {
+			r.d = (y * pow(x.v, y - 1)) * x.d;
+		}
+		return r;
+	}
+
+	friend jet pow(const jet& x, const jet& y) {
+		return exp(y * log(x));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value && ! boost::is_integral<C>::value, jet >::type pow(const jet& a, const C& b) {
+		return pow(a, jet(b));
+	}
+
+	template <class C> friend typename boost::enable_if_c< kv::acceptable_n<C, jet>::value, jet >::type pow(const C& a, const jet& b) {
+		return pow(jet(a), b);
+	}
+
+	friend jet exp (const jet& x) {
+		jet r;
+
+		using std::exp;
+		r.v = exp(x.v);
+		r.d = r.v * x.d;
+
+		return r;
+	}
+
+	friend jet log (const jet& x) {
+		jet r;
+
+		using std::log;
+		r.v = log(x.v);
+		r.d = x.d / x.v;
+
+		return r;
+	}
+
+	friend jet sqrt (const jet& x) {
+		jet r;
+
+		using std::sqrt;
+		r.v = sqrt(x.v);
+		r.d = x.d / (2. * r.v);
+
+		return r;
+	}
+
+	friend jet sin (const jet& x) {
+		jet r;
+
+		using std::sin;
+		using std::cos;
+		r.v = sin(x.v);
+		r.d = cos(x.v) * x.d;
+
+		return r;
+	}
+
+	friend jet cos (const jet& x) {
+		jet r;
+
+		using std::sin;
+		using std::cos;
+		r.v = cos(x.v);
+		r.d = -sin(x.v) * x.d;
+
+		return r;
+	}
+
+	friend jet tan (const jet& x) {
+		jet r;
+		T tmp;
+
+		using std::tan;
+		using std::cos;
+		r.v = tan(x.v);
+		tmp = cos(x.v);
+		tmp = 1. / (tmp * tmp);
+		r.d = tmp * x.d;
+
+		return r;
+	}
+
+	friend jet asin (const jet& x) {
+		jet r;
+
+		using std::asin;
+		using std::sqrt;
+		r.v = asin(x.v);
+		r.d = (1. / sqrt(1. - x.v * x.v)) * x.d;
+
+		return r;
+	}
+
+	friend jet acos (const jet& x) {
+		jet r;
+
+		using std::acos;
+		using std::sqrt;
+		r.v = acos(x.v);
+		r.d = (-1. / sqrt(1. - x.v * x.v)) * x.d;
+
+		return r;
+	}
+
+	friend jet atan (const jet& x) {
+		jet r;
+
+		using std::atan;
+		r.v = atan(x.v);
+		r.d = (1. / (1. + x.v * x.v)) * x.d;
+
+		return r;
+	}
+
+	friend jet sinh (const jet& x) {
+		jet r;
+
+		using std::sinh;
+		using std::cosh;
+		r.v = sinh(x.v);
+		r.d = cosh(x.v) * x.d;
+
+		return r;
+	}
+
+	friend jet cosh (const jet& x) {
+		jet r;
+
+		using std::sinh;
+		using std::cosh;
+		r.v = cosh(x.v);
+		r.d = sinh(x.v) * x.d;
+
+		return r;
+	}
+
+	friend jet tanh (const jet& x) {
+		jet r;
+		T tmp;
+
+		using std::tanh;
+		using std::cosh;
+		r.v = tanh(x.v);
+		tmp = cosh(x.v);
+		tmp = 1. / (tmp * tmp);
+		r.d = tmp * x.d;
+
+		return r;
+	}
+
+	friend jet asinh (const jet& x) {
+		jet r;
+
+		using std::sqrt;
+		r.v = asinh(x.v);
+		r.d = (1. / sqrt(x.v * x.v + 1.)) * x.d;
+
+		return r;
+	}
+
+	friend jet acosh (const jet& x) {
+		jet r;
+
+		using std::sqrt;
+		r.v = acosh(x.v);
+		r.d = (1. / sqrt(x.v * x.v - 1.)) * x.d;
+
+		return r;
+	}
+
+	friend jet atanh (const jet& x) {
+		jet r;
+
+		r.v = atanh(x.v);
+		r.d = (1. / (1. - x.v * x.v)) * x.d;
+
+		return r;
+	}
+};
+
+/*
+ * kernels of psa for the series of jets: the coefficients are processed
+ * in one rounding scope, with the same operations as the operators of
+ * jet< interval<T>, N > and interval<T>, so the results are the same.
+ */
+
+namespace jet_sub {
+
+// r = a * b
+// must be called between rop<T>::begin() and rop<T>::end().
+
+template <class T, int N> void mul(const jet< interval<T>, N >& a, const jet< interval<T>, N >& b, jet< interval<T>, N >& r) {
+	int i;
+	int na = a.d.size();
+	int nb = b.d.size();
+	T tl, tu;
+
+	iblas_sub::mul(a.v.lower(), a.v.upper(), b.v.lower(), b.v.upper(), r.v.lower(), r.v.upper());
+
+	if (na == 0) {
+		r.d.resize(nb, false);
+		for (i=0; i<nb; i++) {
+			iblas_sub::mul(a.v.lower(), a.v.upper(), b.d(i).lower(), b.d(i).upper(), r.d(i).lower(), r.d(i).upper());
+		}
+	} else if (nb == 0) {
+		r.d.resize(na, false);
+		for (i=0; i<na; i++) {
+			iblas_sub::mul(b.v.lower(), b.v.upper(), a.d(i).lower(), a.d(i).upper(), r.d(i).lower(), r.d(i).upper());
+		}
+	} else {
+		r.d.resize(na, false);
+		for (i=0; i<na; i++) {
+			iblas_sub::mul(b.v.lower(), b.v.upper(), a.d(i).lower(), a.d(i).upper(), r.d(i).lower(), r.d(i).upper());
+			iblas_sub::mul(a.v.lower(), a.v.upper(), b.d(i).lower(), b.d(i).upper(), tl, tu);
+			rop_pair<T>::add(r.d(i).lower(), tl, r.d(i).upper(), tu, r.d(i).lower(), r.d(i).upper());
+		}
+	}
+}
+
+// r = r + a
+// must be called between rop<T>::begin() and rop<T>::end().
+
+template <class T, int N> void add(jet< interval<T>, N >& r, const jet< interval<T>, N >& a) {
+	int i;
+	int nr = r.d.size();
+	int na = a.d.size();
+
+	rop_pair<T>::add(r.v.lower(), a.v.lower(), r.v.upper(), a.v.upper(), r.v.lower(), r.v.upper());
+
+	if (nr == 0) {
+		r.d = a.d;
+	} else if (na != 0) {
+		for (i=0; i<nr; i++) {
+			rop_pair<T>::add(r.d(i).lower(), a.d(i).lower(), r.d(i).upper(), a.d(i).upper(), r.d(i).lower(), r.d(i).upper());
+		}
+	}
+}
+
+} // namespace jet_sub
+
+template <class T, int N> struct psa_kernel< jet< interval<T>, N > > {
+	typedef jet< interval<T>, N > J;
+	typedef rop_scope<T> scope;
+
+	template <class V> static void conv(const V& a, const V& b, V& r, int from) {
+		int i, j;
+		J sum, tmp;
+
+		rop_scope<T> scope;
+		for (i=from; i<r.size(); i++) {
+			sum.v = 0.;
+			sum.d.resize(0);
+			for (j=0; j<=i; j++) {
+				jet_sub::mul(a(j), b(i-j), tmp);
+				jet_sub::add(sum, tmp);
+			}
+			r(i) = sum;
+		}
+	}
+
+	template <class V> static void conv_tail(const V& a, const V& b, V& r) {
+		int i, j;
+		int s = a.size();
+		J sum, tmp;
+
+		rop_scope<T> scope;
+		for (i=1; i<s; i++) {
+			sum.v = 0.;
+			sum.d.resize(0);
+			for (j=i; j<s; j++) {
+				jet_sub::mul(a(j), b(i-j+s-1), tmp);
+				jet_sub::add(sum, tmp);
+			}
+			r(i) = sum;
+		}
+	}
+
+	template <class V> static J horner(const V& p, int x, int y, const J& d) {
+		int i;
+		J r, tmp;
+
+		r = p(y);
+		rop_scope<T> scope;
+		for (i=y-1; i>=x; i--) {
+			jet_sub::mul(r, d, tmp);
+			r = tmp;
+			jet_sub::add(r, p(i));
+		}
+		return r;
+	}
+};
+
+// for the code common to autodif<T> and jet<T, N>
+
+template <class T> inline const autodif<T>& to_autodif(const autodif<T>& x) {
+	return x;
+}
+
+} // namespace kv
+
+#endif // JET_HPP
@@ -11,6 +11,15 @@
 
 #include <kv/interval.hpp>
 #include <kv/autodif.hpp>
+#include <kv/autodif-reverse.hpp>
+
+// 0: derivatives of f, g, h by autodif (forward mode)
+// 1: derivatives of f, g, h by autodif_reverse (reverse mode, faster
+//    for many variables and few constraints)
+
+#ifndef KKT_AUTODIF
+#define KKT_AUTODIF 0
+#endif
 
 namespace kv {
 
@@ -148,6 +157,18 @@ autodif<T> alpha_minus(const autodif<T>& x) {
 	return r;
 }
 
+// alpha_plus/alpha_minus function for autodif_reverse
+
+template <class T>
+autodif_reverse<T> alpha_plus(const autodif_reverse<T>& x) {
+	return autodif_reverse<T>::unary(alpha_plus(x.v), x, alpha_plus_d(x.v));
+}
+
+template <class T>
+autodif_reverse<T> alpha_minus(const autodif_reverse<T>& x) {
+	return autodif_reverse<T>::unary(alpha_minus(x.v), x, alpha_minus_d(x.v));
+}
+
 // KKT equation maker using objective function, inequalities, equalities
 
 template <class F1, class F2, class F3>
@@ -172,13 +193,18 @@ struct KKT_equation {
 		ub::vector<T> r;
 		int i;
 		T dummy;
+#if KKT_AUTODIF == 1
+		typedef autodif_reverse<T> AD;
+#else
+		typedef autodif<T> AD;
+#endif
 
 		xx.resize(sf);
 		for (i=0; i<sf; i++) xx(i) = x(i);
 
-		autodif<T>::split(f(autodif<T>::init(xx)), dummy, fv);
+		AD::split(f(AD::init(xx)), dummy, fv);
 
-		autodif<T>::split(g(autodif<T>::init(xx)), gv, gm);
+		AD::split(g(AD::init(xx)), gv, gm);
 		sg = gv.size();
 		if (sg != 0) {
 			b.resize(sg);
@@ -189,7 +215,7 @@ struct KKT_equation {
 			fv += prod(trans(gm), b);
 		}
 
-		autodif<T>::split(h(autodif<T>::init(xx)), hv, hm);
+		AD::split(h(AD::init(xx)), hv, hm);
 		sh = hv.size();
 		if (sh != 0) {
 			mu.resize(sh);
@@ -0,0 +1,300 @@
+/*
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef KRAW_APPROX_SPARSE_HPP
+#define KRAW_APPROX_SPARSE_HPP
+
+// Krawczyk method using approximate solution for large systems with
+// banded Jacobian
+//
+//  same as krawczyk_approx, but the Jacobian is calculated by
+//  autodif_sparse and R = (LU)^(-1) is not formed, where LU is the LU
+//  decomposition (without pivoting) of mid(f'(c)) stored as a band
+//  matrix. using (I - R f'(I)) = R (LU - f'(I)),
+//    K = c - R (f(c) - (LU - f'(I)) (I - c))
+//  includes the Krawczyk set, where LU - f'(I) is calculated exactly
+//  by interval arithmetic and R v is calculated by forward and backward
+//  substitution in interval arithmetic. the cost is O(n b^2) for the
+//  bandwidth b instead of O(n^3).
+//
+//  since no pivoting is done, mid(f'(c)) should be e.g. diagonally
+//  dominant or symmetric definite.
+
+#include <limits>
+#include <vector>
+#include <algorithm>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix_sparse.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/interval-vector.hpp>
+#include <kv/autodif-sparse.hpp>
+#include <kv/make-candidate.hpp>
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+namespace krawczyk_approx_sparse_sub {
+
+// lower and upper bandwidth of sparse matrix
+
+template <class T> void bandwidth(const ub::compressed_matrix<T>& m, int& kl, int& ku)
+{
+	int i, k;
+	int n = m.size1();
+
+	kl = 0;
+	ku = 0;
+	for (i=0; i<n; i++) {
+		for (k=m.index1_data()[i]; k<(int)m.index1_data()[i+1]; k++) {
+			kl = std::max(kl, i - (int)m.index2_data()[k]);
+			ku = std::max(ku, (int)m.index2_data()[k] - i);
+		}
+	}
+}
+
+// square band matrix. the row i has the columns i-kl, ..., i+ku.
+
+template <class T> struct band {
+	int n, kl, ku;
+	std::vector<T> a;
+
+	void resize(int n1, int kl1, int ku1) {
+		n = n1;
+		kl = kl1;
+		ku = ku1;
+		a.assign(n * (kl + ku + 1), T(0.));
+	}
+
+	T& operator()(int i, int j) {
+		return a[i * (kl + ku + 1) + j - i + kl];
+	}
+
+	const T& operator()(int i, int j) const {
+		return a[i * (kl + ku + 1) + j - i + kl];
+	}
+};
+
+// LU decomposition of the midpoint of interval band matrix without
+// pivoting. L (unit lower triangular, diagonal not stored) and U are
+// kept in the same band matrix.
+
+template <class T> class band_lu {
+	band<T> lu;
+
+	public:
+
+	int size() const {
+		return lu.n;
+	}
+
+	bool factor(const ub::compressed_matrix< interval<T> >& m, int kl, int ku) {
+		int n = m.size1();
+		int i, j, k;
+		T p, l;
+
+		lu.resize(n, kl, ku);
+		for (i=0; i<n; i++) {
+			for (k=m.index1_data()[i]; k<(int)m.index1_data()[i+1]; k++) {
+				lu(i, m.index2_data()[k]) = mid(m.value_data()[k]);
+			}
+		}
+
+		for (k=0; k<n; k++) {
+			p = lu(k, k);
+			if (p == 0.) return false;
+			for (i=k+1; i<=std::min(n-1, k+kl); i++) {
+				l = lu(i, k) / p;
+				lu(i, k) = l;
+				if (l == 0.) continue;
+				for (j=k+1; j<=std::min(n-1, k+ku); j++) {
+					lu(i, j) -= l * lu(k, j);
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// x = (LU)^(-1) x. V is T or interval<T>. if V is interval<T>,
+	// the result includes (LU)^(-1) x for exact L, U stored.
+
+	template <class V> void solve(ub::vector<V>& x) const {
+		int n = lu.n;
+		int i, j;
+
+		for (i=0; i<n; i++) {
+			for (j=std::max(0, i-lu.kl); j<i; j++) {
+				x(i) -= lu(i, j) * x(j);
+			}
+		}
+		for (i=n-1; i>=0; i--) {
+			for (j=i+1; j<=std::min(n-1, i+lu.ku); j++) {
+				x(i) -= lu(i, j) * x(j);
+			}
+			x(i) /= lu(i, i);
+		}
+	}
+
+	// d = LU - m by interval arithmetic. return false if m has an
+	// element outside the band.
+
+	bool residual(const ub::compressed_matrix< interval<T> >& m, band< interval<T> >& d) const {
+		int n = lu.n;
+		int kl = lu.kl;
+		int ku = lu.ku;
+		int i, j, k;
+		interval<T> s;
+
+		d.resize(n, kl, ku);
+		for (i=0; i<n; i++) {
+			for (j=std::max(0, i-kl); j<=std::min(n-1, i+ku); j++) {
+				// sum of L(i,k) U(k,j) for k <= min(i,j), L(i,i) = 1
+				s = 0.;
+				for (k=std::max(std::max(0, i-kl), j-ku); k<std::min(i, j); k++) {
+					s += interval<T>(lu(i, k)) * lu(k, j);
+				}
+				if (i <= j) s += lu(i, j);
+				else s += interval<T>(lu(i, j)) * lu(j, j);
+				d(i, j) = s;
+			}
+			for (k=m.index1_data()[i]; k<(int)m.index1_data()[i+1]; k++) {
+				j = m.index2_data()[k];
+				if (j < i - kl || j > i + ku) return false;
+				d(i, j) -= m.value_data()[k];
+			}
+		}
+
+		return true;
+	}
+};
+
+} // namespace krawczyk_approx_sparse_sub
+
+
+template <class T, class F>
+bool
+krawczyk_approx_sparse(F f, const ub::vector<T>& c, ub::vector< interval<T> >& result, int newton_max = 2, int verbose = 1)
+{
+	int s = c.size();
+
+	ub::vector< interval<T> > I, fc, fi, Rfc, C, K, v;
+	ub::compressed_matrix< interval<T> > fdc, fdi;
+	krawczyk_approx_sparse_sub::band_lu<T> lu;
+	krawczyk_approx_sparse_sub::band< interval<T> > D;
+	ub::vector<T> c2, minus;
+	int i, j, kl, ku;
+	bool r;
+	ub::vector<T> newton_step;
+	T tmp, tmp2;
+
+	c2 = c;
+
+	// Newton iteration
+	// use interval<T> for argument of f
+	// preparing for the case that f can not accept T.
+
+	for (i=0; i<newton_max; i++) {
+		C = c2;
+		try {
+			autodif_sparse< interval<T> >::split(f(autodif_sparse< interval<T> >::init(C)), fc, fdc);
+		}
+		catch (std::domain_error& e) {
+			return false;
+		}
+		krawczyk_approx_sparse_sub::bandwidth(fdc, kl, ku);
+		r = lu.factor(fdc, kl, ku);
+		if (!r) return false;
+
+		minus = mid(fc);
+		lu.solve(minus);
+
+		tmp = 1.;
+		tmp2 = 0.;
+		for (j=0; j<s; j++) {
+			using std::abs;
+			tmp = std::max(tmp, abs(c2(j)));
+			tmp2 = std::max(tmp2, abs(minus(j)));
+		}
+
+		c2 = c2 - minus;
+		if (verbose >= 1) {
+			std::cout << "newton" << i << ": " << c2 << "\n";
+		}
+		if (tmp2 <= tmp * std::numeric_limits<T>::epsilon()) break;
+	}
+
+	C = c2;
+	try {
+		autodif_sparse< interval<T> >::split(f(autodif_sparse< interval<T> >::init(C)), fc, fdc);
+	}
+	catch (std::domain_error& e) {
+		return false;
+	}
+	krawczyk_approx_sparse_sub::bandwidth(fdc, kl, ku);
+	r = lu.factor(fdc, kl, ku);
+	if (!r) return false;
+	Rfc = fc;
+	lu.solve(Rfc);
+
+	newton_step.resize(s);
+	for (i=0; i<s; i++) {
+		newton_step(i) = norm(Rfc(i));
+	}
+
+	make_candidate(newton_step);
+
+	I = C;
+	for (i=0; i<s; i++) {
+		tmp = std::numeric_limits<T>::epsilon() * norm(I(i)) * (s+1) * 2;
+		tmp2 = std::numeric_limits<T>::min() * (s+1) * 2;
+		if (newton_step(i) < tmp) newton_step(i) = tmp;
+		if (newton_step(i) < tmp2) newton_step(i) = tmp2;
+		I(i) += newton_step(i) * interval<T>(-1., 1.);
+	}
+
+	if (verbose >= 1) {
+		std::cout << "I: " << I << "\n";
+	}
+
+	try {
+		autodif_sparse< interval<T> >::split(f(autodif_sparse< interval<T> >::init(I)), fi, fdi);
+	}
+	catch (std::domain_error& e) {
+		return false;
+	}
+
+	// D = LU - f'(I)
+	r = lu.residual(fdi, D);
+	if (!r) return false;
+
+	// K = C - R (f(C) - D (I - C))
+	v = fc;
+	for (i=0; i<s; i++) {
+		for (j=std::max(0, i-kl); j<=std::min(s-1, i+ku); j++) {
+			v(i) -= D(i, j) * (I(j) - C(j));
+		}
+	}
+	lu.solve(v);
+	K = C - v;
+
+	if (verbose >= 1) {
+		std::cout << "K: " << K << "\n";
+	}
+
+	if (proper_subset(K, I)) {
+		result = K;
+		return true;
+	} else {
+		return false;
+	}
+}
+
+} // namespace kv
+
+#endif // KRAW_APPROX_SPARSE_HPP
@@ -15,6 +15,7 @@
 #include <kv/interval.hpp>
 #include <kv/rdouble.hpp>
 #include <kv/interval-vector.hpp>
+#include <kv/interval-blas.hpp>
 #include <kv/autodif.hpp>
 #include <kv/matrix-inversion.hpp>
 #include <kv/make-candidate.hpp>
@@ -82,7 +83,7 @@ krawczyk_approx(F f, const ub::vector<T>& c, ub::vector< interval<T> >& result,
 	}
 	r = invert(mid(fdc), R);
 	if (!r) return false;
-	Rfc = prod(R, fc);
+	Rfc = iblas::gemv(R, fc);
 
 	newton_step.resize(s);
 	for (i=0; i<s; i++) {
@@ -113,9 +114,9 @@ krawczyk_approx(F f, const ub::vector<T>& c, ub::vector< interval<T> >& result,
 
 	// M = ub::identity_matrix< interval<T> >(s) - prod(R, fdi);
 	M = ub::identity_matrix< interval<T> >(s);
-	M -= prod(R, fdi);
+	M -= iblas::gemm(R, fdi);
 
-	K = C - Rfc +  prod(M, I - C);
+	K = C - Rfc + iblas::gemv<T>(M, I - C);
 
 	if (verbose >= 1) {
 		std::cout << "K: " << K << "\n";
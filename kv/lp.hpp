@@ -8,17 +8,547 @@
 #include <stdexcept>
 #include <list>
 #include <limits>
+#include <vector>
+#include <algorithm>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
 #include <kv/interval.hpp>
 #include <kv/rdouble.hpp>
 
 
+// number of the updates of the basis in the revised simplex method
+// before the LU decomposition of the basis is recomputed
+
+#ifndef LP_REFACTOR
+#define LP_REFACTOR 50
+#endif
+
+
 namespace kv {
 
 namespace ub = boost::numeric::ublas;
 
-template <class T> inline T lp_minimize(ub::vector<T>& objfunc, std::list< ub::vector<T> >& constraints)
+namespace lp_sub {
+
+// revised simplex method for
+//   minimize objfunc(0) + objfunc(1) x_1 + ... + objfunc(n) x_n
+//   subject to x_j >= 0, c(0) + c(1) x_1 + ... + c(n) x_n <= 0
+// starting from the slack basis (c(0) <= 0 is required).
+//
+//  the constraint matrix is stored by columns without zeros and the
+//  slack columns are not stored. the basis B is kept as the LU
+//  decomposition of B at the last refactorization and the product of
+//  the eta matrices of the pivots after that, so that a pivot costs
+//  O(m^2 + nonzeros) instead of O(m (n+m)) of the full tableau.
+//  the pivot rule (largest reduced cost, first row on ties) is the
+//  same as the tableau version. after many degenerate pivots or
+//  iterations Bland's rule is used to avoid cycling, and if the
+//  rounding errors still make it cycle, std::domain_error is thrown.
+
+template <class T> class revised_simplex {
+	// constraint matrix in compressed column storage
+	std::vector<int> cp, ci;
+	std::vector<T> cv;
+
+	// LU decomposition of the basis at the last refactorization with
+	// row permutation perm (identity if lu is empty)
+	std::vector<T> lu;
+	std::vector<int> perm;
+
+	// eta matrices: pivot row, pivot element and the other nonzeros
+	// of the pivot column
+	std::vector<int> eta_r, eta_p, eta_i;
+	std::vector<T> eta_d, eta_v;
+
+	public:
+
+	int m, n;
+	T cost0;
+	std::vector<T> b, cost;
+
+	// the k-th constraint is divided by rscale[k], a power of 2 near
+	// the largest absolute value of its coefficients, so that the
+	// pivot tolerance below is relative to the scale of each row.
+	// b, the stored columns and y are those of the scaled constraints.
+	std::vector<T> rscale;
+
+	// basic(i) is the variable of the i-th row: j (0 <= j < n) is x_(j+1),
+	// n + k is the slack of the k-th constraint.
+	std::vector<int> basic;
+	std::vector<bool> isbasic;
+
+	// values of the basic variables and the simplex multipliers
+	std::vector<T> xb, y;
+
+	revised_simplex(const ub::vector<T>& objfunc, const std::list< ub::vector<T> >& constraints) {
+		int i, j, k;
+		typename std::list< ub::vector<T> >::const_iterator p;
+
+		m = constraints.size();
+		n = objfunc.size() - 1;
+		cost0 = objfunc(0);
+		cost.resize(n);
+		for (j=0; j<n; j++) cost[j] = objfunc(j+1);
+
+		b.resize(m);
+		rscale.resize(m);
+		cp.assign(n+1, 0);
+		for (p=constraints.begin(), i=0; p!=constraints.end(); p++, i++) {
+			if ((*p)(0) > 0) {
+				throw std::domain_error("lp_minimize: constraints sign error");
+			}
+			rscale[i] = 0.;
+			for (j=1; j<=n && j<(int)(*p).size(); j++) {
+				using std::abs;
+				if ((*p)(j) != 0.) cp[j]++;
+				if (abs((*p)(j)) > rscale[i]) rscale[i] = abs((*p)(j));
+			}
+			if (rscale[i] == 0.) {
+				rscale[i] = 1.;
+			} else {
+				using std::frexp;
+				using std::ldexp;
+				frexp(rscale[i], &k);
+				rscale[i] = ldexp(T(1.), k);
+			}
+			b[i] = -(*p)(0) / rscale[i];
+		}
+		for (j=0; j<n; j++) cp[j+1] += cp[j];
+		ci.resize(cp[n]);
+		cv.resize(cp[n]);
+		for (p=constraints.begin(), i=0; p!=constraints.end(); p++, i++) {
+			for (j=1; j<=n && j<(int)(*p).size(); j++) {
+				if ((*p)(j) == 0.) continue;
+				k = --cp[j];
+				ci[k] = i;
+				cv[k] = (*p)(j) / rscale[i];
+			}
+		}
+		// cp[j] is now the beginning of column j-1. shift it.
+		for (j=0; j<n; j++) cp[j] = cp[j+1];
+		cp[n] = ci.size();
+		// the rows in each column were filled backward. reverse them.
+		for (j=0; j<n; j++) {
+			std::reverse(ci.begin() + cp[j], ci.begin() + cp[j+1]);
+			std::reverse(cv.begin() + cp[j], cv.begin() + cp[j+1]);
+		}
+	}
+
+	// v = B^(-1) v
+
+	void ftran(std::vector<T>& v) const {
+		int i, k, e;
+		T t;
+
+		if (!lu.empty()) {
+			std::vector<T> w(m);
+			for (i=0; i<m; i++) w[i] = v[perm[i]];
+			for (i=0; i<m; i++) {
+				for (k=0; k<i; k++) w[i] -= lu[i*m+k] * w[k];
+			}
+			for (i=m-1; i>=0; i--) {
+				for (k=i+1; k<m; k++) w[i] -= lu[i*m+k] * w[k];
+				w[i] /= lu[i*m+i];
+			}
+			v.swap(w);
+		}
+
+		for (e=0; e<(int)eta_r.size(); e++) {
+			t = v[eta_r[e]] / eta_d[e];
+			v[eta_r[e]] = t;
+			if (t == 0.) continue;
+			for (k=eta_p[e]; k<eta_p[e+1]; k++) {
+				v[eta_i[k]] -= eta_v[k] * t;
+			}
+		}
+	}
+
+	// v^T = v^T B^(-1)
+
+	void btran(std::vector<T>& v) const {
+		int i, k, e;
+		T t;
+
+		for (e=(int)eta_r.size()-1; e>=0; e--) {
+			t = v[eta_r[e]];
+			for (k=eta_p[e]; k<eta_p[e+1]; k++) {
+				t -= eta_v[k] * v[eta_i[k]];
+			}
+			v[eta_r[e]] = t / eta_d[e];
+		}
+
+		if (!lu.empty()) {
+			std::vector<T> w(m);
+			for (i=0; i<m; i++) {
+				t = v[i];
+				for (k=0; k<i; k++) t -= lu[k*m+i] * w[k];
+				w[i] = t / lu[i*m+i];
+			}
+			for (i=m-1; i>=0; i--) {
+				for (k=i+1; k<m; k++) w[i] -= lu[k*m+i] * w[k];
+			}
+			for (i=0; i<m; i++) v[perm[i]] = w[i];
+		}
+	}
+
+	// LU decomposition of the current basis with partial pivoting
+
+	void refactor() {
+		int i, j, k, mi;
+		T tmp, mx;
+
+		lu.assign(m*m, T(0.));
+		perm.resize(m);
+		for (i=0; i<m; i++) {
+			perm[i] = i;
+			j = basic[i];
+			if (j >= n) {
+				lu[(j-n)*m+i] = 1.;
+			} else {
+				for (k=cp[j]; k<cp[j+1]; k++) lu[ci[k]*m+i] = cv[k];
+			}
+		}
+
+		for (k=0; k<m; k++) {
+			mi = k;
+			mx = 0.;
+			for (i=k; i<m; i++) {
+				using std::abs;
+				tmp = abs(lu[i*m+k]);
+				if (tmp > mx) {
+					mx = tmp;
+					mi = i;
+				}
+			}
+			if (mx == 0.) {
+				throw std::domain_error("lp_minimize: singular basis");
+			}
+			if (mi != k) {
+				for (j=0; j<m; j++) std::swap(lu[k*m+j], lu[mi*m+j]);
+				std::swap(perm[k], perm[mi]);
+			}
+			for (i=k+1; i<m; i++) {
+				if (lu[i*m+k] == 0.) continue;
+				tmp = lu[i*m+k] / lu[k*m+k];
+				lu[i*m+k] = tmp;
+				for (j=k+1; j<m; j++) lu[i*m+j] -= tmp * lu[k*m+j];
+			}
+		}
+
+		eta_r.clear();
+		eta_p.assign(1, 0);
+		eta_i.clear();
+		eta_d.clear();
+		eta_v.clear();
+
+		xb = b;
+		ftran(xb);
+		for (i=0; i<m; i++) {
+			if (xb[i] < 0.) xb[i] = 0.;
+		}
+	}
+
+	// solve the problem and return the minimum
+
+	T solve() {
+		int i, j, k, pivot_i, pivot_j, degenerate, iter, last;
+		bool bland;
+		T tmp, tmp2, minmax, r, ymax, wmax;
+		T eps = std::numeric_limits<T>::epsilon() * 64;
+		std::vector<T> w(m);
+
+		basic.resize(m);
+		isbasic.assign(n+m, false);
+		for (i=0; i<m; i++) {
+			basic[i] = n+i;
+			isbasic[n+i] = true;
+		}
+		xb = b;
+		y.resize(m);
+		lu.clear();
+		eta_r.clear();
+		eta_p.assign(1, 0);
+		eta_i.clear();
+		eta_d.clear();
+		eta_v.clear();
+		degenerate = 0;
+		iter = 0;
+		last = -1;
+
+		while (true) {
+			// the rounding errors may make the method cycle. give up
+			// then, and the callers use the tableau version.
+			if (iter > 20 * (n + m)) {
+				throw std::domain_error("lp_minimize: too many iterations");
+			}
+			bland = degenerate > m || iter > 10 * (n + m);
+			iter++;
+
+			for (i=0; i<m; i++) {
+				y[i] = (basic[i] < n) ? cost[basic[i]] : T(0.);
+			}
+			btran(y);
+
+			ymax = 0.;
+			for (i=0; i<m; i++) {
+				using std::abs;
+				if (abs(y[i]) > ymax) ymax = abs(y[i]);
+			}
+
+			// entering variable: the largest y A_j - c_j > 0.
+			// reduced costs within the rounding error are regarded
+			// as 0, otherwise the method may cycle on them. the
+			// variable which left the basis just before is not used
+			// (its reduced cost is negative in exact arithmetic).
+			pivot_j = -1;
+			minmax = 0.;
+			for (j=0; j<n+m; j++) {
+				using std::abs;
+				if (isbasic[j] || j == last) continue;
+				if (j < n) {
+					tmp = -cost[j];
+					tmp2 = abs(cost[j]);
+					for (k=cp[j]; k<cp[j+1]; k++) {
+						tmp += y[ci[k]] * cv[k];
+						tmp2 += abs(y[ci[k]] * cv[k]);
+					}
+				} else {
+					tmp = y[j-n];
+					tmp2 = ymax;
+				}
+				if (tmp <= tmp2 * eps) continue;
+				if (tmp > minmax) {
+					pivot_j = j;
+					minmax = tmp;
+					if (bland) break;
+				}
+			}
+			if (pivot_j == -1) break;
+
+			for (i=0; i<m; i++) w[i] = 0.;
+			if (pivot_j < n) {
+				for (k=cp[pivot_j]; k<cp[pivot_j+1]; k++) w[ci[k]] = cv[k];
+			} else {
+				w[pivot_j-n] = 1.;
+			}
+			ftran(w);
+
+			// leaving variable. the elements of w which are small
+			// relative to the largest one may be rounding errors of
+			// zeros, and pivoting on them makes the basis nearly
+			// singular and xb huge. they are not used.
+			wmax = 0.;
+			for (i=0; i<m; i++) {
+				if (w[i] > wmax) wmax = w[i];
+			}
+			pivot_i = -1;
+			minmax = std::numeric_limits<T>::max();
+			for (i=0; i<m; i++) {
+				if (w[i] <= wmax * eps) continue;
+				tmp = xb[i] / w[i];
+				if (tmp < minmax || (bland && tmp == minmax && basic[i] < basic[pivot_i])) {
+					minmax = tmp;
+					pivot_i = i;
+				}
+			}
+			if (pivot_i == -1) {
+				throw std::domain_error("lp_minimize: no optimal solution");
+			}
+
+			if (minmax == 0.) degenerate++;
+			else degenerate = 0;
+
+			// xb >= 0 in exact arithmetic. negative values by the
+			// rounding errors would give negative steps in the ratio
+			// test, which increase the objective.
+			for (i=0; i<m; i++) {
+				if (i == pivot_i) continue;
+				xb[i] -= minmax * w[i];
+				if (xb[i] < 0.) xb[i] = 0.;
+			}
+			xb[pivot_i] = minmax;
+
+			last = basic[pivot_i];
+			isbasic[last] = false;
+			isbasic[pivot_j] = true;
+			basic[pivot_i] = pivot_j;
+
+			if ((int)eta_r.size() + 1 >= LP_REFACTOR) {
+				refactor();
+			} else {
+				eta_r.push_back(pivot_i);
+				eta_d.push_back(w[pivot_i]);
+				for (i=0; i<m; i++) {
+					if (i == pivot_i || w[i] == 0.) continue;
+					eta_i.push_back(i);
+					eta_v.push_back(w[i]);
+				}
+				eta_p.push_back(eta_i.size());
+			}
+		}
+
+		r = cost0;
+		for (i=0; i<m; i++) {
+			if (basic[i] < n) r += cost[basic[i]] * xb[i];
+		}
+
+		return r;
+	}
+
+	// dual solution (multipliers of the constraints, >= 0)
+
+	void dual(ub::vector<T>& d) const {
+		d.resize(m);
+		for (int i=0; i<m; i++) d(i) = (y[i] < 0.) ? T(-y[i] / rscale[i]) : T(0.);
+	}
+
+	// primal solution (x_1, ..., x_n)
+
+	void primal(ub::vector<T>& x) const {
+		int i;
+
+		x.resize(n);
+		for (i=0; i<n; i++) x(i) = 0.;
+		for (i=0; i<m; i++) {
+			if (basic[i] < n && xb[i] > 0.) x(basic[i]) = xb[i];
+		}
+	}
+};
+
+// upper bounds of the variables derived from the constraints whose
+// coefficients are all nonnegative: c(j) x_j <= -c(0). infinity if
+// there is no such constraint.
+
+template <class T> void variable_bounds(const std::list< ub::vector<T> >& constraints, int n, ub::vector<T>& xmax)
+{
+	int j;
+	bool flag;
+	T tmp;
+	typename std::list< ub::vector<T> >::const_iterator p;
+
+	xmax.resize(n);
+	for (j=0; j<n; j++) xmax(j) = std::numeric_limits<T>::infinity();
+
+	for (p=constraints.begin(); p!=constraints.end(); p++) {
+		flag = true;
+		for (j=1; j<=n && j<(int)(*p).size(); j++) {
+			if ((*p)(j) < 0.) {
+				flag = false;
+				break;
+			}
+		}
+		if (!flag) continue;
+		for (j=1; j<=n && j<(int)(*p).size(); j++) {
+			if ((*p)(j) == 0.) continue;
+			tmp = (-interval<T>((*p)(0)) / (*p)(j)).upper();
+			if (tmp < xmax(j-1)) xmax(j-1) = tmp;
+		}
+	}
+}
+
+// lower bound of the minimum by the weak duality for dual >= 0 and
+// 0 <= x_j <= xmax(j-1):
+//   f(x) >= f(x) + sum_i dual_i (c_i(0) + c_i(1) x_1 + ...)
+//        >= objfunc(0) + sum_i dual_i c_i(0) + sum_j min(0, r_j) xmax(j-1)
+// where r_j = objfunc(j) + sum_i dual_i c_i(j). if xmax is NULL, the
+// bounds are calculated by variable_bounds when needed. return false
+// if r_j < 0 for an unbounded x_j.
+
+template <class T> bool dual_bound(const ub::vector<T>& objfunc, const std::list< ub::vector<T> >& constraints, const ub::vector<T>& dual, const ub::vector<T>* xmax, T& result)
+{
+	int i, j;
+	int m = constraints.size();
+	int lp_n = objfunc.size() - 1;
+	typename std::list< ub::vector<T> >::const_iterator p;
+	ub::vector< interval<T> > r(lp_n + 1);
+	ub::vector<T> xmax2;
+	interval<T> y, lb;
+
+	for (j=0; j<=lp_n; j++) r(j) = objfunc(j);
+	p = constraints.begin();
+	for (i=0; i<m; i++) {
+		if (dual(i) > 0.) {
+			y = dual(i);
+			for (j=0; j<=lp_n && j<(int)(*p).size(); j++) {
+				if ((*p)(j) != 0.) r(j) += y * (*p)(j);
+			}
+		}
+		p++;
+	}
+
+	lb = r(0);
+	for (j=1; j<=lp_n; j++) {
+		if (r(j).lower() >= 0.) continue;
+		if (xmax == NULL) {
+			variable_bounds(constraints, lp_n, xmax2);
+			xmax = &xmax2;
+		}
+		if ((*xmax)(j-1) == std::numeric_limits<T>::infinity()) return false;
+		lb += interval<T>(r(j).lower()) * (*xmax)(j-1);
+	}
+
+	result = lb.lower();
+	return true;
+}
+
+// upper bound of the minimum by the value at x if x is feasible
+
+template <class T> bool primal_bound(const ub::vector<T>& objfunc, const std::list< ub::vector<T> >& constraints, const ub::vector<T>& x, T& result)
+{
+	int j;
+	int lp_n = objfunc.size() - 1;
+	typename std::list< ub::vector<T> >::const_iterator p;
+	interval<T> tmp;
+
+	for (p=constraints.begin(); p!=constraints.end(); p++) {
+		tmp = (*p)(0);
+		for (j=1; j<=lp_n && j<(int)(*p).size(); j++) {
+			if ((*p)(j) != 0. && x(j-1) != 0.) tmp += interval<T>((*p)(j)) * x(j-1);
+		}
+		if (tmp.upper() > 0.) return false;
+	}
+
+	tmp = objfunc(0);
+	for (j=1; j<=lp_n; j++) {
+		if (objfunc(j) != 0. && x(j-1) != 0.) tmp += interval<T>(objfunc(j)) * x(j-1);
+	}
+
+	result = tmp.upper();
+	return true;
+}
+
+// move x toward 0 (which is feasible since c(0) <= 0) by about
+// k times the relative rounding error of the constraints, so that a
+// solution on the boundary can be proved to be feasible by
+// primal_bound.
+
+template <class T> void shrink(const std::list< ub::vector<T> >& constraints, ub::vector<T>& x, const T& k)
+{
+	int j;
+	int n = x.size();
+	typename std::list< ub::vector<T> >::const_iterator p;
+	T e, t, c0;
+
+	t = 0.;
+	for (p=constraints.begin(); p!=constraints.end(); p++) {
+		using std::abs;
+		c0 = -(*p)(0);
+		if (c0 == 0.) continue;
+		e = c0;
+		for (j=1; j<=n && j<(int)(*p).size(); j++) {
+			e += abs((*p)(j) * x(j-1));
+		}
+		if (e > t * c0) t = e / c0;
+	}
+	t *= k * std::numeric_limits<T>::epsilon();
+
+	for (j=0; j<n; j++) x(j) *= 1. - t;
+}
+
+// the tableau version of lp_minimize used before. used if the revised
+// simplex method fails.
+
+template <class T> inline T tableau_minimize(const ub::vector<T>& objfunc, const std::list< ub::vector<T> >& constraints)
 {
 	int i, j;
 	int m = constraints.size();
@@ -26,7 +556,7 @@ template <class T> inline T lp_minimize(ub::vector<T>& objfunc, std::list< ub::v
 	int n = lp_n + m;
 	int pivot_i, pivot_j;
 	T tmp, minmax;
-	typename std::list< ub::vector<T> >::iterator p;
+	typename std::list< ub::vector<T> >::const_iterator p;
 
 	ub::matrix<T> a(m+1, n+1);
 
@@ -115,7 +645,11 @@ template <class T> inline T lp_minimize(ub::vector<T>& objfunc, std::list< ub::v
 	return a(0, 0);
 }
 
-template <class T> inline T lp_minimize_verified(ub::vector<T>& objfunc, std::list< ub::vector<T> >& constraints, int round)
+// the tableau version of lp_minimize_verified used before. the
+// tableau is updated with directed rounding. used if the bounds
+// above fail.
+
+template <class T> inline T tableau_minimize_verified(const ub::vector<T>& objfunc, const std::list< ub::vector<T> >& constraints, int round)
 {
 	int i, j;
 	int m = constraints.size();
@@ -123,7 +657,7 @@ template <class T> inline T lp_minimize_verified(ub::vector<T>& objfunc, std::li
 	int n = lp_n + m;
 	int pivot_i, pivot_j;
 	T tmp, minmax;
-	typename std::list< ub::vector<T> >::iterator p;
+	typename std::list< ub::vector<T> >::const_iterator p;
 	interval<T> Itmp, Imin;
 
 	ub::matrix<T> a(m+1, n+1);
@@ -262,6 +796,91 @@ template <class T> inline T lp_minimize_verified(ub::vector<T>& objfunc, std::li
 	return a(0, 0);
 }
 
+} // namespace lp_sub
+
+
+// minimize objfunc(0) + objfunc(1) x_1 + ... + objfunc(n) x_n
+// subject to x_j >= 0, c(0) + c(1) x_1 + ... + c(n) x_n <= 0 for c
+// in constraints (c(0) <= 0).
+
+template <class T> inline T lp_minimize(ub::vector<T>& objfunc, std::list< ub::vector<T> >& constraints)
+{
+	lp_sub::revised_simplex<T> lp(objfunc, constraints);
+
+	try {
+		return lp.solve();
+	}
+	catch (std::domain_error& e) {
+		// the tableau version throws again if there is no optimal
+		// solution
+		return lp_sub::tableau_minimize(objfunc, constraints);
+	}
+}
+
+// same as lp_minimize, but the result is rounded downward (round = -1)
+// or upward (round = 1).
+//
+//  the problem is solved approximately by lp_minimize and only the
+//  final basis is verified: the lower bound is given by the weak
+//  duality from the dual solution and the upper bound is the value at
+//  the primal solution (moved slightly inside if necessary) if it is
+//  proved to be feasible. if these fail (e.g. unbounded variable with
+//  a negative reduced cost, or active constraints with c(0) = 0) or
+//  the revised simplex method fails, the tableau method with directed
+//  rounding is used.
+//  if dual is not NULL, the (approximate) dual solution, which can be
+//  given to lp_lower_bound, is stored (only if the revised simplex
+//  method succeeds).
+
+template <class T> inline T lp_minimize_verified(ub::vector<T>& objfunc, std::list< ub::vector<T> >& constraints, int round, ub::vector<T>* dual = NULL)
+{
+	lp_sub::revised_simplex<T> lp(objfunc, constraints);
+	ub::vector<T> d, x, x2;
+	T r, k;
+
+	try {
+		lp.solve();
+		lp.dual(d);
+		if (dual != NULL) *dual = d;
+
+		if (round == -1) {
+			if (lp_sub::dual_bound(objfunc, constraints, d, (const ub::vector<T>*)NULL, r)) return r;
+		} else {
+			lp.primal(x);
+			if (lp_sub::primal_bound(objfunc, constraints, x, r)) return r;
+			for (k=0.125; k<=64.; k*=2.) {
+				x2 = x;
+				lp_sub::shrink(constraints, x2, k);
+				if (lp_sub::primal_bound(objfunc, constraints, x2, r)) return r;
+			}
+		}
+	}
+	catch (std::domain_error& e) {
+		// singular basis, too many iterations or no optimal
+		// solution. the tableau version decides.
+	}
+
+	return lp_sub::tableau_minimize_verified(objfunc, constraints, round);
+}
+
+// rigorous lower bound of the minimum of lp_minimize_verified for
+// 0 <= x_j <= xmax by the weak duality. any dual >= 0 gives a lower
+// bound, so the dual solution of a similar problem (e.g. of the
+// previous box in branch and bound) can be used without solving.
+
+template <class T> inline T lp_lower_bound(const ub::vector<T>& objfunc, const std::list< ub::vector<T> >& constraints, const ub::vector<T>& dual, const T& xmax)
+{
+	ub::vector<T> xm;
+	T r;
+
+	if ((int)dual.size() != (int)constraints.size()) return -std::numeric_limits<T>::infinity();
+
+	xm = ub::scalar_vector<T>(objfunc.size() - 1, xmax);
+	if (!lp_sub::dual_bound(objfunc, constraints, dual, &xm, r)) return -std::numeric_limits<T>::infinity();
+
+	return r;
+}
+
 } // namespace kv
 
 #endif // LP_HPP
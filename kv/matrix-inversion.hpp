@@ -135,8 +135,8 @@ void mm_mult(const ub::matrix<T>& a, const ub::matrix<T>& b, ub::matrix<T>& c) {
 template <>
 void mm_mult(const ub::matrix<double>& a, const ub::matrix<double>& b, ub::matrix<double>& c) {
 	ub::matrix<double, ub::column_major> ca(a);
-	ub::matrix<double, ub::column_major> cb(a);
-	ub::matrix<double, ub::column_major> cc(c);
+	ub::matrix<double, ub::column_major> cb(b);
+	ub::matrix<double, ub::column_major> cc(a.size1(), b.size2());
 
 	#ifdef USE_LAPACK
 		bnb::blas::gemm(ca, cb, cc);
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2015 Masahide Kashiwagi (kashi@waseda.jp)
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
  */
 
 #ifndef MPFR_HPP
@@ -12,6 +12,20 @@
 #include <kv/constants.hpp>
 #include <mpfr.h>
 
+/*
+ * storage of the significand of mpfr<N>
+ *
+ *  0: allocated by mpfr_init2 and freed by mpfr_clear
+ *  1: kept in the object itself by the custom interface of MPFR
+ *     (mpfr_custom_init_set), so that construction and destruction
+ *     of mpfr<N> (and all the temporaries of rop< mpfr<N> >) do not
+ *     allocate memory. (default)
+ */
+
+#ifndef MPFR_INLINE
+#define MPFR_INLINE 1
+#endif
+
 namespace kv {
 
 template <int N> class mpfr;
@@ -30,29 +44,47 @@ template <int N = 53> class mpfr {
 	public:
 	mpfr_t a;
 
-	mpfr () {
+	#if MPFR_INLINE
+	// a._mpfr_d points to this array, so the object must not be copied
+	// by memcpy. the copy constructor and the assignment operator copy
+	// the value only, and a moved object is copied in the same way.
+	mp_limb_t limb[(N + GMP_NUMB_BITS - 1) / GMP_NUMB_BITS];
+	#endif
+
+	void init_a() {
+		#if MPFR_INLINE
+		mpfr_custom_init(limb, N);
+		mpfr_custom_init_set(a, MPFR_ZERO_KIND, 0, N, limb);
+		#else
 		mpfr_init2(a, N);
+		#endif
+	}
+
+	mpfr () {
+		init_a();
 		mpfr_set_si(a, 0, MPFR_RNDN);
 	}
 
 	// copy constructor is needed
 	mpfr (const mpfr& x) {
-		mpfr_init2(a, N);
+		init_a();
 		mpfr_set(a, x.a, MPFR_RNDN);
 	}
 
 	template <class C> explicit mpfr(const C& x, typename boost::enable_if_c< acceptable_n<C, mpfr>::value >::type* =0) {
-		mpfr_init2(a, N);
+		init_a();
 		mpfr_set_d(a, (double)x, MPFR_RNDN);
 	}
 
 	template <class C> explicit mpfr(const C& x, typename boost::enable_if_c< acceptable_s<C, mpfr>::value >::type* =0) {
-		mpfr_init2(a, N);
+		init_a();
 		mpfr_set_str(a, std::string(x).c_str(), 10, MPFR_RNDN);
 	}
 
 	~mpfr () {
+		#if !MPFR_INLINE
 		mpfr_clear(a);
+		#endif
 	}
 
 	// assignment operator must be overloaded
@@ -61,6 +93,14 @@ template <int N = 53> class mpfr {
 		return *this;
 	}
 
+	#if __cplusplus >= 201103L && !MPFR_INLINE
+	// assignment from temporary exchanges the significands
+	mpfr& operator=(mpfr&& x) {
+		mpfr_swap(a, x.a);
+		return *this;
+	}
+	#endif
+
 	template <class C> typename boost::enable_if_c< acceptable_n<C, mpfr>::value, mpfr& >::type operator=(const C& x) {
 		mpfr_set_d(a, (double)x, MPFR_RNDN);
 		return *this;
@@ -0,0 +1,788 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef MPSA_HPP
+#define MPSA_HPP
+
+// Multivariate Power Series Arithmetic
+//
+// mpsa<T, D> is a truncated power series of D variables. Only the
+// monomials of total degree <= order are kept, and the coefficients are
+// stored in one contiguous vector in graded lexicographic order: degree
+// by degree, and inside the block of degree k the monomials
+// x1^a1 ... xD^aD are ordered by a1 descending and then recursively by
+// the remaining variables. For D = 2 and order 2 the order is
+//   1, x1, x2, x1^2, x1 x2, x2^2.
+//
+// The arithmetic corresponds to the mode 2 of psa. The terms of degree
+// higher than the order are not dropped but bounded on the domain
+// (domain(i) for the i-th variable) and added to the coefficients of
+// degree = order, so that the series encloses the function for every
+// point of the domain. Intended for interval coefficients, and used for
+// the double integrals instead of psa< psa<T> >.
+
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <stdexcept>
+#include <boost/numeric/ublas/vector.hpp>
+#include <kv/convert.hpp>
+#include <kv/interval.hpp>
+#include <kv/interval-blas.hpp>
+#include <kv/psa.hpp>
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+// kernel for the product of coefficient vectors.
+// r = a * b without truncation (total degree <= da + db).
+// for interval<T>, iblas::mconv is used.
+// contains_zero(x) tells whether the coefficient x may be 0 (used by div_tn).
+
+template <class T> struct mpsa_kernel {
+	template <class V> static void mconv(int d, const V& a, int da, const V& b, int db, V& r) {
+		int i;
+		int nr = iblas_sub::mono_size(d, da + db);
+
+		r.resize(nr);
+		for (i=0; i<nr; i++) r(i) = 0.;
+		mconv_rec(d, da, db, &a(0), &b(0), &r(0));
+	}
+
+	static void mconv_rec(int d, int da, int db, const T* a, const T* b, T* r) {
+		int p, q, oa, ob;
+
+		if (d == 1) {
+			for (p=0; p<=da; p++) {
+				for (q=0; q<=db; q++) {
+					r[p + q] += a[p] * b[q];
+				}
+			}
+			return;
+		}
+
+		for (p=0; p<=da; p++) {
+			oa = iblas_sub::mono_offset(d, p);
+			for (q=0; q<=db; q++) {
+				ob = iblas_sub::mono_offset(d, q);
+				mconv_rec(d - 1, p, q, a + oa, b + ob, r + iblas_sub::mono_offset(d, p + q));
+			}
+		}
+	}
+
+	static bool contains_zero(const T& x) {
+		return x == 0.;
+	}
+};
+
+template <class T> struct mpsa_kernel< interval<T> > {
+	template <class V> static void mconv(int d, const V& a, int da, const V& b, int db, V& r) {
+		iblas::mconv(d, a, da, b, db, r);
+	}
+
+	static bool contains_zero(const interval<T>& x) {
+		return zero_in(x);
+	}
+};
+
+
+// elementary functions applied to univariate psa by mpsa::taylor
+
+namespace mpsa_sub {
+	struct f_inv { template <class X> X operator()(const X& x) const { return 1. / x; } };
+	struct f_exp { template <class X> X operator()(const X& x) const { return exp(x); } };
+	struct f_log { template <class X> X operator()(const X& x) const { return log(x); } };
+	struct f_sqrt { template <class X> X operator()(const X& x) const { return sqrt(x); } };
+	struct f_sin { template <class X> X operator()(const X& x) const { return sin(x); } };
+	struct f_cos { template <class X> X operator()(const X& x) const { return cos(x); } };
+	struct f_tan { template <class X> X operator()(const X& x) const { return tan(x); } };
+	struct f_atan { template <class X> X operator()(const X& x) const { return atan(x); } };
+	struct f_sinh { template <class X> X operator()(const X& x) const { return sinh(x); } };
+	struct f_cosh { template <class X> X operator()(const X& x) const { return cosh(x); } };
+	struct f_tanh { template <class X> X operator()(const X& x) const { return tanh(x); } };
+	template <class T> struct f_pow {
+		T y;
+		f_pow(const T& y) : y(y) {}
+		template <class X> X operator()(const X& x) const { return pow(x, y); }
+	};
+}
+
+
+template <class T, int D> class mpsa;
+
+template <class C, class T, int D> struct convertible<C, mpsa<T, D> > {
+	static const bool value = convertible<C, T>::value || boost::is_same<C, mpsa<T, D> >::value;
+};
+
+template <class C, class T, int D> struct acceptable_n<C, mpsa<T, D> > {
+	static const bool value = convertible<C, T>::value;
+};
+
+
+template <class T, int D> class mpsa {
+	public:
+	typedef ub::vector<T> vector_type;
+
+	vector_type v;
+	int n; // order
+
+	typedef T base_type;
+
+	static T& domain(int i) {
+#ifdef _OPENMP // hack for non-POD thread local storage
+		static T* d = NULL;
+		#pragma omp threadprivate (d)
+		if (d == NULL) {
+			d = new T[D];
+		}
+		return d[i];
+#else
+		static T d[D];
+		return d[i];
+#endif
+	}
+
+	// the exponent of x_i which fold does not reduce. set it to m
+	// before computing a series which is divided by x_i^m (div_tn),
+	// preferably by keep_scope.
+
+	struct keep_table {
+		int k[D];
+	};
+
+	static int& keep(int i) {
+		static keep_table t;
+		#pragma omp threadprivate (t)
+		return t.k[i];
+	}
+
+	// raise keep(i) to at least m while the object lives. the old value
+	// is restored at the end of the scope, also when an exception is
+	// thrown.
+
+	class keep_scope {
+		int i, save;
+
+		keep_scope(const keep_scope&);
+		keep_scope& operator=(const keep_scope&);
+
+		public:
+
+		keep_scope(int i, int m) : i(i), save(keep(i)) {
+			keep(i) = std::max(save, m);
+		}
+
+		~keep_scope() {
+			keep(i) = save;
+		}
+	};
+
+	// number of coefficients of order n
+	static int size(int n) {
+		return iblas_sub::mono_size(D, n);
+	}
+
+	// position of x^a in v
+	static int index(const int* a) {
+		int i, s, r;
+
+		s = 0;
+		for (i=0; i<D; i++) s += a[i];
+		r = 0;
+		for (i=0; i<D; i++) {
+			r += iblas_sub::mono_offset(D - i, s);
+			s -= a[i];
+		}
+		return r;
+	}
+
+	// first monomial of degree k: x1^k
+	static void first(int* a, int k) {
+		int i;
+		a[0] = k;
+		for (i=1; i<D; i++) a[i] = 0;
+	}
+
+	// next monomial of the same degree in v. false after xD^k.
+	static bool next(int* a) {
+		int i, j, s;
+
+		for (i=D-2; i>=0; i--) {
+			if (a[i] > 0) break;
+		}
+		if (i < 0) return false;
+		a[i]--;
+		s = 1;
+		for (j=i+1; j<D; j++) {
+			s += a[j];
+			a[j] = 0;
+		}
+		a[i+1] = s;
+		return true;
+	}
+
+	mpsa() : n(0) {
+		v.resize(1);
+		v(0) = 0.;
+	}
+
+	template <class C> explicit mpsa(const C& x, typename boost::enable_if_c< acceptable_n<C, mpsa>::value >::type* =0) : n(0) {
+		v.resize(1);
+		v(0) = x;
+	}
+
+	template <class C> typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa& >::type operator=(const C& x) {
+		n = 0;
+		v.resize(1);
+		v(0) = x;
+		return *this;
+	}
+
+	// c + x_i as a series of order n
+	static mpsa variable(const T& c, int i, int n) {
+		mpsa r;
+		int k;
+		int a[D];
+
+		r.n = n;
+		r.v.resize(size(n));
+		for (k=0; k<r.v.size(); k++) r.v(k) = 0.;
+		r.v(0) = c;
+		if (n >= 1) {
+			first(a, 0);
+			a[i] = 1;
+			r.v(index(a)) = 1.;
+		}
+		return r;
+	}
+
+	// r = a (order na) as a series of order n.
+	// if na > n, the terms of degree m > n are x^s = x^t x^u with
+	// |t| = n. x^u is bounded on the domain and the term is added to
+	// the coefficient of x^t. u is taken from the exponents of s
+	// exceeding keep(i) most, so that t keeps the factor
+	// x_i^min(s_i, keep(i)) which div_tn relies on. this is possible
+	// if the sum of keep(i) is <= n.
+
+	static void fold(const vector_type& a, int na, int n, vector_type& r) {
+		int i, j, k, m, e, im;
+		int s[D], t[D];
+		int ne = na - n;
+		int ns = size(n);
+		T f;
+
+		r.resize(ns);
+		if (na <= n) {
+			for (k=0; k<a.size(); k++) r(k) = a(k);
+			for (k=a.size(); k<ns; k++) r(k) = 0.;
+			return;
+		}
+		for (k=0; k<ns; k++) r(k) = a(k);
+
+		// pw[i * (ne + 1) + j] = domain(i)^j
+		std::vector<T> pw(D * (ne + 1));
+		for (i=0; i<D; i++) {
+			pw[i * (ne + 1)] = 1.;
+			for (j=1; j<=ne; j++) pw[i * (ne + 1) + j] = pow(domain(i), j);
+		}
+
+		k = ns;
+		for (m=n+1; m<=na; m++) {
+			first(s, m);
+			do {
+				for (i=0; i<D; i++) t[i] = s[i];
+				for (e=m-n; e>0; e--) {
+					im = 0;
+					for (i=1; i<D; i++) {
+						if (t[i] - keep(i) > t[im] - keep(im)) im = i;
+					}
+					t[im]--;
+				}
+				f = pw[s[0] - t[0]];
+				for (i=1; i<D; i++) f *= pw[i * (ne + 1) + s[i] - t[i]];
+				r(index(t)) += a(k) * f;
+				k++;
+			} while (next(s));
+		}
+	}
+
+	friend mpsa setorder(const mpsa& x, int n) {
+		mpsa r;
+
+		r.n = n;
+		fold(x.v, x.n, n, r.v);
+		return r;
+	}
+
+	friend mpsa operator+(const mpsa& a, const mpsa& b) {
+		mpsa r;
+		int k;
+
+		if (a.n == b.n) {
+			r.n = a.n;
+			r.v = a.v + b.v;
+		} else if (a.n < b.n) {
+			r = b;
+			for (k=0; k<a.v.size(); k++) r.v(k) += a.v(k);
+		} else {
+			r = a;
+			for (k=0; k<b.v.size(); k++) r.v(k) += b.v(k);
+		}
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa >::type operator+(const mpsa& a, const C& b) {
+		mpsa r(a);
+		r.v(0) += b;
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa >::type operator+(const C& a, const mpsa& b) {
+		mpsa r(b);
+		r.v(0) += a;
+		return r;
+	}
+
+	friend mpsa& operator+=(mpsa& a, const mpsa& b) {
+		a = a + b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa& >::type operator+=(mpsa& a, const C& b) {
+		a.v(0) += b;
+		return a;
+	}
+
+	friend mpsa operator-(const mpsa& a, const mpsa& b) {
+		mpsa r;
+		int k;
+
+		if (a.n == b.n) {
+			r.n = a.n;
+			r.v = a.v - b.v;
+		} else if (a.n < b.n) {
+			r.n = b.n;
+			r.v = - b.v;
+			for (k=0; k<a.v.size(); k++) r.v(k) += a.v(k);
+		} else {
+			r = a;
+			for (k=0; k<b.v.size(); k++) r.v(k) -= b.v(k);
+		}
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa >::type operator-(const mpsa& a, const C& b) {
+		mpsa r(a);
+		r.v(0) -= b;
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa >::type operator-(const C& a, const mpsa& b) {
+		mpsa r;
+		r.n = b.n;
+		r.v = - b.v;
+		r.v(0) += a;
+		return r;
+	}
+
+	friend mpsa& operator-=(mpsa& a, const mpsa& b) {
+		a = a - b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa& >::type operator-=(mpsa& a, const C& b) {
+		a.v(0) -= b;
+		return a;
+	}
+
+	friend mpsa operator-(const mpsa& a) {
+		mpsa r;
+		r.n = a.n;
+		r.v = - a.v;
+		return r;
+	}
+
+	// the product is computed without truncation and then folded to
+	// the larger order of a and b.
+
+	friend mpsa operator*(const mpsa& a, const mpsa& b) {
+		mpsa r;
+		vector_type tmp;
+
+		if (a.n == 0) return b * a.v(0);
+		if (b.n == 0) return a * b.v(0);
+
+		mpsa_kernel<T>::mconv(D, a.v, a.n, b.v, b.n, tmp);
+		r.n = std::max(a.n, b.n);
+		fold(tmp, a.n + b.n, r.n, r.v);
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa >::type operator*(const mpsa& a, const C& b) {
+		mpsa r;
+		r.n = a.n;
+		r.v = a.v * T(b);
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa >::type operator*(const C& a, const mpsa& b) {
+		mpsa r;
+		r.n = b.n;
+		r.v = T(a) * b.v;
+		return r;
+	}
+
+	friend mpsa& operator*=(mpsa& a, const mpsa& b) {
+		a = a * b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa& >::type operator*=(mpsa& a, const C& b) {
+		a.v *= T(b);
+		return a;
+	}
+
+	friend mpsa operator/(const mpsa& a, const mpsa& b) {
+		return a * inv(b);
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa >::type operator/(const mpsa& a, const C& b) {
+		mpsa r;
+		r.n = a.n;
+		r.v = a.v / T(b);
+		return r;
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa >::type operator/(const C& a, const mpsa& b) {
+		return a * inv(b);
+	}
+
+	friend mpsa& operator/=(mpsa& a, const mpsa& b) {
+		a = a / b;
+		return a;
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa& >::type operator/=(mpsa& a, const C& b) {
+		a.v /= T(b);
+		return a;
+	}
+
+	/*
+	 * f(x) for x = a + h (a = x.v(0)) by
+	 *   f(x) = sum_{i=0}^{2n-1} f^(i)(a)/i! h^i + f^(2n)(xi)/(2n)! h^2n
+	 * where xi is in the range of x on the domain. h^i (i >= n) is
+	 * folded into the terms of degree n, but the expansion is continued
+	 * to 2n since the remainder with the range of x is much wider than
+	 * the terms with the derivatives at a. the coefficients are
+	 * computed by univariate psa (mode 1), the sum by Horner's method.
+	 */
+
+	template <class F> static mpsa taylor(const mpsa& x, F f) {
+		int i;
+		int n = x.n;
+		int nr = 2 * n;
+		psa<T> p, q;
+		mpsa h, r;
+		int save_mode;
+		bool save_uh, save_rh;
+
+		if (n == 0) return mpsa(f(x.v(0)));
+
+		p.v.resize(nr+1);
+		q.v.resize(nr+1);
+		for (i=0; i<=nr; i++) {
+			p.v(i) = 0.;
+			q.v(i) = 0.;
+		}
+		p.v(0) = x.v(0);
+		p.v(1) = 1.;
+		q.v(0) = evalrange(x);
+		q.v(1) = 1.;
+
+		save_mode = psa<T>::mode();
+		save_uh = psa<T>::use_history();
+		save_rh = psa<T>::record_history();
+		psa<T>::mode() = 1;
+		psa<T>::use_history() = false;
+		psa<T>::record_history() = false;
+
+		p = f(p);
+		q = f(q);
+
+		psa<T>::mode() = save_mode;
+		psa<T>::use_history() = save_uh;
+		psa<T>::record_history() = save_rh;
+
+		h = x;
+		h.v(0) = 0.;
+
+		r = q.v(nr);
+		for (i=nr-1; i>=0; i--) {
+			r = r * h + p.v(i);
+		}
+		return r;
+	}
+
+	friend mpsa inv(const mpsa& x) {
+		return taylor(x, mpsa_sub::f_inv());
+	}
+
+	friend mpsa exp(const mpsa& x) {
+		return taylor(x, mpsa_sub::f_exp());
+	}
+
+	friend mpsa log(const mpsa& x) {
+		return taylor(x, mpsa_sub::f_log());
+	}
+
+	friend mpsa sqrt(const mpsa& x) {
+		return taylor(x, mpsa_sub::f_sqrt());
+	}
+
+	friend mpsa sin(const mpsa& x) {
+		return taylor(x, mpsa_sub::f_sin());
+	}
+
+	friend mpsa cos(const mpsa& x) {
+		return taylor(x, mpsa_sub::f_cos());
+	}
+
+	friend mpsa tan(const mpsa& x) {
+		return taylor(x, mpsa_sub::f_tan());
+	}
+
+	friend mpsa atan(const mpsa& x) {
+		return taylor(x, mpsa_sub::f_atan());
+	}
+
+	friend mpsa sinh(const mpsa& x) {
+		return taylor(x, mpsa_sub::f_sinh());
+	}
+
+	friend mpsa cosh(const mpsa& x) {
+		return taylor(x, mpsa_sub::f_cosh());
+	}
+
+	friend mpsa tanh(const mpsa& x) {
+		return taylor(x, mpsa_sub::f_tanh());
+	}
+
+	friend mpsa pow(const mpsa& x, int y) {
+		mpsa r, xp;
+		int a, tmp;
+
+		if (y == 0) return mpsa(1.);
+
+		a = (y >= 0) ? y : -y;
+
+		tmp = a;
+		r = 1.;
+		xp = x;
+		while (tmp != 0) {
+			if (tmp % 2 != 0) {
+				r *= xp;
+			}
+			tmp /= 2;
+			if (tmp != 0) xp = xp * xp;
+		}
+
+		if (y < 0) {
+			r = inv(r);
+		}
+
+		return r;
+	}
+
+	friend mpsa pow(const mpsa& x, const mpsa& y) {
+		return exp(y * log(x));
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa >::type pow(const mpsa& x, const C& y) {
+		return taylor(x, mpsa_sub::f_pow<T>(T(y)));
+	}
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa >::type pow(const C& x, const mpsa& y) {
+		return exp(y * log(T(x)));
+	}
+
+	// range of x on the domain
+
+	friend T evalrange(const mpsa& x) {
+		int i, j, k, m;
+		int a[D];
+		T r, tmp;
+
+		std::vector<T> pw(D * (x.n + 1));
+		for (i=0; i<D; i++) {
+			pw[i * (x.n + 1)] = 1.;
+			for (j=1; j<=x.n; j++) pw[i * (x.n + 1) + j] = pow(domain(i), j);
+		}
+
+		r = x.v(0);
+		k = 1;
+		for (m=1; m<=x.n; m++) {
+			first(a, m);
+			do {
+				tmp = x.v(k);
+				for (i=0; i<D; i++) {
+					if (a[i] != 0) tmp *= pw[i * (x.n + 1) + a[i]];
+				}
+				r += tmp;
+				k++;
+			} while (next(a));
+		}
+		return r;
+	}
+
+	// indefinite integral with respect to x_i (zero at x_i = 0).
+	// the order increases by one.
+
+	friend mpsa integrate(const mpsa& x, int i) {
+		mpsa r;
+		int k, m;
+		int a[D];
+
+		r.n = x.n + 1;
+		r.v.resize(size(r.n));
+		for (k=0; k<r.v.size(); k++) r.v(k) = 0.;
+
+		k = 0;
+		for (m=0; m<=x.n; m++) {
+			first(a, m);
+			do {
+				a[i]++;
+				r.v(index(a)) = x.v(k) / (double)a[i];
+				a[i]--;
+				k++;
+			} while (next(a));
+		}
+		return r;
+	}
+
+	// x / x_i^m assuming that the coefficients of x_i^j (j < m) are 0.
+	// x must be computed with keep(i) >= m, otherwise fold may have
+	// merged such coefficients into the others.
+	// throws std::domain_error if keep(i) < m or if a coefficient of
+	// x_i^j (j < m) does not contain 0.
+
+	friend mpsa div_tn(const mpsa& x, int i, int m) {
+		mpsa r;
+		int k, l;
+		int a[D];
+
+		if (m == 0) return x;
+
+		if (keep(i) < m) {
+			throw std::domain_error("mpsa: div_tn needs keep(i) >= m");
+		}
+
+		r.n = std::max(x.n - m, 0);
+		r.v.resize(size(r.n));
+		for (k=0; k<r.v.size(); k++) r.v(k) = 0.;
+
+		k = 0;
+		for (l=0; l<=x.n; l++) {
+			first(a, l);
+			do {
+				if (a[i] >= m) {
+					a[i] -= m;
+					r.v(index(a)) = x.v(k);
+					a[i] += m;
+				} else if (!mpsa_kernel<T>::contains_zero(x.v(k))) {
+					throw std::domain_error("mpsa: div_tn of nonzero coefficient");
+				}
+				k++;
+			} while (next(a));
+		}
+		return r;
+	}
+
+	// x / x_1^m, corresponds to div_tn for psa
+
+	friend mpsa div_tn(const mpsa& x, int m) {
+		return div_tn(x, 0, m);
+	}
+
+	// substitute c for x_i. the result does not depend on x_i.
+
+	template <class C> friend typename boost::enable_if_c< acceptable_n<C, mpsa>::value, mpsa >::type eval(const mpsa& x, int i, const C& c) {
+		mpsa r;
+		int j, k, m;
+		int a[D], ai;
+
+		std::vector<T> pw(x.n + 1);
+		pw[0] = 1.;
+		for (j=1; j<=x.n; j++) pw[j] = pw[j-1] * T(c);
+
+		r.n = x.n;
+		r.v.resize(x.v.size());
+		for (k=0; k<r.v.size(); k++) r.v(k) = 0.;
+
+		k = 0;
+		for (m=0; m<=x.n; m++) {
+			first(a, m);
+			do {
+				ai = a[i];
+				a[i] = 0;
+				r.v(index(a)) += x.v(k) * pw[ai];
+				a[i] = ai;
+				k++;
+			} while (next(a));
+		}
+		return r;
+	}
+
+	// substitute u for x_i by Horner's method with respect to x_i.
+	// the range of u on the domain must be contained in domain(i).
+
+	friend mpsa eval(const mpsa& x, int i, const mpsa& u) {
+		mpsa r;
+		std::vector<mpsa> p(x.n + 1);
+		int j, k, m;
+		int a[D], ai;
+
+		for (j=0; j<=x.n; j++) {
+			p[j].n = x.n;
+			p[j].v.resize(x.v.size());
+			for (k=0; k<x.v.size(); k++) p[j].v(k) = 0.;
+		}
+
+		k = 0;
+		for (m=0; m<=x.n; m++) {
+			first(a, m);
+			do {
+				ai = a[i];
+				a[i] = 0;
+				p[ai].v(index(a)) = x.v(k);
+				a[i] = ai;
+				k++;
+			} while (next(a));
+		}
+
+		r = p[x.n];
+		for (j=x.n-1; j>=0; j--) {
+			r = r * u + p[j];
+		}
+		return r;
+	}
+
+	friend std::ostream& operator<<(std::ostream& s, const mpsa& x) {
+		int i;
+		int n = x.v.size();
+		s << '[';
+		s << x.v(0);
+		for (i=1; i<n; i++) {
+			s << ',';
+			s << x.v(i);
+		}
+		s << ']';
+		return s;
+	}
+};
+
+} // namespace kv
+
+#endif // MPSA_HPP
@@ -83,6 +83,11 @@ ode_affine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interva
 
 	int maxnum_save = affine<T>::maxnum();
 
+	#if AFFINE_REGISTRY
+	// noise symbols of the temporaries of this step
+	affine_compaction<T> compaction;
+	#endif
+
 	bool save_mode, save_uh, save_rh;
 
 
@@ -9,6 +9,7 @@
 
 #include <kv/ode.hpp>
 #include <kv/autodif.hpp>
+#include <kv/jet.hpp>
 
 
 #ifndef ODE_AUTODIF_NEW
@@ -171,29 +172,46 @@ ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, i
 #define ODE_CORF_MID 0
 #endif
 
+/*
+ * coefficients of the Taylor series with the Jacobian (see ode-lohner.hpp)
+ *
+ *  0: autodif< interval<T> >
+ *  n: jet< interval<T>, n > for systems of at most n equations
+ */
 
-template <class T, class F>
+#ifndef ODE_JET_MAX
+#define ODE_JET_MAX 8
+#endif
+
+
+namespace ode_autodif_sub {
+
+// ode for autodif with the coefficients of type D, which is
+// autodif< interval<T> > or jet< interval<T>, N >.
+
+template <class D, class T, class F>
 int
-ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, interval<T>& end, ode_param<T> p = ode_param<T>(), ub::vector< psa< interval<T> > >* result_psa = NULL) {
+solve(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, interval<T>& end, ode_param<T> p, ub::vector< psa< interval<T> > >* result_psa) {
 	int n = init.size();
 	int i, j, k, km;
 
-	ub::vector< psa< autodif< interval<T> > > > x, y;
-	psa< autodif< interval<T> > > torg;
-	psa< autodif< interval<T> > > t;
+	ub::vector< psa< D > > x, y;
+	psa< D > torg;
+	psa< D > t;
 
-	ub::vector< psa< autodif< interval<T> > > > z, w;
-	autodif< interval<T> > wmz;
-	autodif< interval<T> > evalz;
+	ub::vector< psa< D > > z, w;
+	D wmz;
+	D evalz;
 
-	psa< autodif< interval<T> > > temp;
+	psa< D > temp;
 	T m;
 	ub::vector<T> newton_step;
 
 	bool flag, resized;
 
 	interval<T> deltat;
-	ub::vector< autodif< interval<T> > > result, new_init;
+	ub::vector< D > new_init;
+	ub::vector< autodif< interval<T> > > c, result;
 
 	T radius, radius_tmp;
 	T tolerance;
@@ -207,10 +225,13 @@ ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, i
 	int restart;
 
 	ub::matrix< interval<T> > save;
+	ub::vector< psa< autodif< interval<T> > > > wa;
 
 	bool save_mode, save_uh, save_rh;
 
-	new_init = autodif< interval<T> >::compress(init, save);
+	c = autodif< interval<T> >::compress(init, save);
+	new_init.resize(n);
+	for (i=0; i<n; i++) new_init(i) = D(c(i));
 
 	m = 1.;
 	for (i=0; i<n; i++) {
@@ -226,19 +247,19 @@ ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, i
 	torg.v.resize(2);
 	torg.v(0) = start; torg.v(1) = 1.;
 
-	save_mode = psa< autodif< interval<T> > >::mode();
-	save_uh = psa< autodif< interval<T> > >::use_history();
-	save_rh = psa< autodif< interval<T> > >::record_history();
-	psa< autodif< interval<T> > >::mode() = 1;
-	psa< autodif< interval<T> > >::use_history() = false;
-	psa< autodif< interval<T> > >::record_history() = false;
+	save_mode = psa< D >::mode();
+	save_uh = psa< D >::use_history();
+	save_rh = psa< D >::record_history();
+	psa< D >::mode() = 1;
+	psa< D >::use_history() = false;
+	psa< D >::record_history() = false;
 	#if ODE_FAST == 1
-	psa< autodif< interval<T> > >::record_history() = true;
-	psa< autodif< interval<T> > >::history().clear();
+	psa< D >::record_history() = true;
+	psa< D >::history().clear();
 	#endif
 	for (j=0; j<p.order; j++) {
 		#if ODE_FAST == 1
-		if (j == 1) psa< autodif< interval<T> > >::use_history() = true;
+		if (j == 1) psa< D >::use_history() = true;
 		#endif
 		t = setorder(torg, j);
 		y = f(x, t);
@@ -282,7 +303,7 @@ ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, i
 		radius = std::pow((double)tolerance, 1./p.order) / radius;
 	}
 
-	psa< autodif< interval<T> > >::mode() = 2;
+	psa< D >::mode() = 2;
 
 	restart = 0;
 	resized = false;
@@ -303,7 +324,7 @@ ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, i
 		}
 		deltat = end2 - start;
 
-		psa< autodif< interval<T> > >::domain() = interval<T>(0., deltat.upper());
+		psa< D >::domain() = interval<T>(0., deltat.upper());
 
 		z = x;
 		t = setorder(torg, p.order);
@@ -313,7 +334,7 @@ ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, i
 		}
 		catch (std::domain_error& e) {
 			if (p.autostep && restart < p.restart_max) {
-				psa< autodif< interval<T> > >::use_history() = false;
+				psa< D >::use_history() = false;
 				if (p.verbose == 1) {
 					std::cout << "ode: radius changed: " << radius;
 				}
@@ -360,7 +381,7 @@ ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, i
 			resized = true;
 			m = (std::numeric_limits<T>::min)();
 			for (i=0; i<n; i++) {
-				evalz = eval(z(i), autodif< interval<T> >(deltat));
+				evalz = eval(z(i), D(deltat));
 				m = std::max(m, rad(evalz.v) - rad(new_init(i).v));
 				evalz.d.resize(n);
 				for (j=0; j<n; j++) {
@@ -439,16 +460,18 @@ ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, i
 			}
 		}
 
+		wa.resize(n);
 		for (i=0; i<n; i++) {
+			wa(i).v.resize(p.order+1);
 			for (j=0; j<=p.order; j++) {
 				w(i).v(j).d.resize(n);
-				w(i).v(j) = autodif< interval<T> >::expand(w(i).v(j), save);
+				wa(i).v(j) = autodif< interval<T> >::expand(to_autodif(w(i).v(j)), save);
 			}
 		}
 
 		result.resize(n);
 		for (i=0; i<n; i++) {
-			result(i) = eval(w(i), (autodif< interval<T> >)deltat);
+			result(i) = eval(wa(i), (autodif< interval<T> >)deltat);
 		}
 
 		init = result;
@@ -457,21 +480,34 @@ ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, i
 			// store w to *result_psa without autodif information
 			(*result_psa).resize(n);
 			for (i=0; i<n; i++) {
-				(*result_psa)(i).v.resize(w(i).v.size());
-				for (j=0; j<w(i).v.size(); j++) {
-					(*result_psa)(i).v(j) = w(i).v(j).v;
+				(*result_psa)(i).v.resize(wa(i).v.size());
+				for (j=0; j<wa(i).v.size(); j++) {
+					(*result_psa)(i).v(j) = wa(i).v(j).v;
 				}
 			}
 		}
 	}
 
-	psa< autodif< interval<T> > >::mode() = save_mode;
-	psa< autodif< interval<T> > >::use_history() = save_uh;
-	psa< autodif< interval<T> > >::record_history() = save_rh;
+	psa< D >::mode() = save_mode;
+	psa< D >::use_history() = save_uh;
+	psa< D >::record_history() = save_rh;
 
 	return ret_val;
 }
 
+} // namespace ode_autodif_sub
+
+template <class T, class F>
+int
+ode(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, interval<T>& end, ode_param<T> p = ode_param<T>(), ub::vector< psa< interval<T> > >* result_psa = NULL) {
+	#if ODE_JET_MAX > 0
+	if (init.size() <= ODE_JET_MAX) {
+		return ode_autodif_sub::solve< jet< interval<T>, ODE_JET_MAX > >(f, init, start, end, p, result_psa);
+	}
+	#endif
+	return ode_autodif_sub::solve< autodif< interval<T> > >(f, init, start, end, p, result_psa);
+}
+
 #endif
 
 
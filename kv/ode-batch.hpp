@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef ODE_BATCH_HPP
+#define ODE_BATCH_HPP
+
+//
+// integrate many initial boxes of the same ODE
+//
+//  odelong_batch(f, init, start, end, status, reached, p)
+//  odelong_maffine_batch(f, init, start, end, status, reached, p)
+//
+//  init[i] is replaced by the result of odelong / odelong_maffine
+//  for the i-th box, status[i] is its return value (0, 1 or 2) and
+//  reached[i] is the time reached (end if status[i] == 2, start if
+//  status[i] == 0). the return value is the number of boxes which
+//  reached end.
+//
+//  with OpenMP, the boxes are distributed to the threads dynamically
+//  one by one, since the number of steps varies widely among boxes.
+//  the global states of psa and affine are thread local, so each box
+//  gives the same result as the serial loop. an exception other than
+//  std::domain_error is rethrown after all the boxes are processed.
+//  before C++11 there is no std::exception_ptr, so it is thrown at once
+//  if OpenMP is disabled, and otherwise std::runtime_error with the
+//  message of the exception is thrown instead.
+//
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <exception>
+#include <boost/numeric/ublas/vector.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/ode.hpp>
+#include <kv/ode-maffine.hpp>
+#include <kv/ode-param.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+namespace ode_batch_sub {
+
+struct odelong_solver {
+	template <class T, class F> int operator()(F& f, ub::vector< interval<T> >& x, const interval<T>& start, interval<T>& end, const ode_param<T>& p) const {
+		return odelong(f, x, start, end, p);
+	}
+};
+
+struct odelong_maffine_solver {
+	template <class T, class F> int operator()(F& f, ub::vector< interval<T> >& x, const interval<T>& start, interval<T>& end, const ode_param<T>& p) const {
+		return odelong_maffine(f, x, start, end, p);
+	}
+};
+
+template <class T, class F, class S>
+int
+run(
+	S solver,
+	F f,
+	std::vector< ub::vector< interval<T> > >& init,
+	const interval<T>& start,
+	const interval<T>& end,
+	std::vector<int>& status,
+	std::vector< interval<T> >& reached,
+	ode_param<T> p
+) {
+	int n = init.size();
+	int i;
+	int count = 0;
+	int verbose = p.verbose;
+	int err = n;
+	#if __cplusplus >= 201103L
+	std::exception_ptr error;
+	#else
+	std::string error;
+	#endif
+
+	status.resize(n);
+	reached.resize(n);
+
+	// the output of each box would be mixed up
+	p.set_verbose(0);
+
+	#ifdef _OPENMP
+	bool par = !omp_in_parallel();
+	#endif
+	#pragma omp parallel if (par)
+	{
+	// the function object may have its own work area
+	F g(f);
+	ub::vector< interval<T> > x;
+	interval<T> t;
+	int r;
+
+	#pragma omp for schedule(dynamic, 1) reduction(+:count)
+	for (i=0; i<n; i++) {
+		x = init[i];
+		t = end;
+		try {
+			r = solver(g, x, start, t, p);
+		}
+		catch (std::domain_error& e) {
+			r = 0;
+		}
+		catch (...) {
+			#if __cplusplus < 201103L && !defined(_OPENMP)
+			throw;
+			#else
+			// keep the error of the first box as the serial loop,
+			// and rethrow it after the parallel region
+			#pragma omp critical (ode_batch)
+			if (i < err) {
+				err = i;
+				#if __cplusplus >= 201103L
+				error = std::current_exception();
+				#else
+				try {
+					throw;
+				}
+				catch (std::exception& e) {
+					error = e.what();
+				}
+				catch (...) {
+					error = "odelong_batch: unknown exception";
+				}
+				#endif
+			}
+			continue;
+			#endif
+		}
+		if (r == 0) t = start;
+		if (r == 2) count++;
+		init[i] = x;
+		status[i] = r;
+		reached[i] = t;
+		if (verbose == 1) {
+			#pragma omp critical (cout)
+			{
+			std::cout << "box " << i << ": " << r << ", t: " << t << "\n";
+			}
+		}
+	}
+	}
+
+	#if __cplusplus >= 201103L
+	if (err < n) std::rethrow_exception(error);
+	#else
+	if (err < n) throw std::runtime_error(error);
+	#endif
+
+	return count;
+}
+
+} // namespace ode_batch_sub
+
+
+template <class T, class F>
+int
+odelong_batch(
+	F f,
+	std::vector< ub::vector< interval<T> > >& init,
+	const interval<T>& start,
+	const interval<T>& end,
+	std::vector<int>& status,
+	std::vector< interval<T> >& reached,
+	ode_param<T> p = ode_param<T>()
+) {
+	return ode_batch_sub::run(ode_batch_sub::odelong_solver(), f, init, start, end, status, reached, p);
+}
+
+template <class T, class F>
+int
+odelong_maffine_batch(
+	F f,
+	std::vector< ub::vector< interval<T> > >& init,
+	const interval<T>& start,
+	const interval<T>& end,
+	std::vector<int>& status,
+	std::vector< interval<T> >& reached,
+	ode_param<T> p = ode_param<T>()
+) {
+	return ode_batch_sub::run(ode_batch_sub::odelong_maffine_solver(), f, init, start, end, status, reached, p);
+}
+
+} // namespace kv
+
+#endif // ODE_BATCH_HPP
@@ -28,15 +28,13 @@ template <class T> struct ode_callback_dense_print : ode_callback<T> {
 		int i, j;
 		interval<T> t;
 		ub::vector< interval<T> > y;
-		psa< interval <T> > tmp;
 		int s = result.size();
 		y.resize(s);
 
 		for (i = (int)ceil(((start - start_g) / step).lower()); i<=(int)floor(((end - start_g) / step).upper()); i++) {
 			t = start_g + step * i - start;
 			for (j=0; j<s; j++) {
-				tmp = result(j);
-				y(j) = eval(tmp, t);
+				y(j) = eval(result(j), t);
 			}
 			std::cout << "t: " << start + t << "\n";
 			std::cout << y << "\n";
@@ -76,15 +74,13 @@ template <class T> struct ode_callback_dense_list : ode_callback<T> {
 		int i, j;
 		interval<T> t;
 		ub::vector< interval<T> > y;
-		psa< interval <T> > tmp;
 		int s = result.size();
 		y.resize(s);
 
 		for (i = (int)ceil(((start - start_g) / step).lower()); i<=(int)floor(((end - start_g) / step).upper()); i++) {
 			t = start_g + step * i - start;
 			for (j=0; j<s; j++) {
-				tmp = result(j);
-				y(j) = eval(tmp, t);
+				y(j) = eval(result(j), t);
 			}
 			time_list.push_back(start + t);
 			value_list.push_back(y);
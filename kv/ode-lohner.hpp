@@ -19,6 +19,7 @@
 #include <kv/make-candidate.hpp>
 #include <kv/psa.hpp>
 #include <kv/autodif.hpp>
+#include <kv/jet.hpp>
 #include <kv/ode-param.hpp>
 
 
@@ -34,6 +35,20 @@
 #define ODE_CORF_MID 0
 #endif
 
+/*
+ * coefficients of the Taylor series with the Jacobian in ode_lohner
+ * for autodif
+ *
+ *  0: autodif< interval<T> >
+ *  n: jet< interval<T>, n > (value and derivatives in one block) for
+ *     systems of at most n equations, autodif for larger ones.
+ *     the results are the same.
+ */
+
+#ifndef ODE_JET_MAX
+#define ODE_JET_MAX 8
+#endif
+
 
 namespace kv {
 
@@ -246,26 +261,33 @@ ode_lohner(F f, ub::vector< interval<T> >& init, const interval<T>& start, inter
 }
 
 
-template <class T, class F>
+namespace ode_lohner_sub {
+
+// ode_lohner for autodif with the coefficients of type D, which is
+// autodif< interval<T> > or jet< interval<T>, N >.
+// init and the result psa are autodif in both cases.
+
+template <class D, class T, class F>
 int
-ode_lohner(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, interval<T>& end, ode_param<T> p = ode_param<T>(), ub::vector< psa< autodif< interval<T> > > >* result_psa = NULL) {
+solve(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, interval<T>& end, ode_param<T> p, ub::vector< psa< autodif< interval<T> > > >* result_psa) {
 	int n = init.size();
 	int i, j, k, km;
 
-	ub::vector< psa< autodif< interval<T> > > > x, y;
-	psa< autodif< interval<T> > > torg;
-	psa< autodif< interval<T> > > t;
+	ub::vector< psa< D > > x, y;
+	psa< D > torg;
+	psa< D > t;
 
-	ub::vector< psa< autodif< interval<T> > > > z, w;
+	ub::vector< psa< D > > z, w;
 
-	psa< autodif< interval<T> > > temp;
+	psa< D > temp;
 	T m;
 	ub::vector<T> newton_step;
 
 	bool flag;
 
 	interval<T> deltat;
-	ub::vector< autodif< interval<T> > > result, new_init;
+	ub::vector< D > new_init;
+	ub::vector< autodif< interval<T> > > c, result;
 
 	T radius, radius_tmp;
 	T tolerance;
@@ -279,14 +301,17 @@ ode_lohner(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& s
 	int restart;
 
 	ub::matrix< interval<T> > save;
+	ub::vector< psa< autodif< interval<T> > > > za;
 
 	bool save_mode, save_uh, save_rh;
 
-	ub::vector< autodif< interval<T> > > V, V2;
-	autodif< interval<T> > tste;
+	ub::vector< D > V, V2;
+	D tste;
 
 
-	new_init = autodif< interval<T> >::compress(init, save);
+	c = autodif< interval<T> >::compress(init, save);
+	new_init.resize(n);
+	for (i=0; i<n; i++) new_init(i) = D(c(i));
 
 	m = 1.;
 	for (i=0; i<n; i++) {
@@ -302,19 +327,19 @@ ode_lohner(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& s
 	torg.v.resize(2);
 	torg.v(0) = start; torg.v(1) = 1.;
 
-	save_mode = psa< autodif< interval<T> > >::mode();
-	save_uh = psa< autodif< interval<T> > >::use_history();
-	save_rh = psa< autodif< interval<T> > >::record_history();
-	psa< autodif< interval<T> > >::mode() = 1;
-	psa< autodif< interval<T> > >::use_history() = false;
-	psa< autodif< interval<T> > >::record_history() = false;
+	save_mode = psa< D >::mode();
+	save_uh = psa< D >::use_history();
+	save_rh = psa< D >::record_history();
+	psa< D >::mode() = 1;
+	psa< D >::use_history() = false;
+	psa< D >::record_history() = false;
 	#if ODE_FAST == 1
-	psa< autodif< interval<T> > >::record_history() = true;
-	psa< autodif< interval<T> > >::history().clear();
+	psa< D >::record_history() = true;
+	psa< D >::history().clear();
 	#endif
 	for (j=0; j<p.order-1; j++) {
 		#if ODE_FAST == 1
-		if (j == 1) psa< autodif< interval<T> > >::use_history() = true;
+		if (j == 1) psa< D >::use_history() = true;
 		#endif
 		t = setorder(torg, j);
 		y = f(x, t);
@@ -375,7 +400,7 @@ ode_lohner(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& s
 		tste = interval<T>(start.lower(), end2.upper());
 
 		// V = f(new_init, tste) * interval<T>(0., deltat.upper());
-		V = f(new_init, tste) * autodif< interval<T> >(interval<T>(0., deltat.upper())); // assist for VC++
+		V = f(new_init, tste) * D(interval<T>(0., deltat.upper())); // assist for VC++
 		newton_step.resize(n + n * n);
 		k = 0;
 		for (i=0; i<n; i++) {
@@ -397,7 +422,7 @@ ode_lohner(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& s
 			}
 		}
 		// V2 = new_init + f(V, tste) * interval<T>(0., deltat.upper());
-		V2 = new_init + f(V, tste) * autodif< interval<T> >(interval<T>(0., deltat.upper())); // assist for VC++
+		V2 = new_init + f(V, tste) * D(interval<T>(0., deltat.upper())); // assist for VC++
 
 		flag = true;
 		#if ODE_RESTART_RATIO == 1
@@ -440,7 +465,7 @@ ode_lohner(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& s
 		for (j=0; j<p.iteration; j++) {
 			V = V2;
 			// V2 = new_init + f(V, tste) * interval<T>(0., deltat.upper());
-			V2 = new_init + f(V, tste) * autodif< interval<T> >(interval<T>(0., deltat.upper())); // assist for VC++
+			V2 = new_init + f(V, tste) * D(interval<T>(0., deltat.upper())); // assist for VC++
 			for (i=0; i<n; i++) {
 				V2(i).v = intersect(V2(i).v, V(i).v);
 				V2(i).d.resize(n);
@@ -480,21 +505,23 @@ ode_lohner(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& s
 			}
 		}
 
+		za.resize(n);
 		for (i=0; i<n; i++) {
+			za(i).v.resize(p.order+1);
 			for (j=0; j<=p.order; j++) {
 				z(i).v(j).d.resize(n);
-				z(i).v(j) = autodif< interval<T> >::expand(z(i).v(j), save);
+				za(i).v(j) = autodif< interval<T> >::expand(to_autodif(z(i).v(j)), save);
 			}
 		}
 
 		result.resize(n);
 		for (i=0; i<n; i++) {
-			result(i) = eval(z(i), (autodif< interval<T> >)deltat);
+			result(i) = eval(za(i), (autodif< interval<T> >)deltat);
 		}
 
 		init = result;
 		if (ret_val == 1) end = end2;
-		if (result_psa != NULL) *result_psa = z;
+		if (result_psa != NULL) *result_psa = za;
 	}
 
 	psa< interval<T> >::mode() = save_mode;
@@ -504,6 +531,20 @@ ode_lohner(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& s
 	return ret_val;
 }
 
+} // namespace ode_lohner_sub
+
+
+template <class T, class F>
+int
+ode_lohner(F f, ub::vector< autodif< interval<T> > >& init, const interval<T>& start, interval<T>& end, ode_param<T> p = ode_param<T>(), ub::vector< psa< autodif< interval<T> > > >* result_psa = NULL) {
+	#if ODE_JET_MAX > 0
+	if (init.size() <= ODE_JET_MAX) {
+		return ode_lohner_sub::solve< jet< interval<T>, ODE_JET_MAX > >(f, init, start, end, p, result_psa);
+	}
+	#endif
+	return ode_lohner_sub::solve< autodif< interval<T> > >(f, init, start, end, p, result_psa);
+}
+
 
 template <class T, class F>
 int
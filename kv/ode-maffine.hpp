@@ -16,6 +16,9 @@
 
 #include <iostream>
 #include <list>
+#include <string>
+#include <stdexcept>
+#include <exception>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/io.hpp>
@@ -28,6 +31,19 @@
 #include <kv/ode-autodif.hpp>
 #include <kv/ode-param.hpp>
 #include <kv/ode-callback.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// 0: solve at the center after the autodif solve with its step size
+// 1: solve at the center with its own step size concurrently with the
+//    autodif solve (on two threads if OpenMP is enabled), and evaluate
+//    the Taylor polynomial of the solution at the end of the step.
+//    fall back to 0 if the step of the center is shorter.
+
+#ifndef ODE_CENTER_PARALLEL
+#define ODE_CENTER_PARALLEL 0
+#endif
 
 
 namespace kv {
@@ -59,6 +75,15 @@ ode_maffine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interv
 
 	int ret_val;
 	interval<T> end2 = end;
+	bool center_done;
+
+	#if ODE_CENTER_PARALLEL == 1
+	ub::vector< interval<T> > cc;
+	ub::vector< psa< interval<T> > > cpsa;
+	interval<T> endc;
+	int rc;
+	std::exception_ptr error;
+	#endif
 
 	I.resize(n);
 	c.resize(n);
@@ -68,13 +93,70 @@ ode_maffine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interv
 	}
 
 	Iad = autodif< interval<T> >::init(I);
+	#if ODE_CENTER_PARALLEL == 1
+	// the point solve at the center is far cheaper and takes a longer
+	// step than the autodif solve in most cases, so it is started at
+	// the same time with the step size of its own.
+	cc = c;
+	endc = end;
+	rc = 0;
+	// an exception must not leave the sections. it is kept and thrown
+	// again after them.
+	error = std::exception_ptr();
+	#ifdef _OPENMP
+	bool par = !omp_in_parallel();
+	#endif
+	#pragma omp parallel sections num_threads(2) if (par)
+	{
+		#pragma omp section
+		{
+			try {
+				// NOTICE: below must be autodif version of ode
+				r = ode(f, Iad, start, end2, p, result_psa);
+			}
+			catch (...) {
+				error = std::current_exception();
+			}
+		}
+		#pragma omp section
+		{
+			try {
+				F g(f);
+				ode_param<T> pc = p;
+				pc.set_autostep(true);
+				pc.set_verbose(0);
+				rc = ode(g, cc, start, endc, pc, &cpsa);
+			}
+			catch (...) {
+				// the step of the center is speculative. it is solved
+				// again in the serial way below, which throws if the
+				// failure is real.
+				rc = 0;
+			}
+		}
+	}
+	if (error) std::rethrow_exception(error);
+	#else
 	// NOTICE: below must be autodif version of ode
 	r = ode(f, Iad, start, end2, p, result_psa);
+	#endif
 	if (r == 0) return 0;
 	ret_val = r;
 	autodif< interval<T> >::split(Iad, result_i, result_d);
 
 	fc = c;
+	center_done = false;
+	#if ODE_CENTER_PARALLEL == 1
+	// the Taylor polynomial of the center encloses the solution over
+	// its whole step, so it can be evaluated at end2 inside the step.
+	if (rc == 2 || (rc == 1 && endc.lower() >= end2.upper())) {
+		for (i=0; i<n; i++) {
+			fc(i) = eval(cpsa(i), end2 - start);
+		}
+		center_done = true;
+	}
+	#endif
+
 	// Step size should be same as above ode call.
 	// Because above ode call is with autodif and interval input and
 	// below ode call is without autodif and point input,
@@ -82,9 +164,13 @@ ode_maffine(F f, ub::vector< affine<T> >& init, const interval<T>& start, interv
 	// If below ode call fails, force success by increasing order.
 	ode_param<T> p2 = p;
 	p2.set_autostep(false);
-	while (true) {
+	while (!center_done) {
 		r = ode(f, fc, start, end2, p2);
 		if (r != 0) break;
+		#if PSA_FIXED_ORDER
+		// the order can not be increased any more
+		if (p2.order >= PSA_FIXED_ORDER) return 0;
+		#endif
 		p2.order++;
 		if (p.verbose == 1) {
 			std::cout << "ode_maffine: increase order: " << p.order << "\n";
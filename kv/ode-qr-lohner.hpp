@@ -8,17 +8,34 @@
 // ODE using QR Decomposition
 
 #include <iostream>
+#include <string>
+#include <stdexcept>
+#include <exception>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/io.hpp>
 #include <kv/interval.hpp>
 #include <kv/rdouble.hpp>
 #include <kv/interval-vector.hpp>
+#include <kv/interval-blas.hpp>
 #include <kv/qr.hpp>
 #include <kv/vleq.hpp>
 #include <kv/ode-lohner.hpp>
 #include <kv/ode-param.hpp>
 #include <kv/ode-callback.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// 0: solve at the center after the autodif solve with its step size
+// 1: solve at the center with its own step size concurrently with the
+//    autodif solve (on two threads if OpenMP is enabled), and evaluate
+//    the Taylor polynomial of the solution at the end of the step.
+//    fall back to 0 if the step of the center is shorter.
+
+#ifndef ODE_CENTER_PARALLEL
+#define ODE_CENTER_PARALLEL 0
+#endif
 
 
 namespace kv {
@@ -62,6 +79,19 @@ odelong_qr_lohner(
 	ub::vector< psa< interval<T> > > result_psa;
 	ub::vector< psa< autodif< interval<T> > > > result_tmp;
 
+	bool center_done;
+
+	#if ODE_CENTER_PARALLEL == 1
+	ub::vector< interval<T> > cc;
+	ub::vector< psa< interval<T> > > cpsa;
+	interval<T> endc;
+	int rc;
+	std::exception_ptr error;
+	#ifdef _OPENMP
+	bool par = !omp_in_parallel();
+	#endif
+	#endif
+
 
 	if (mat != NULL) {
 		M = ub::identity_matrix< interval<T> >(s);
@@ -83,11 +113,66 @@ odelong_qr_lohner(
 		Iad = autodif< interval<T> >::init(x1);
 		p2 = p;
 		p2.set_autostep(true);
+		#if ODE_CENTER_PARALLEL == 1
+		// the point solve at the center is far cheaper and takes a
+		// longer step than the autodif solve in most cases, so it is
+		// started at the same time with the step size of its own.
+		cc = c;
+		endc = end;
+		rc = 0;
+		// an exception must not leave the sections. it is kept and thrown
+		// again after them.
+		error = std::exception_ptr();
+		#pragma omp parallel sections num_threads(2) if (par)
+		{
+			#pragma omp section
+			{
+				try {
+					// NOTICE: below must be autodif version of ode
+					ret_ode = ode_lohner(f, Iad, t, t1, p2, &result_tmp);
+				}
+				catch (...) {
+					error = std::current_exception();
+				}
+			}
+			#pragma omp section
+			{
+				try {
+					F g(f);
+					ode_param<T> pc = p;
+					pc.set_autostep(true);
+					pc.set_verbose(0);
+					rc = ode_lohner(g, cc, t, endc, pc, &cpsa);
+				}
+				catch (...) {
+					// the step of the center is speculative. it is solved
+					// again in the serial way below, which throws if the
+					// failure is real.
+					rc = 0;
+				}
+			}
+		}
+		if (error) std::rethrow_exception(error);
+		#else
 		// NOTICE: below must be autodif version of ode
 		ret_ode = ode_lohner(f, Iad, t, t1, p2, &result_tmp);
+		#endif
 		if (ret_ode == 0) break;
 
 		fc = c;
+		center_done = false;
+		#if ODE_CENTER_PARALLEL == 1
+		// the Taylor polynomial of the center encloses the solution
+		// over its whole step, so it can be evaluated at t1 inside
+		// the step.
+		if (rc == 2 || (rc == 1 && endc.lower() >= t1.upper())) {
+			for (i=0; i<s; i++) {
+				fc(i) = eval(cpsa(i), t1 - t);
+			}
+			center_done = true;
+		}
+		#endif
+
 		// Step size should be same as above ode call.
 		// Because above ode call is with autodif and interval input and
 		// below ode call is without autodif and point input,
@@ -95,12 +180,19 @@ odelong_qr_lohner(
 		// If below ode call fails, force success by increasing order.
 		p2 = p;
 		p2.set_autostep(false);
-		while (1) {
+		while (!center_done) {
 			ret_ode2 = ode_lohner(f, fc, t, t1, p2);
 			if (ret_ode2 != 0) break;
+			#if PSA_FIXED_ORDER
+			// the order can not be increased any more
+			if (p2.order >= PSA_FIXED_ORDER) break;
+			#endif
 			p2.order++;
 			std::cout << "increase order: " << p2.order << "\n";
 		}
+		#if PSA_FIXED_ORDER
+		if (!center_done && ret_ode2 == 0) break;
+		#endif
 
 		autodif< interval<T> >::split(Iad, result_i, result_d);
 
@@ -110,7 +202,7 @@ odelong_qr_lohner(
 		result_d =  mid(result_d);
 		#endif
 
-		AQ = prod(result_d, Q);
+		AQ = iblas::gemm(result_d, Q);
 		bo = qr(mid(AQ), Q2, R);
 		if (bo == false) break;
 		Q2i = Q2;
@@ -119,14 +211,14 @@ odelong_qr_lohner(
 		bo = vleq(Q2i, AQ, QAQ, &Q2t);
 		if (bo == false) break;
 		Q2i = Q2;
-		y1 = prod(QAQ, y);
+		y1 = iblas::gemv(QAQ, y);
 		c = mid(fc);
 		tmp = fc - c;
 		// bo = vleq(Q2i, tmp, y2);
 		bo = vleq(Q2i, tmp, y2, &Q2t);
 		if (bo == false) break;
 		y = y1 + y2;
-		x1 = prod(Q2, y) + c;
+		x1 = iblas::gemv(Q2, y) + c;
 
 		// below seems to have some efficiency.
 		// we comment out below because we have not study it
@@ -138,7 +230,7 @@ odelong_qr_lohner(
 
 		ret_val = 1;
 
-		if (mat != NULL) M = prod(result_d, M);
+		if (mat != NULL) M = iblas::gemm(result_d, M);
 
 		if (p.verbose == 1) {
 			std::cout << "t: " << t1 << "\n";
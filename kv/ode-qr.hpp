@@ -14,6 +14,7 @@
 #include <kv/interval.hpp>
 #include <kv/rdouble.hpp>
 #include <kv/interval-vector.hpp>
+#include <kv/interval-blas.hpp>
 #include <kv/qr.hpp>
 #include <kv/vleq.hpp>
 #include <kv/ode.hpp>
@@ -98,9 +99,16 @@ odelong_qr(
 		while (1) {
 			ret_ode2 = ode(f, fc, t, t1, p2);
 			if (ret_ode2 != 0) break;
+			#if PSA_FIXED_ORDER
+			// the order can not be increased any more
+			if (p2.order >= PSA_FIXED_ORDER) break;
+			#endif
 			p2.order++;
 			std::cout << "increase order: " << p2.order << "\n";
 		}
+		#if PSA_FIXED_ORDER
+		if (ret_ode2 == 0) break;
+		#endif
 
 		autodif< interval<T> >::split(Iad, result_i, result_d);
 
@@ -110,7 +118,7 @@ odelong_qr(
 		result_d =  mid(result_d);
 		#endif
 
-		AQ = prod(result_d, Q);
+		AQ = iblas::gemm(result_d, Q);
 		bo = qr(mid(AQ), Q2, R);
 		if (bo == false) break;
 		Q2i = Q2;
@@ -119,14 +127,14 @@ odelong_qr(
 		bo = vleq(Q2i, AQ, QAQ, &Q2t);
 		if (bo == false) break;
 		Q2i = Q2;
-		y1 = prod(QAQ, y);
+		y1 = iblas::gemv(QAQ, y);
 		c = mid(fc);
 		tmp = fc - c;
 		// bo = vleq(Q2i, tmp, y2);
 		bo = vleq(Q2i, tmp, y2, &Q2t);
 		if (bo == false) break;
 		y = y1 + y2;
-		x1 = prod(Q2, y) + c;
+		x1 = iblas::gemv(Q2, y) + c;
 
 		// below seems to have some efficiency.
 		// we comment out below because we have not study it
@@ -138,7 +146,7 @@ odelong_qr(
 
 		ret_val = 1;
 
-		if (mat != NULL) M = prod(result_d, M);
+		if (mat != NULL) M = iblas::gemm(result_d, M);
 
 		if (p.verbose == 1) {
 			std::cout << "t: " << t1 << "\n";
@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef ODE_TRAJECTORY_HPP
+#define ODE_TRAJECTORY_HPP
+
+//
+// dense output of odelong_* stored in one place
+//
+//  ode_trajectory<T> keeps the Taylor coefficients of all the steps
+//  in one contiguous array. the step containing t is found by binary
+//  search, and the enclosure of the solution at t is evaluated from
+//  the coefficients without copying psa.
+//  the time must increase: the steps of a backward integration
+//  (end < start) can be stored, but find and eval do not work on them
+//  (eval returns false).
+//
+//  it can be written to a binary file and loaded again (by mmap if
+//  available). the file is the raw memory image, so it can be read
+//  only on the same kind of machine, and T must be a type of fixed
+//  size such as double or dd.
+//
+//  usage:
+//   kv::ode_trajectory<double> traj;
+//   odelong_maffine(f, x, start, end, p, kv::ode_callback_trajectory<double>(traj));
+//   traj.eval(t, y);
+//
+
+#include <iostream>
+#include <vector>
+#include <cstdio>
+#include <cstring>
+#include <algorithm>
+#include <boost/numeric/ublas/vector.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/psa.hpp>
+#include <kv/interval-blas.hpp>
+#include <kv/ode-callback.hpp>
+
+
+/*
+ * ODE_TRAJECTORY_MMAP
+ *
+ * how ode_trajectory::load reads the file
+ *
+ *  0: read into memory
+ *  1: map into memory by mmap (POSIX)
+ */
+
+#ifndef ODE_TRAJECTORY_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define ODE_TRAJECTORY_MMAP 1
+#else
+#define ODE_TRAJECTORY_MMAP 0
+#endif
+#endif
+
+#if ODE_TRAJECTORY_MMAP
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+
+namespace kv {
+
+namespace ub = boost::numeric::ublas;
+
+
+namespace ode_trajectory_sub {
+
+// coefficients p[0], p[1], ... seen as p(0), p(1), ...
+
+template <class T> struct coef_view {
+	const interval<T>* p;
+	coef_view(const interval<T>* p) : p(p) {}
+	const interval<T>& operator()(int i) const {
+		return p[i];
+	}
+};
+
+// header of the binary file
+
+struct file_header {
+	char magic[8];
+	int size;     // sizeof(interval<T>)
+	int dim;
+	int steps;
+	int coefs;
+};
+
+} // namespace ode_trajectory_sub
+
+
+template <class T> class ode_trajectory {
+	// owned storage
+	std::vector< interval<T> > tv; // start and end of each step
+	std::vector< interval<T> > cv; // coefficients
+	std::vector<int> ov;           // offsets of coefficients
+
+	// current storage (owned vectors or mapped file)
+	const interval<T>* tp;
+	const interval<T>* cp;
+	const int* op;
+
+	int n; // dimension
+	int m; // number of steps
+
+	void* map;
+	std::size_t maplen;
+
+	ode_trajectory(const ode_trajectory&);
+	ode_trajectory& operator=(const ode_trajectory&);
+
+	void set_view() {
+		tp = tv.empty() ? NULL : &tv[0];
+		cp = cv.empty() ? NULL : &cv[0];
+		op = &ov[0];
+	}
+
+	// copy the mapped file to the owned storage
+	void unmap() {
+		if (map == NULL) return;
+		tv.assign(tp, tp + 2 * m);
+		cv.assign(cp, cp + op[n * m]);
+		ov.assign(op, op + n * m + 1);
+		#if ODE_TRAJECTORY_MMAP
+		munmap(map, maplen);
+		#endif
+		map = NULL;
+		set_view();
+	}
+
+	static const char* magic() {
+		return "kvtraj1";
+	}
+
+	// length of the file with header h. false if it overflows size_t.
+	static bool file_length(const ode_trajectory_sub::file_header& h, std::size_t& len) {
+		const std::size_t max = (std::size_t)(-1);
+		std::size_t k, v;
+
+		// number of offsets and of intervals
+		if (h.steps != 0 && (std::size_t)h.dim > (max - 1) / (std::size_t)h.steps) return false;
+		k = (std::size_t)h.dim * h.steps + 1;
+		if ((std::size_t)h.steps > (max - (std::size_t)h.coefs) / 2) return false;
+		v = 2 * (std::size_t)h.steps + h.coefs;
+
+		if (k > (max - sizeof(h)) / sizeof(int)) return false;
+		if (v > (max - sizeof(h) - k * sizeof(int)) / sizeof(interval<T>)) return false;
+		len = sizeof(h) + v * sizeof(interval<T>) + k * sizeof(int);
+		return true;
+	}
+
+	// the offsets read from a file must start at 0, be increasing
+	// (every component has at least one coefficient) and end at the
+	// number of coefficients
+	static bool valid_offsets(const int* o, std::size_t k, int coefs) {
+		std::size_t i;
+
+		if (o[0] != 0 || o[k] != coefs) return false;
+		for (i=0; i<k; i++) {
+			if (o[i] >= o[i+1]) return false;
+		}
+		return true;
+	}
+
+	public:
+
+	ode_trajectory() : n(0), m(0), map(NULL), maplen(0) {
+		ov.push_back(0);
+		set_view();
+	}
+
+	~ode_trajectory() {
+		#if ODE_TRAJECTORY_MMAP
+		if (map != NULL) munmap(map, maplen);
+		#endif
+	}
+
+	void clear() {
+		unmap();
+		tv.clear();
+		cv.clear();
+		ov.assign(1, 0);
+		n = 0;
+		m = 0;
+		set_view();
+	}
+
+	int dim() const {
+		return n;
+	}
+
+	int size() const {
+		return m;
+	}
+
+	const interval<T>& start(int k) const {
+		return tp[2 * k];
+	}
+
+	const interval<T>& end(int k) const {
+		return tp[2 * k + 1];
+	}
+
+	// coefficients of the i-th component of the k-th step
+	int order(int k, int i) const {
+		return op[k * n + i + 1] - op[k * n + i] - 1;
+	}
+
+	const interval<T>& coef(int k, int i, int j) const {
+		return cp[op[k * n + i] + j];
+	}
+
+	// append a step given to ode_callback. the steps must be appended
+	// in increasing order of time.
+	void push_back(const interval<T>& start, const interval<T>& end, const ub::vector< psa< interval<T> > >& result) {
+		int i, j, s;
+
+		unmap();
+		if (m == 0) n = result.size();
+
+		tv.push_back(start);
+		tv.push_back(end);
+		for (i=0; i<n; i++) {
+			s = result(i).v.size();
+			for (j=0; j<s; j++) cv.push_back(result(i).v(j));
+			ov.push_back(ov.back() + s);
+		}
+		m++;
+		set_view();
+	}
+
+	// first step whose end is not before t.
+	// the steps must be in increasing order of time.
+	int find(const interval<T>& t) const {
+		return find(t, 0);
+	}
+
+	int find(const interval<T>& t, int from) const {
+		int lo = from, hi = m, mid;
+
+		while (lo < hi) {
+			mid = lo + (hi - lo) / 2;
+			if (end(mid).upper() < t.lower()) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+
+		return lo;
+	}
+
+	// enclosure y of the solution at t. t may extend over several
+	// steps. return false if t is not inside the trajectory.
+	bool eval(const interval<T>& t, ub::vector< interval<T> >& y) const {
+		return eval(t, y, find(t));
+	}
+
+	bool eval(const interval<T>& t, ub::vector< interval<T> >& y, int k) const {
+		int i;
+		interval<T> d, h, z;
+		bool first = true;
+
+		if (m == 0) return false;
+		if (t.lower() < start(0).lower() || t.upper() > end(m - 1).upper()) return false;
+
+		y.resize(n);
+		for ( ; k<m && start(k).lower() <= t.upper(); k++) {
+			// the coefficients are valid on [0, end - start]
+			h = end(k) - start(k);
+			d = t - start(k);
+			if (d.upper() < 0. || d.lower() > h.upper()) continue;
+			d = intersect(d, interval<T>(0., h.upper()));
+			for (i=0; i<n; i++) {
+				z = iblas::horner(ode_trajectory_sub::coef_view<T>(cp + op[k * n + i]), 0, order(k, i), d);
+				y(i) = first ? z : interval<T>::hull(y(i), z);
+			}
+			first = false;
+		}
+
+		return !first;
+	}
+
+	// evaluate at many times. if t is sorted, the search for each time
+	// starts from the step of the previous one. y[j] is empty if t[j]
+	// is not inside the trajectory. return the number evaluated.
+	int eval(const std::vector< interval<T> >& t, std::vector< ub::vector< interval<T> > >& y) const {
+		int j, k = 0, c = 0;
+		int nt = t.size();
+
+		y.resize(nt);
+		for (j=0; j<nt; j++) {
+			if (j > 0 && t[j].lower() < t[j-1].lower()) k = 0;
+			k = find(t[j], k);
+			if (eval(t[j], y[j], k)) {
+				c++;
+			} else {
+				y[j].resize(0);
+			}
+		}
+
+		return c;
+	}
+
+	bool save(const char* file) const {
+		ode_trajectory_sub::file_header h;
+		FILE* fp;
+		bool r;
+
+		std::memset(&h, 0, sizeof(h));
+		std::strcpy(h.magic, magic());
+		h.size = sizeof(interval<T>);
+		h.dim = n;
+		h.steps = m;
+		h.coefs = op[n * m];
+
+		fp = std::fopen(file, "wb");
+		if (fp == NULL) return false;
+		r = std::fwrite(&h, sizeof(h), 1, fp) == 1;
+		if (r && m > 0) {
+			r = std::fwrite(tp, sizeof(interval<T>), 2 * m, fp) == (std::size_t)(2 * m)
+			 && std::fwrite(cp, sizeof(interval<T>), h.coefs, fp) == (std::size_t)h.coefs;
+		}
+		if (r) {
+			r = std::fwrite(op, sizeof(int), n * m + 1, fp) == (std::size_t)(n * m + 1);
+		}
+		if (std::fclose(fp) != 0) r = false;
+
+		return r;
+	}
+
+	bool load(const char* file) {
+		ode_trajectory_sub::file_header h;
+		FILE* fp;
+		std::size_t len;
+		long size;
+		bool r;
+
+		clear();
+
+		fp = std::fopen(file, "rb");
+		if (fp == NULL) return false;
+		r = std::fread(&h, sizeof(h), 1, fp) == 1;
+		if (r) {
+			r = std::strncmp(h.magic, magic(), sizeof(h.magic)) == 0
+			 && h.size == (int)sizeof(interval<T>)
+			 && h.dim >= 0 && h.steps >= 0 && h.coefs >= 0;
+		}
+		if (r) r = file_length(h, len);
+		if (r) {
+			// the header must agree with the size of the file
+			r = std::fseek(fp, 0, SEEK_END) == 0;
+		}
+		if (r) {
+			size = std::ftell(fp);
+			r = size >= 0 && (std::size_t)size == len
+			 && std::fseek(fp, (long)sizeof(h), SEEK_SET) == 0;
+		}
+		if (!r) {
+			std::fclose(fp);
+			return false;
+		}
+
+		#if ODE_TRAJECTORY_MMAP
+		struct stat st;
+		void* p;
+
+		std::fclose(fp);
+		int fd = open(file, O_RDONLY);
+		if (fd < 0) return false;
+		if (fstat(fd, &st) != 0 || (std::size_t)st.st_size != len) {
+			close(fd);
+			return false;
+		}
+		p = mmap(NULL, len, PROT_READ, MAP_PRIVATE, fd, 0);
+		close(fd);
+		if (p == MAP_FAILED) return false;
+		tp = (const interval<T>*)((char*)p + sizeof(h));
+		cp = tp + 2 * h.steps;
+		op = (const int*)(cp + h.coefs);
+		if (!valid_offsets(op, (std::size_t)h.dim * h.steps, h.coefs)) {
+			munmap(p, len);
+			set_view();
+			return false;
+		}
+		map = p;
+		maplen = len;
+		#else
+		tv.resize(2 * h.steps);
+		cv.resize(h.coefs);
+		ov.resize((std::size_t)h.dim * h.steps + 1);
+		r = (h.steps == 0 || std::fread(&tv[0], sizeof(interval<T>), tv.size(), fp) == tv.size())
+		 && (h.coefs == 0 || std::fread(&cv[0], sizeof(interval<T>), cv.size(), fp) == cv.size())
+		 && std::fread(&ov[0], sizeof(int), ov.size(), fp) == ov.size();
+		std::fclose(fp);
+		if (!r || !valid_offsets(&ov[0], ov.size() - 1, h.coefs)) {
+			clear();
+			return false;
+		}
+		set_view();
+		#endif
+		n = h.dim;
+		m = h.steps;
+
+		return true;
+	}
+};
+
+
+// callback function for storing the trajectory
+
+template <class T> struct ode_callback_trajectory : ode_callback<T> {
+	ode_trajectory<T>& traj;
+
+	ode_callback_trajectory(ode_trajectory<T>& traj) : traj(traj) {}
+
+	virtual bool operator()(const interval<T>& start, const interval<T>& end, const ub::vector< interval<T> >& x_s, const ub::vector< interval<T> >& x_e, const ub::vector< psa< interval<T> > >& result) const {
+		traj.push_back(start, end, result);
+		return true;
+	}
+};
+
+} // namespace kv
+
+#endif // ODE_TRAJECTORY_HPP
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2020 Masahide Kashiwagi (kashi@waseda.jp)
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
  */
 
 #ifndef OPTIMIZE_HPP
@@ -7,7 +7,12 @@
 
 #include <iostream>
 #include <list>
+#include <deque>
+#include <vector>
+#include <queue>
 #include <limits>
+#include <exception>
+#include <stdexcept>
 #include <kv/interval.hpp>
 #include <kv/rdouble.hpp>
 #include <kv/interval-vector.hpp>
@@ -15,6 +20,11 @@
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/io.hpp>
 #include <kv/autodif.hpp>
+#include <kv/autodif-reverse.hpp>
+#include <kv/allsol-workpool.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 
 // 0: Do not use TRIM
@@ -30,6 +40,24 @@
 #define OPTIMIZE_ZERODIVIDE 2
 #endif
 
+// 0: breadth-first search (optimize_list, default)
+// 1: best-first search with respect to lower bound of f
+//    (optimize_list_bestfirst, parallelized if OpenMP is enabled).
+//    optimize_list_bestfirst carries an exception of f out of the
+//    threads by std::exception_ptr, so it is defined only for C++11.
+
+#ifndef OPTIMIZE_BESTFIRST
+#define OPTIMIZE_BESTFIRST 0
+#endif
+
+// 0: gradient of f by autodif (forward mode, default)
+// 1: gradient of f by autodif_reverse (reverse mode, whose cost does
+//    not grow with the number of variables)
+
+#ifndef OPTIMIZE_AUTODIF
+#define OPTIMIZE_AUTODIF 0
+#endif
+
 
 namespace kv {
 
@@ -56,13 +84,99 @@ template <class F> struct Opt_MakeVec {
 };
 
 
+namespace optimize_sub {
+
+#if __cplusplus >= 201103L
+
+// priority queue of intervals ordered by lower bound of f.
+// intervals with the same lower bound are popped in the order of push.
+// boxes are kept in a deque and the heap holds only their indices,
+// so that sifting the heap does not copy the vectors.
+
+template <class T> class boxqueue {
+	struct entry {
+		T lb;
+		unsigned long seq;
+		int slot;
+		// reversed to make std::priority_queue a min-heap
+		bool operator<(const entry& e) const {
+			if (lb != e.lb) return lb > e.lb;
+			return seq > e.seq;
+		}
+	};
+
+	std::priority_queue<entry> heap;
+	std::deque< ub::vector< interval<T> > > box;
+	std::vector<int> freeslot;
+	unsigned long seq;
+
+	public:
+
+	boxqueue() : seq(0) {}
+
+	bool empty() const {
+		return heap.empty();
+	}
+
+	int size() const {
+		return heap.size();
+	}
+
+	void push(const T& lb, const ub::vector< interval<T> >& I) {
+		entry e;
+
+		e.lb = lb;
+		e.seq = seq++;
+		if (freeslot.empty()) {
+			e.slot = box.size();
+			box.push_back(I);
+		} else {
+			e.slot = freeslot.back();
+			freeslot.pop_back();
+			box[e.slot] = I;
+		}
+		heap.push(e);
+	}
+
+	bool pop(ub::vector< interval<T> >& I, T& lb) {
+		if (heap.empty()) return false;
+		const entry& e = heap.top();
+		lb = e.lb;
+		I = box[e.slot];
+		freeslot.push_back(e.slot);
+		heap.pop();
+		return true;
+	}
+};
+
+#endif
+
+// value fi and gradient fdi of f on I
+
+template <class T, class F>
+void gradient(F& f, const ub::vector< interval<T> >& I, interval<T>& fi, ub::vector< interval<T> >& fdi)
+{
+#if OPTIMIZE_AUTODIF == 1
+	autodif_reverse< interval<T> >::split(f(autodif_reverse< interval<T> >::init(I)), fi, fdi);
+#else
+	autodif< interval<T> >::split(f(autodif< interval<T> >::init(I)), fi, fdi);
+#endif
+}
+
+} // namespace optimize_sub
+
+
 template <class T, class F>
 std::list< ub::vector< interval<T> > >
 optimize(const ub::vector< interval<T> >& init, F f, T limit, bool unify = true, int verbose = 0)
 {
 	std::list< ub::vector< interval<T> > > targets;
 	targets.push_back(init);
+#if OPTIMIZE_BESTFIRST == 1
+	return optimize_list_bestfirst(targets, f, limit, unify, verbose);
+#else
 	return optimize_list(targets, f, limit, unify, verbose);
+#endif
 }
 
 template <class T, class F>
@@ -106,7 +220,7 @@ optimize_list(std::list< ub::vector< interval<T> > > targets, F f, T limit, bool
 		C = mid(I);
 		try {
 			fc = f(C);
-			autodif< interval<T> >::split(f(autodif< interval<T> >::init(I)), fi, fdi);
+			optimize_sub::gradient(f, I, fi, fdi);
 		}
 		catch (std::domain_error& e) {
 			// errflag = true;
@@ -305,6 +419,368 @@ optimize_list(std::list< ub::vector< interval<T> > > targets, F f, T limit, bool
 	return solutions;
 }
 
+#if __cplusplus >= 201103L
+
+// best-first version of optimize_list.
+// intervals are processed in ascending order of lower bound of f,
+// so that the upper bound of minimum value (delta) becomes small
+// early and more intervals are discarded.
+// if OpenMP is enabled, the intervals are processed by multiple threads
+// which share the queue and delta.
+// found intervals whose lower bound exceeds final delta are discarded.
+
+template <class T, class F>
+std::list< ub::vector< interval<T> > >
+optimize_list_bestfirst(std::list< ub::vector< interval<T> > > targets, F f, T limit, bool unify = true, int verbose = 0)
+{
+	int s = (targets.front()).size();
+	std::list< ub::vector< interval<T> > > solutions;
+	std::list< ub::vector< interval<T> > > found;
+	std::list<T> found_lb;
+	typename std::list< ub::vector< interval<T> > >::iterator p;
+	typename std::list<T>::iterator q;
+	optimize_sub::boxqueue<T> queue;
+	int busy = 0; // number of intervals being processed
+	bool flag;
+	// exception thrown by f in the parallel region. it is rethrown
+	// after the region, and stop makes all threads leave.
+	std::exception_ptr error;
+	bool stop = false;
+
+	T delta = std::numeric_limits<T>::max();
+
+	for (p=targets.begin(); p!=targets.end(); p++) {
+		queue.push(-std::numeric_limits<T>::infinity(), *p);
+	}
+	targets.clear();
+
+	#pragma omp parallel
+	{
+
+	ub::vector< interval<T> > I, C, I1, I2, IR, fdi, C2;
+	interval<T> fc, fi, mvf, fc2; 
+	T tmp, tmp2, lb;
+	T mydelta; // copy of delta
+	int i, mi, idle;
+	bool errflag, got, finished;
+	interval<T> A, B, J, J2, Itmp; 
+#if OPTIMIZE_TRIM >= 1
+	int j;
+	bool flag;
+#endif // OPTIMIZE_TRIM >= 1
+#if OPTIMIZE_TRIM == 1
+	int k;
+#endif // OPTIMIZE_TRIM == 1
+#if OPTIMIZE_TRIM == 3
+	ub::vector< interval<T> > A0, A1, A2; // for new trim algorithm
+#endif // OPTIMIZE_TRIM == 3
+
+	C2.resize(s);
+	idle = 0;
+
+	while (true) {
+		#pragma omp critical (optimize_queue)
+		{
+		if (stop) {
+			got = false;
+			finished = true;
+		} else {
+			got = queue.pop(I, lb);
+			if (got) busy++;
+			finished = (!got && busy == 0);
+		}
+		mydelta = delta;
+		}
+		if (finished) break;
+		if (!got) {
+			// other threads may push new intervals
+			allsol_sub::idle_wait(idle);
+			continue;
+		}
+		idle = 0;
+
+		// continue in this loop finishes the processing of I
+		try {
+		do {
+
+		if (lb > mydelta) {
+			continue;
+		}
+
+		errflag = false; // evaluation error occurs or not
+
+		try {
+			fi = f(I);
+		}
+		catch (std::domain_error& e) {
+			errflag = true;
+			goto label;
+		}
+
+		if (fi.lower() > mydelta) {
+			continue;
+		}
+		if (fi.lower() > lb) lb = fi.lower();
+
+		C = mid(I);
+		try {
+			fc = f(C);
+			optimize_sub::gradient(f, I, fi, fdi);
+		}
+		catch (std::domain_error& e) {
+			// errflag = true;
+			goto label;
+		}
+
+		fdi.resize(s); // prepare for constant f
+		mvf = fc + inner_prod(fdi, I - C);
+		if (mvf.lower() > mydelta) {
+			continue;
+		}
+		if (mvf.lower() > lb) lb = mvf.lower();
+
+		// C2 is likely to give small value
+		for (i=0; i<s; i++) {
+			tmp = mid(fdi(i));
+			if (tmp > 0.) tmp2 = I(i).lower();
+			else if (tmp < 0.) tmp2 = I(i).upper();
+			else tmp2 = mid(I(i));
+			C2(i).assign(tmp2, tmp2);
+		}
+
+		// update delta at C
+		tmp = fc.upper();
+		if (tmp < mydelta) {
+			#pragma omp critical (optimize_queue)
+			{
+			if (tmp < delta) delta = tmp;
+			mydelta = delta;
+			}
+		}
+
+		// update delta at C2
+		try {
+			fc2 = f(C2);
+		}
+		catch (std::domain_error& e) {
+			// errflag = true;
+			goto label;
+		}
+		tmp = fc2.upper();
+		if (tmp < mydelta) {
+			#pragma omp critical (optimize_queue)
+			{
+			if (tmp < delta) delta = tmp;
+			mydelta = delta;
+			}
+		}
+
+#if OPTIMIZE_TRIM >= 1
+		// interval shrinking
+
+#if OPTIMIZE_TRIM == 3
+		// prepare for new trim algorithm
+		A0.resize(s);
+		A1.resize(s);
+		A2.resize(s);
+		for (j=0; j<s; j++) {
+			A0(j) = fdi(j) * (I(j)-C(j));
+		}
+		Itmp = 0.;
+		for (j=0; j<s; j++) {
+			A1(j) = Itmp;
+			Itmp += A0(j);
+		}
+		Itmp = 0.;
+		for (j=s-1; j>=0; j--) {
+			A2(j) = Itmp;
+			Itmp += A0(j);
+		}
+#endif // OPTIMIZE_TRIM == 3
+
+		IR = I;
+		flag = false; // non-existence in I turns out or not
+		for (j=0; j<s; j++) {
+			B = fdi(j);
+
+#if OPTIMIZE_TRIM == 1
+			// calculate A simply
+			// simple but slow
+			A = 0.;
+			for (k=0; k<s; k++) {
+				if (k == j) continue;
+				A += fdi(k) * (I(k)-C(k));
+			}
+			A += fc;
+#endif // OPTIMIZE_TRIM == 1
+#if OPTIMIZE_TRIM == 2
+			// old trim algorithm
+			// calculate back A from mvf
+			A = mvf;
+			Itmp = B * (I(j)-C(j));
+			rop<T>::begin();
+			tmp = rop<T>::sub_down(A.lower(), Itmp.lower());
+			tmp2 = rop<T>::sub_up(A.upper(), Itmp.upper());
+			rop<T>::end();
+			A.assign(tmp, tmp2);
+#endif // OPTIMIZE_TRIM == 2
+#if OPTIMIZE_TRIM == 3
+			// new trim algorithm
+			A = fc + A1(j) + A2(j);
+#endif // OPTIMIZE_TRIM == 3
+
+			// A -= delta;
+			A -= interval<T>(-std::numeric_limits<T>::infinity(), mydelta);
+
+			if (zero_in(B)) {
+#if OPTIMIZE_ZERODIVIDE >= 1
+				bool bdummy;
+				if (rad(B) <= 0) continue;
+				J = C(j) - division_part1(A, B, bdummy);
+				J2 = C(j) - division_part2(A, B);
+				if (overlap(IR(j), J)) {
+					if (overlap(IR(j), J2)) {
+#if OPTIMIZE_ZERODIVIDE == 2
+						if (overlap(J, J2)) continue;
+						// interval division
+						I1 = IR;
+						I2 = IR;
+						I1(j) = intersect(IR(j), J);
+						I2(j) = intersect(IR(j), J2);
+						#pragma omp critical (optimize_queue)
+						{
+						queue.push(lb, I1);
+						queue.push(lb, I2);
+						}
+						flag = true;
+						break;
+#else
+						continue;
+#endif
+					} else {
+						IR(j) = intersect(IR(j), J);
+					}
+				} else {
+					if (overlap(IR(j), J2)) {
+						IR(j) = intersect(IR(j), J2);
+					} else {
+						flag = true;
+						break;
+					}
+				}
+#else
+				continue;
+#endif
+			} else {
+				J = C(j) - A/B;
+				if (overlap(IR(j), J)) {
+					IR(j) = intersect(IR(j), J);
+				} else {
+					flag = true;
+					break;
+				}
+			}
+		}
+
+		// non-existence in I turns out
+		if (flag == true) {
+			continue;
+		}
+
+		I = IR;
+
+#endif // OPTIMIZE_TRIM >= 1
+
+		label:;
+
+		tmp2 = 0.;
+		for (i=0; i<s; i++) {
+			tmp = width(I(i));
+			if (tmp > tmp2) {
+				tmp2 = tmp; mi = i;
+			}
+		}
+
+		if (tmp2 < limit && errflag == false) {
+			#pragma omp critical (optimize_found)
+			{
+			found.push_back(I);
+			found_lb.push_back(lb);
+			}
+			continue;
+		}
+
+		tmp = mid(I(mi));
+		I1 = I; I2 = I;
+		I1(mi).assign(I1(mi).lower(), tmp);
+		I2(mi).assign(tmp, I2(mi).upper());
+		#pragma omp critical (optimize_queue)
+		{
+		queue.push(lb, I1);
+		queue.push(lb, I2);
+		}
+
+		} while (false);
+		}
+		catch (...) {
+			#pragma omp critical (optimize_queue)
+			{
+			if (!error) error = std::current_exception();
+			stop = true;
+			}
+		}
+
+		#pragma omp critical (optimize_queue)
+		{
+		busy--;
+		}
+	}
+
+	} // pragma omp parallel
+
+	if (error) std::rethrow_exception(error);
+
+	p = found.begin();
+	q = found_lb.begin();
+	while (p != found.end()) {
+		if (*q > delta) {
+			p++; q++;
+			continue;
+		}
+		ub::vector< interval<T> >& I = *p;
+		if (verbose >= 1) {
+			std::cout << I << "\n";
+		}
+		if (unify) {
+			typename std::list< ub::vector< interval<T> > >::iterator p2;
+			while (true) {
+				flag = false;
+				p2 = solutions.begin();
+				while (p2 != solutions.end()) {
+					if (overlap(*p2, I)) {
+						I = hull(I, *p2);
+						p2 = solutions.erase(p2);
+						flag = true;
+						continue;
+					}
+					p2++;
+				}
+				if (flag == false) break;
+			}
+		}
+		solutions.push_back(I);
+		p++; q++;
+	}
+
+	if (verbose >= 1) {
+		std::cout << delta << "\n";
+	}
+
+	return solutions;
+}
+
+#endif
+
 // rename of optimize
 template <class T, class F>
 std::list< ub::vector< interval<T> > >
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2018 Masahide Kashiwagi (kashi@waseda.jp)
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
  */
 
 #ifndef PSA_HPP
@@ -8,18 +8,338 @@
 // Power Series Arithmetic Type I and II with recording
 
 #include <iostream>
-#include <list>
+#include <vector>
 #include <algorithm>
+#include <new>
+#include <cstddef>
+#include <stdexcept>
 #include <boost/numeric/ublas/vector.hpp>
 #include <boost/numeric/ublas/matrix.hpp>
 #include <boost/numeric/ublas/io.hpp>
 #include <kv/convert.hpp>
 
+/*
+ * kernels of the coefficient arithmetic of psa< interval<T> >
+ *
+ *  1: the kernels in interval-blas.hpp, which run in one rounding
+ *     scope and give the same results as the operators (default).
+ *     interval.hpp and interval-blas.hpp are included.
+ *  0: the operators of interval<T>, as for the other types. for the
+ *     programs using psa only with T other than interval, so that the
+ *     interval headers are not pulled in.
+ *  the value must be the same in all the translation units of a
+ *  program.
+ */
+
+#ifndef PSA_INTERVAL_KERNEL
+#define PSA_INTERVAL_KERNEL 1
+#endif
+
+#if PSA_INTERVAL_KERNEL
+#include <kv/interval.hpp>
+#include <kv/interval-blas.hpp>
+#endif
+
+/*
+ * select the allocator of coefficient vector of psa
+ *
+ *  0: std::allocator (default)
+ *  1: psa_pool_allocator. memory released by psa is kept in thread local
+ *     free lists (one list for each vector size) and reused, so the
+ *     steady state of the ODE solver does not call malloc for the
+ *     coefficients of power series.
+ *     each free list of each thread keeps at most PSA_POOL_LISTMAX
+ *     blocks and the blocks beyond are given back to the system, so
+ *     the memory does not grow without bound when the blocks are
+ *     allocated by one thread and freed by another.
+ */
+
+#ifndef PSA_POOL
+#define PSA_POOL 0
+#endif
+
+#ifndef PSA_POOL_MAXSIZE
+#define PSA_POOL_MAXSIZE 64
+#endif
+
+#ifndef PSA_POOL_LISTMAX
+#define PSA_POOL_LISTMAX 1024
+#endif
+
+/*
+ * fixed maximum order of psa
+ *
+ *  0: the coefficient vector is allocated on the heap (default)
+ *  n: the coefficient vector is stored in the psa object itself
+ *     (ub::bounded_array of n+2 elements: order n and one more for
+ *     integrate), so no memory allocation occurs for psa.
+ *     the order must not exceed n (std::length_error is thrown).
+ *     intended for psa< interval<double> > with small systems.
+ *     ode_maffine, ode_qr and ode_qr_lohner increase the order when
+ *     the step of the center fails, and they fail (instead of
+ *     increasing the order further) when the order reaches n, so
+ *     leave some room above the order given to ode, e.g.
+ *     -DPSA_FIXED_ORDER=32 for the default order 24.
+ *     note that this limits all the psa types in the program.
+ *     overrides PSA_POOL.
+ */
+
+#ifndef PSA_FIXED_ORDER
+#define PSA_FIXED_ORDER 0
+#endif
+
 namespace kv {
 
 namespace ub = boost::numeric::ublas;
 
 
+#if PSA_POOL
+
+// allocator which recycles memory blocks of at most PSA_POOL_MAXSIZE
+// elements. freed blocks are pushed to the free list of the calling
+// thread, so a block may move between threads but is never shared.
+// each free list keeps at most PSA_POOL_LISTMAX blocks.
+// larger blocks are passed to operator new / delete directly.
+
+template <class T> struct psa_pool_allocator {
+	typedef T value_type;
+	typedef T* pointer;
+	typedef const T* const_pointer;
+	typedef T& reference;
+	typedef const T& const_reference;
+	typedef std::size_t size_type;
+	typedef std::ptrdiff_t difference_type;
+
+	template <class U> struct rebind {
+		typedef psa_pool_allocator<U> other;
+	};
+
+	psa_pool_allocator() {}
+	template <class U> psa_pool_allocator(const psa_pool_allocator<U>&) {}
+
+	// heads of free lists. the first word of a free block points to
+	// the next free block.
+	static void** heads() {
+		static void* h[PSA_POOL_MAXSIZE + 1];
+		#pragma omp threadprivate (h)
+		return h;
+	}
+
+	// number of blocks in each free list
+	static int* counts() {
+		static int c[PSA_POOL_MAXSIZE + 1];
+		#pragma omp threadprivate (c)
+		return c;
+	}
+
+	static std::size_t blocksize(size_type n) {
+		return std::max(n * sizeof(T), sizeof(void*));
+	}
+
+	static pointer allocate(size_type n, const void* = 0) {
+		void* p;
+
+		if (n <= PSA_POOL_MAXSIZE) {
+			p = heads()[n];
+			if (p != NULL) {
+				heads()[n] = *(void**)p;
+				counts()[n]--;
+				return (pointer)p;
+			}
+		}
+		return (pointer)::operator new(blocksize(n));
+	}
+
+	static void deallocate(pointer p, size_type n) {
+		if (p == NULL) return;
+		if (n <= PSA_POOL_MAXSIZE && counts()[n] < PSA_POOL_LISTMAX) {
+			*(void**)p = heads()[n];
+			heads()[n] = (void*)p;
+			counts()[n]++;
+			return;
+		}
+		::operator delete((void*)p);
+	}
+
+	// give the cached blocks of the calling thread back to the system.
+	static void release() {
+		int i;
+		void *p, *q;
+
+		for (i=0; i<=PSA_POOL_MAXSIZE; i++) {
+			p = heads()[i];
+			while (p != NULL) {
+				q = *(void**)p;
+				::operator delete(p);
+				p = q;
+			}
+			heads()[i] = NULL;
+			counts()[i] = 0;
+		}
+	}
+
+	size_type max_size() const {
+		return std::size_t(-1) / sizeof(T);
+	}
+
+	void construct(pointer p, const T& x) {
+		new ((void*)p) T(x);
+	}
+
+	void destroy(pointer p) {
+		p->~T();
+	}
+
+	template <class U> bool operator==(const psa_pool_allocator<U>&) const {
+		return true;
+	}
+
+	template <class U> bool operator!=(const psa_pool_allocator<U>&) const {
+		return false;
+	}
+};
+
+#endif // PSA_POOL
+
+
+// FIFO of coefficient vectors recorded by psa operations.
+// a ring buffer of std::vector<T>. released slots keep their memory,
+// so recording does not allocate after the first pass.
+
+template <class T> class psa_history {
+	std::vector< std::vector<T> > buf;
+	int head, count;
+	int released; // slot released by the last pop_front(), or -1
+
+	public:
+
+	psa_history() : head(0), count(0), released(-1) {}
+
+	int size() const {
+		return count;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	// the memory of buffers is kept for reuse
+	void clear() {
+		head = 0;
+		count = 0;
+		released = -1;
+	}
+
+	const std::vector<T>& front() const {
+		return buf[head];
+	}
+
+	void pop_front() {
+		released = head;
+		head++;
+		if (head == buf.size()) head = 0;
+		count--;
+	}
+
+	// append the first s elements of v. if the slot to be written is
+	// the slot released just before and its first keep elements are
+	// known to be equal to those of v, they are not copied.
+	template <class V> void push_back(const V& v, int s, int keep = 0) {
+		int t, i;
+
+		if (count == buf.size()) {
+			std::rotate(buf.begin(), buf.begin() + head, buf.end());
+			head = 0;
+			buf.push_back(std::vector<T>());
+			released = -1;
+		}
+		t = head + count;
+		if (t >= buf.size()) t -= buf.size();
+
+		std::vector<T>& b = buf[t];
+		if (t != released) keep = 0;
+		keep = std::min(keep, std::min(s, (int)b.size()));
+		b.resize(s);
+		for (i=keep; i<s; i++) b[i] = v(i);
+
+		count++;
+		released = -1;
+	}
+};
+
+
+// kernels for the coefficient arithmetic of psa.
+// the general version uses the operators of T.
+// for interval<T>, the kernels in interval-blas.hpp are used if
+// PSA_INTERVAL_KERNEL is 1.
+// scope is held by the operators of psa while they compute the
+// coefficients. for interval<T> it is rop_scope<T>, so that the
+// rounding mode is changed once per operator of psa instead of once
+// per operation of the coefficients (if the rounding backend nests
+// begin()/end(), e.g. rdouble-sse2.hpp).
+
+template <class T> struct psa_kernel {
+	struct scope {
+		scope() {}
+	};
+
+	// r(i) = sum_{j=0}^{i} a(j) b(i-j), i = from, ..., r.size()-1
+	template <class V> static void conv(const V& a, const V& b, V& r, int from) {
+		int i, j;
+		T sum;
+		for (i=from; i<r.size(); i++) {
+			sum = 0.;
+			for (j=0; j<=i; j++) {
+				sum += a(j) * b(i-j);
+			}
+			r(i) = sum;
+		}
+	}
+
+	// r(i) = sum_{j=i}^{s-1} a(j) b(i-j+s-1), i = 1, ..., s-1
+	template <class V> static void conv_tail(const V& a, const V& b, V& r) {
+		int i, j;
+		int s = a.size();
+		T sum;
+		for (i=1; i<s; i++) {
+			sum = 0.;
+			for (j=i; j<s; j++) {
+				sum += a(j) * b(i-j+s-1);
+			}
+			r(i) = sum;
+		}
+	}
+
+	template <class V> static T horner(const V& p, int x, int y, const T& d) {
+		int i;
+		T r;
+		r = p(y);
+		for (i=y-1; i>=x; i--) {
+			r = r * d + p(i);
+		}
+		return r;
+	}
+};
+
+#if PSA_INTERVAL_KERNEL
+template <class T> struct psa_kernel< interval<T> > {
+	typedef rop_scope<T> scope;
+
+	template <class V> static void conv(const V& a, const V& b, V& r, int from) {
+		iblas::conv(a, b, r, from);
+	}
+
+	template <class V> static void conv_tail(const V& a, const V& b, V& r) {
+		iblas::conv_tail(a, b, r);
+	}
+
+	template <class V> static interval<T> horner(const V& p, int x, int y, const interval<T>& d) {
+		return iblas::horner(p, x, y, d);
+	}
+};
+#endif
+
+
 template <class T> class psa;
 
 template <class C, class T> struct convertible<C, psa<T> > {
@@ -34,7 +354,15 @@ template <class C, class T> struct acceptable_n<C, psa<T> > {
 
 template <class T> class psa {
 	public:
-	ub::vector<T> v;
+	#if PSA_FIXED_ORDER
+	typedef ub::vector< T, ub::bounded_array< T, PSA_FIXED_ORDER + 2 > > vector_type;
+	#elif PSA_POOL
+	typedef ub::vector< T, ub::unbounded_array< T, psa_pool_allocator<T> > > vector_type;
+	#else
+	typedef ub::vector<T> vector_type;
+	#endif
+
+	vector_type v;
 
 	typedef T base_type;
 
@@ -59,20 +387,54 @@ template <class T> class psa {
 	}
 
 
-	static std::list<psa>& history() {
+	static psa_history<T>& history() {
 #ifdef _OPENMP // hack for non-POD thread local storage
-		static std::list<psa>* hist = NULL;
+		static psa_history<T>* hist = NULL;
 		#pragma omp threadprivate (hist)
 		if (hist == NULL) {
-			hist = new std::list<psa>();
+			hist = new psa_history<T>();
 		}
 		return *hist;
 #else
-		static std::list<psa> hist;
+		static psa_history<T> hist;
 		return hist;
 #endif
 	}
 
+	// copy the coefficients recorded in history to the first part of
+	// r of size s. return the number of coefficients to be reused.
+	static int load_history(psa& r, int s) {
+		const std::vector<T>& h = history().front();
+		int i, old_size;
+
+		old_size = h.size();
+		if (mode() == 2) {
+			old_size = std::min(old_size, s - 1);
+		}
+		r.v.resize(s);
+		for (i=0; i<std::min(old_size, s); i++) r.v(i) = h[i];
+
+		return old_size;
+	}
+
+	// pop the history used and record r.
+	// old_size is the return value of load_history (0 if not used).
+	static void update_history(const psa& r, int old_size) {
+		if (use_history() == true) {
+			history().pop_front();
+		} else {
+			old_size = 0;
+		}
+
+		if (record_history() == true) {
+			if (mode() == 1) {
+				history().push_back(r.v, r.v.size(), old_size);
+			} else {
+				history().push_back(r.v, r.v.size() - 1, old_size);
+			}
+		}
+	}
+
 	static bool& record_history() {
 		static bool rh = false;
 		#pragma omp threadprivate (rh)
@@ -102,7 +464,10 @@ template <class T> class psa {
 	}
 
 	friend psa operator+(const psa& a, const psa& b) {
+		typename psa_kernel<T>::scope scope;
 		psa r;
+		int i;
+		int old_size = 0;
 
 		if (a.v.size() == 1) {
 			r.v = b.v;
@@ -112,13 +477,7 @@ template <class T> class psa {
 			r.v(0) += b.v(0);
 		} else {
 			if (use_history() == true) {
-				r = history().front();
-				int old_size = r.v.size();
-				if (mode() == 2) {
-					old_size = std::min(old_size, (int)a.v.size() - 1);
-				}
-				int i;
-				r.v.resize(a.v.size(), true);
+				old_size = load_history(r, a.v.size());
 				for (i=old_size; i<a.v.size(); i++) {
 					r.v(i) = a.v(i) + b.v(i);
 				}
@@ -127,19 +486,7 @@ template <class T> class psa {
 			}
 		}
 
-		if (use_history() == true) {
-			history().pop_front();
-		}
-
-		if (record_history() == true) {
-			if (mode() == 1) {
-				history().push_back(r);
-			} else {
-				psa r2 = r;
-				r2.v.resize(r.v.size() - 1, true);
-				history().push_back(r2);
-			}
-		}
+		update_history(r, old_size);
 
 		return r;
 	}
@@ -173,7 +520,10 @@ template <class T> class psa {
 	}
 
 	friend psa operator-(const psa& a, const psa& b) {
+		typename psa_kernel<T>::scope scope;
 		psa r;
+		int i;
+		int old_size = 0;
 
 		if (a.v.size() == 1) {
 			r.v = - b.v;
@@ -183,13 +533,7 @@ template <class T> class psa {
 			r.v(0) -= b.v(0);
 		} else {
 			if (use_history() == true) {
-				r = history().front();
-				int old_size = r.v.size();
-				if (mode() == 2) {
-					old_size = std::min(old_size, (int)a.v.size() - 1);
-				}
-				int i;
-				r.v.resize(a.v.size(), true);
+				old_size = load_history(r, a.v.size());
 				for (i=old_size; i<a.v.size(); i++) {
 					r.v(i) = a.v(i) - b.v(i);
 				}
@@ -198,19 +542,7 @@ template <class T> class psa {
 			}
 		}
 
-		if (use_history() == true) {
-			history().pop_front();
-		}
-
-		if (record_history() == true) {
-			if (mode() == 1) {
-				history().push_back(r);
-			} else {
-				psa r2 = r;
-				r2.v.resize(r.v.size() - 1, true);
-				history().push_back(r2);
-			}
-		}
+		update_history(r, old_size);
 
 		return r;
 	}
@@ -252,19 +584,14 @@ template <class T> class psa {
 	}
 
 	friend psa operator*(const psa& a, const psa& b) {
+		typename psa_kernel<T>::scope scope;
 		psa r;
-		int i, j, s;
-		T sum;
-		int old_size;
+		int i, s;
+		int old_size = 0;
 
 		if (a.v.size() == 1) {
 			if (use_history() == true) {
-				r = history().front();
-				old_size = r.v.size();
-				if (mode() == 2) {
-					old_size = std::min(old_size, (int)b.v.size() - 1);
-				}
-				r.v.resize(b.v.size(), true);
+				old_size = load_history(r, b.v.size());
 				for (i=old_size; i<b.v.size(); i++) {
 					r.v(i) = a.v(0) * b.v(i);
 				}
@@ -273,12 +600,7 @@ template <class T> class psa {
 			}
 		} else if (b.v.size() == 1) {
 			if (use_history() == true) {
-				r = history().front();
-				old_size = r.v.size();
-				if (mode() == 2) {
-					old_size = std::min(old_size, (int)a.v.size() - 1);
-				}
-				r.v.resize(a.v.size(), true);
+				old_size = load_history(r, a.v.size());
 				for (i=old_size; i<a.v.size(); i++) {
 					r.v(i) = a.v(i) * b.v(0);
 				}
@@ -288,68 +610,36 @@ template <class T> class psa {
 		} else {
 			s = a.v.size();
 			if (use_history() == true) {
-				r = history().front();
-				old_size = r.v.size();
-				if (mode() == 2) {
-					old_size = std::min(old_size, (int)s - 1);
-				}
-				r.v.resize(s, true);
+				old_size = load_history(r, s);
 			} else {
 				old_size = 0;
 				r.v.resize(s);
 			}
-			for (i=old_size; i<s; i++) {
-				sum = 0.;
-				for (j=0; j<=i; j++) {
-					sum += a.v(j) * b.v(i-j);
-				}
-				r.v(i) = sum;
-			}
+			psa_kernel<T>::conv(a.v, b.v, r.v, old_size);
 
 			if (mode() == 2) {
 				// history may be able to be used for
 				// calculating tmp, but we do not use yet.
-				ub::vector<T> tmp(s);
+				vector_type tmp(s);
 				tmp(0) = r.v(s-1);
-				for (i=1; i<s; i++) {
-					sum = 0.;
-					for (j=i; j<s; j++) {
-						sum += a.v(j) * b.v(i-j+s-1);
-					}
-					tmp(i) = sum;
-				}
+				psa_kernel<T>::conv_tail(a.v, b.v, tmp);
 				r.v(s-1) = polyrange(tmp, 0, s-1, domain());
 			}
 		}
 
-		if (use_history() == true) {
-			history().pop_front();
-		}
-
-		if (record_history() == true) {
-			if (mode() == 1) {
-				history().push_back(r);
-			} else {
-				psa r2 = r;
-				r2.v.resize(r.v.size() - 1, true);
-				history().push_back(r2);
-			}
-		}
+		update_history(r, old_size);
 
 		return r;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, psa>::value, psa >::type operator*(const psa& a, const C& b) {
+		typename psa_kernel<T>::scope scope;
 		psa r;
+		int i;
+		int old_size = 0;
 
 		if (use_history() == true) {
-			r = history().front();
-			int old_size = r.v.size();
-			if (mode() == 2) {
-				old_size = std::min(old_size, (int)a.v.size() - 1);
-			}
-			int i;
-			r.v.resize(a.v.size(), true);
+			old_size = load_history(r, a.v.size());
 			for (i=old_size; i<a.v.size(); i++) {
 				r.v(i) = a.v(i) * b;
 			}
@@ -358,34 +648,19 @@ template <class T> class psa {
 			r.v = a.v * T(b); // assist for VC++
 		}
 
-		if (use_history() == true) {
-			history().pop_front();
-		}
-
-		if (record_history() == true) {
-			if (mode() == 1) {
-				history().push_back(r);
-			} else {
-				psa r2 = r;
-				r2.v.resize(r.v.size() - 1, true);
-				history().push_back(r2);
-			}
-		}
+		update_history(r, old_size);
 
 		return r;
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, psa>::value, psa >::type operator*(const C& a, const psa& b) {
+		typename psa_kernel<T>::scope scope;
 		psa r;
+		int i;
+		int old_size = 0;
 
 		if (use_history() == true) {
-			r = history().front();
-			int old_size = r.v.size();
-			if (mode() == 2) {
-				old_size = std::min(old_size, (int)b.v.size() - 1);
-			}
-			int i;
-			r.v.resize(b.v.size(), true);
+			old_size = load_history(r, b.v.size());
 			for (i=old_size; i<b.v.size(); i++) {
 				r.v(i) = a * b.v(i);
 			}
@@ -394,19 +669,7 @@ template <class T> class psa {
 			r.v = T(a) * b.v; // assist for VC++
 		}
 
-		if (use_history() == true) {
-			history().pop_front();
-		}
-
-		if (record_history() == true) {
-			if (mode() == 1) {
-				history().push_back(r);
-			} else {
-				psa r2 = r;
-				r2.v.resize(r.v.size() - 1, true);
-				history().push_back(r2);
-			}
-		}
+		update_history(r, old_size);
 
 		return r;
 	}
@@ -426,6 +689,7 @@ template <class T> class psa {
 	}
 
 	template <class C> friend typename boost::enable_if_c< acceptable_n<C, psa>::value, psa >::type operator/(const psa& a, const C& b) {
+		typename psa_kernel<T>::scope scope;
 		psa r;
 
 		// r.v = a.v / b;
@@ -449,6 +713,7 @@ template <class T> class psa {
 	}
 
 	friend psa inv(const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		T a, xn, xn2, range;
 		psa h, hn, r;
 		int i;
@@ -468,7 +733,7 @@ template <class T> class psa {
 			xn2 = 1./range;
 		}
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -501,6 +766,7 @@ template <class T> class psa {
 	}
 
 	friend psa sin (const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		T a, xn, xn2, range, fact_n, table[4], tmp;
 		psa h, hn, r;
 		int i;
@@ -524,7 +790,7 @@ template <class T> class psa {
 		hn = 1.;
 		fact_n = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -561,6 +827,7 @@ template <class T> class psa {
 	}
 
 	friend psa cos (const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		T a, xn, xn2, range, fact_n, table[4], tmp;
 		psa h, hn, r;
 		int i;
@@ -584,7 +851,7 @@ template <class T> class psa {
 		hn = 1.;
 		fact_n = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -621,6 +888,7 @@ template <class T> class psa {
 	}
 
 	friend psa exp (const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		T a, xn, xn2, range, fact_n, ea;
 		psa h, hn, r;
 		int i;
@@ -640,7 +908,7 @@ template <class T> class psa {
 		hn = 1.;
 		fact_n = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -671,6 +939,7 @@ template <class T> class psa {
 	}
 
 	friend psa sqrt(const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		T a, xn, xn2, sqrt_a, range;
 		psa h, hn, r;
 		int i;
@@ -694,7 +963,7 @@ template <class T> class psa {
 			xn2 = 1./(2. * sqrt(range));
 		}
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -726,6 +995,7 @@ template <class T> class psa {
 	}
 
 	friend psa log(const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		T a, xn, xn2, range;
 		psa h, hn, r;
 		int i;
@@ -747,7 +1017,7 @@ template <class T> class psa {
 			xn2 = -1.;
 		}
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -780,6 +1050,7 @@ template <class T> class psa {
 	}
 
 	friend psa sinh (const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		T a, xn, xn2, range, fact_n, table[2], tmp;
 		psa h, hn, r;
 		int i;
@@ -801,7 +1072,7 @@ template <class T> class psa {
 		hn = 1.;
 		fact_n = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -836,6 +1107,7 @@ template <class T> class psa {
 	}
 
 	friend psa cosh (const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		T a, xn, xn2, range, fact_n, table[2], tmp;
 		psa h, hn, r;
 		int i;
@@ -857,7 +1129,7 @@ template <class T> class psa {
 		hn = 1.;
 		fact_n = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -892,6 +1164,7 @@ template <class T> class psa {
 	}
 
 	friend psa asin (const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		psa h, hn, r;
 		psa taylor;
 		int i;
@@ -930,7 +1203,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -954,6 +1227,7 @@ template <class T> class psa {
 	}
 
 	friend psa acos (const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		psa h, hn, r;
 		psa taylor;
 		int i;
@@ -992,7 +1266,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1016,6 +1290,7 @@ template <class T> class psa {
 	}
 
 	friend psa atan (const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		psa h, hn, r;
 		psa taylor;
 		int i;
@@ -1053,7 +1328,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1077,6 +1352,7 @@ template <class T> class psa {
 	}
 
 	friend psa asinh (const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		psa h, hn, r;
 		psa taylor;
 		int i;
@@ -1115,7 +1391,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1139,6 +1415,7 @@ template <class T> class psa {
 	}
 
 	friend psa acosh (const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		psa h, hn, r;
 		psa taylor;
 		int i;
@@ -1177,7 +1454,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1201,6 +1478,7 @@ template <class T> class psa {
 	}
 
 	friend psa atanh (const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		psa h, hn, r;
 		psa taylor;
 		int i;
@@ -1238,7 +1516,7 @@ template <class T> class psa {
 		r = taylor.v(0);
 		hn = 1.;
 		if (use_history() == true) {
-			old_size = history().front().v.size();
+			old_size = history().front().size();
 		}
 		for (i=1; i<x.v.size(); i++) {
 			if (use_history() == true && i >= old_size) {
@@ -1270,6 +1548,7 @@ template <class T> class psa {
 	}
 
 	friend psa pow(const psa& x, int y) {
+		typename psa_kernel<T>::scope scope;
 		psa r, xp;
 		int a, tmp;
 
@@ -1321,6 +1600,7 @@ template <class T> class psa {
 	}
 
 	friend psa integrate(const psa& x) {
+		typename psa_kernel<T>::scope scope;
 		int i;
 		int s = x.v.size();
 		psa r;
@@ -1339,6 +1619,12 @@ template <class T> class psa {
 		int s = x.v.size();
 		psa r;
 
+		#if PSA_FIXED_ORDER
+		if (n > PSA_FIXED_ORDER) {
+			throw std::length_error("psa: order exceeds PSA_FIXED_ORDER");
+		}
+		#endif
+
 		r.v.resize(n+1);
 
 		if (n+1 >= s) {
@@ -1372,7 +1658,12 @@ template <class T> class psa {
 	/*
 	 *  evaluate { p[x] + p[x+1]t + ... p[y]t^(y-x) | a \in d }
 	 */
-	template <class T1> static T1 inline polyrange (const ub::vector<T>& p, int x, int y, const T1& d)
+	template <class V> static T inline polyrange (const V& p, int x, int y, const T& d)
+	{
+		return psa_kernel<T>::horner(p, x, y, d);
+	}
+
+	template <class V, class T1> static T1 inline polyrange (const V& p, int x, int y, const T1& d)
 	{
 		int i;
 		T1 r;
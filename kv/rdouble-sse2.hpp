@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2026 Masahide Kashiwagi (kashi@waseda.jp)
+ */
+
+#ifndef RDOUBLE_SSE2_HPP
+#define RDOUBLE_SSE2_HPP
+
+/*
+ * rounding operations for double using SSE2 packed instructions.
+ *
+ * Only upward rounding is used. Results rounded downward are obtained
+ * by negation (down(x op y) = -up((-x) op y) etc.), so lower and upper
+ * endpoints of an interval are computed together in one __m128d
+ * (lower endpoint in the low lane with its sign flipped).
+ *
+ * begin()/end() nest: the rounding mode is changed only by the outermost
+ * pair, so enclosing a hot loop by rop<double>::begin() and
+ * rop<double>::end() removes the mode switch from each operation.
+ * The operators of psa< interval<double> > and the Krawczyk tests of
+ * allsol hold such a region. The outermost end() sets rounding to
+ * nearest.
+ * Inside such a region, all double arithmetic is rounded upward.
+ * The nesting depth is counted per thread, so a region which may throw
+ * (e.g. allocates memory) must use rop_scope<double> instead of the bare
+ * pair: otherwise the depth stays raised and the rounding mode stays
+ * upward after the exception.
+ */
+
+#include <iostream>
+#include <string>
+#include <cmath>
+#include <limits>
+#include <kv/conv-double.hpp>
+
+#include <emmintrin.h>
+
+
+namespace kv {
+
+// prevent the compiler from constant folding or moving floating point
+// operations across the change of rounding mode.
+#if defined(__GNUC__)
+  #define KV_SSE2_OPAQUE(x) __asm__ __volatile__ ("" : "+x" (x))
+#else
+  #define KV_SSE2_OPAQUE(x) do { volatile __m128d kv_sse2_tmp = (x); (x) = kv_sse2_tmp; } while (0)
+#endif
+
+// MXCSR with rounding upward and to nearest, initialized before main().
+// the other bits of MXCSR are those at the start of the program and
+// must not be changed, as in hwround.hpp with KV_FASTROUND.
+
+static struct rdouble_sse2_reg {
+	unsigned int up;
+	unsigned int nearest;
+
+	rdouble_sse2_reg() {
+		unsigned int reg = _mm_getcsr();
+		up = (reg & ~0x6000u) | 0x4000u;
+		nearest = reg & ~0x6000u;
+	}
+} rdouble_sse2_regs;
+
+template <> struct rop <double> {
+
+	// nesting depth of begin()/end(), per thread
+	static int& depth() {
+		static int d = 0;
+		#pragma omp threadprivate (d)
+		return d;
+	}
+
+	static __m128d signmask() {
+		return _mm_set_sd(-0.);
+	}
+
+	// packed upward operations. low lane of the result is the negated
+	// lower endpoint.
+
+	static __m128d packed_add(__m128d x, __m128d y) {
+		__m128d r;
+		KV_SSE2_OPAQUE(x);
+		KV_SSE2_OPAQUE(y);
+		r = _mm_add_pd(x, y);
+		KV_SSE2_OPAQUE(r);
+		return r;
+	}
+
+	static __m128d packed_sub(__m128d x, __m128d y) {
+		__m128d r;
+		KV_SSE2_OPAQUE(x);
+		KV_SSE2_OPAQUE(y);
+		r = _mm_sub_pd(x, y);
+		KV_SSE2_OPAQUE(r);
+		return r;
+	}
+
+	static __m128d packed_mul(__m128d x, __m128d y) {
+		__m128d r;
+		KV_SSE2_OPAQUE(x);
+		KV_SSE2_OPAQUE(y);
+		r = _mm_mul_pd(x, y);
+		KV_SSE2_OPAQUE(r);
+		return r;
+	}
+
+	static __m128d packed_div(__m128d x, __m128d y) {
+		__m128d r;
+		KV_SSE2_OPAQUE(x);
+		KV_SSE2_OPAQUE(y);
+		r = _mm_div_pd(x, y);
+		KV_SSE2_OPAQUE(r);
+		return r;
+	}
+
+	static __m128d packed_sqrt(__m128d x) {
+		__m128d r;
+		KV_SSE2_OPAQUE(x);
+		r = _mm_sqrt_pd(x);
+		KV_SSE2_OPAQUE(r);
+		return r;
+	}
+
+	static double add_up(const double& x, const double& y) {
+		return _mm_cvtsd_f64(packed_add(_mm_set_sd(x), _mm_set_sd(y)));
+	}
+
+	static double add_down(const double& x, const double& y) {
+		return -_mm_cvtsd_f64(packed_add(_mm_set_sd(-x), _mm_set_sd(-y)));
+	}
+
+	static double sub_up(const double& x, const double& y) {
+		return _mm_cvtsd_f64(packed_sub(_mm_set_sd(x), _mm_set_sd(y)));
+	}
+
+	static double sub_down(const double& x, const double& y) {
+		return -_mm_cvtsd_f64(packed_sub(_mm_set_sd(-x), _mm_set_sd(-y)));
+	}
+
+	static double mul_up(const double& x, const double& y) {
+		return _mm_cvtsd_f64(packed_mul(_mm_set_sd(x), _mm_set_sd(y)));
+	}
+
+	static double mul_down(const double& x, const double& y) {
+		return -_mm_cvtsd_f64(packed_mul(_mm_set_sd(-x), _mm_set_sd(y)));
+	}
+
+	static double div_up(const double& x, const double& y) {
+		return _mm_cvtsd_f64(packed_div(_mm_set_sd(x), _mm_set_sd(y)));
+	}
+
+	static double div_down(const double& x, const double& y) {
+		return -_mm_cvtsd_f64(packed_div(_mm_set_sd(-x), _mm_set_sd(y)));
+	}
+
+	static double sqrt_up(const double& x) {
+		return _mm_cvtsd_f64(packed_sqrt(_mm_set_sd(x)));
+	}
+
+	// s = sqrt_up(x). if s * s != x, the square root is inexact and the
+	// result rounded downward is the predecessor of s.
+	static double sqrt_down_from_up(const double& x, const double& s) {
+		if (s == 0. || s == std::numeric_limits<double>::infinity()) {
+			return s;
+		}
+		__m128d p = packed_mul(_mm_set_pd(s, -s), _mm_set1_pd(s));
+		if (-_mm_cvtsd_f64(p) == x && _mm_cvtsd_f64(_mm_unpackhi_pd(p, p)) == x) {
+			return s;
+		}
+		return _mm_cvtsd_f64(_mm_castsi128_pd(_mm_sub_epi64(_mm_castpd_si128(_mm_set_sd(s)), _mm_set_epi32(0, 0, 0, 1))));
+	}
+
+	static double sqrt_down(const double& x) {
+		return sqrt_down_from_up(x, sqrt_up(x));
+	}
+
+	// MXCSR is set directly instead of by fesetround, which also sets
+	// the x87 control word. all double arithmetic of this backend uses
+	// SSE2.
+
+	static void begin() {
+		if (depth()++ == 0) _mm_setcsr(rdouble_sse2_regs.up);
+	}
+
+	static void end() {
+		if (--depth() == 0) _mm_setcsr(rdouble_sse2_regs.nearest);
+	}
+
+	static void print_up(const double& x, std::ostream& s) {
+		char format;
+		if (s.flags() & s.scientific) {
+			if (s.flags() & s.fixed) {
+				format = 'g';
+			} else {
+				format = 'e';
+			}
+		} else {
+			if (s.flags() & s.fixed) {
+				format = 'f';
+			} else {
+				format = 'g';
+			}
+		}
+		s << conv_double::dtostring(x, s.precision(), format, 1);
+	}
+
+	static void print_down(const double& x, std::ostream& s) {
+		char format;
+		if (s.flags() & s.scientific) {
+			if (s.flags() & s.fixed) {
+				format = 'g';
+			} else {
+				format = 'e';
+			}
+		} else {
+			if (s.flags() & s.fixed) {
+				format = 'f';
+			} else {
+				format = 'g';
+			}
+		}
+		s << conv_double::dtostring(x, s.precision(), format, -1);
+	}
+
+	static double fromstring_up(const std::string& s) {
+		return conv_double::stringtod(s, 1);
+	}
+
+	static double fromstring_down(const std::string& s) {
+		return conv_double::stringtod(s, -1);
+	}
+};
+
+template <> struct rop_pair <double> {
+
+	// pack (-x1, x2)
+	static __m128d pack_neg(const double& x1, const double& x2) {
+		return _mm_xor_pd(_mm_set_pd(x2, x1), rop<double>::signmask());
+	}
+
+	static __m128d pack(const double& x1, const double& x2) {
+		return _mm_set_pd(x2, x1);
+	}
+
+	static void unpack_neg(__m128d r, double& rl, double& ru) {
+		r = _mm_xor_pd(r, rop<double>::signmask());
+		rl = _mm_cvtsd_f64(r);
+		ru = _mm_cvtsd_f64(_mm_unpackhi_pd(r, r));
+	}
+
+	static void add(const double& x1, const double& y1, const double& x2, const double& y2, double& rl, double& ru) {
+		unpack_neg(rop<double>::packed_add(pack_neg(x1, x2), pack_neg(y1, y2)), rl, ru);
+	}
+
+	static void sub(const double& x1, const double& y1, const double& x2, const double& y2, double& rl, double& ru) {
+		unpack_neg(rop<double>::packed_sub(pack_neg(x1, x2), pack_neg(y1, y2)), rl, ru);
+	}
+
+	static void mul(const double& x1, const double& y1, const double& x2, const double& y2, double& rl, double& ru) {
+		unpack_neg(rop<double>::packed_mul(pack_neg(x1, x2), pack(y1, y2)), rl, ru);
+	}
+
+	static void div(const double& x1, const double& y1, const double& x2, const double& y2, double& rl, double& ru) {
+		unpack_neg(rop<double>::packed_div(pack_neg(x1, x2), pack(y1, y2)), rl, ru);
+	}
+
+	static void sqrt(const double& x1, const double& x2, double& rl, double& ru) {
+		__m128d s = rop<double>::packed_sqrt(pack(x1, x2));
+		rl = rop<double>::sqrt_down_from_up(x1, _mm_cvtsd_f64(s));
+		ru = _mm_cvtsd_f64(_mm_unpackhi_pd(s, s));
+	}
+};
+
+#undef KV_SSE2_OPAQUE
+
+} // namespace kv
+
+#endif // RDOUBLE_SSE2_HPP
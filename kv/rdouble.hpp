@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2017 Masahide Kashiwagi (kashi@waseda.jp)
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
  */
 
 #ifndef RDOUBLE_HPP
@@ -11,7 +11,11 @@
   #ifdef KV_USE_AVX512
     #include <kv/rdouble-avx512.hpp>
   #else
-    #include <kv/rdouble-hwround.hpp>
+    #ifdef KV_USE_SSE2
+      #include <kv/rdouble-sse2.hpp>
+    #else
+      #include <kv/rdouble-hwround.hpp>
+    #endif
   #endif
 #endif 
 
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2013-2015 Masahide Kashiwagi (kashi@waseda.jp)
+ * Copyright (c) 2013-2026 Masahide Kashiwagi (kashi@waseda.jp)
  */
 
 #ifndef VLEQ_HPP
@@ -12,6 +12,7 @@
 #include <kv/rdouble.hpp>
 #include <kv/interval-vector.hpp>
 #include <kv/matrix-inversion.hpp>
+#include <kv/interval-blas.hpp>
 
 
 namespace kv {
@@ -33,10 +34,9 @@ bool vleq(
 	int s1 = b.size1();
 	int s2 = b.size2();
 	ub::matrix<T> R, E;
-	ub::matrix< interval<T> > EmRA;
-	ub::vector< interval<T> > xtmp(s1), btmp(s1), rtmp(s1);
+	ub::matrix< interval<T> > EmRA, res;
 	bool bo;
-	T norm1, norm2, norm3, err;
+	T norm1, norm2, norm3, err, tmp;
 
 	if (r == NULL) {
 		bo = invert(mid(a), R);
@@ -47,7 +47,7 @@ bool vleq(
 
 	E = ub::identity_matrix<T>(s1);
 
-	EmRA = E - prod(R, a);
+	EmRA = E - iblas::gemm(R, a);
 	norm1 = max_norm(EmRA);
 	rop<T>::begin();
 	norm1 = rop<T>::sub_down(T(1.), norm1);
@@ -59,13 +59,15 @@ bool vleq(
 
 	norm2 = max_norm(R);
 
+	// residuals of all the columns at once
+	res = iblas::gemm(a, x) - b;
+
 	for (i=0; i<s2; i++) {
+		norm3 = 0.;
 		for (j=0; j<s1; j++) {
-			xtmp(j) = x(j, i);
-			btmp(j) = b(j, i);
+			tmp = norm(res(j, i));
+			if (tmp > norm3) norm3 = tmp;
 		}
-		rtmp = prod(a, xtmp) - btmp;
-		norm3 = max_norm(rtmp);
 		rop<T>::begin();
 		err = rop<T>::div_up(rop<T>::mul_up(norm2, norm3), norm1);
 		rop<T>::end();
@@ -0,0 +1,99 @@
+/*
+ * test for compaction of noise symbols of affine arithmetic
+ *  use
+ *   -DAFFINE_REGISTRY=0 (no compaction)
+ *   -DAFFINE_REGISTRY=1 -DAFFINE_COMPACT_MIN=16 (frequent compaction)
+ *  and compare the output. both must be the same.
+ *  with AFFINE_REGISTRY=1, the number of compactions is shown on stderr.
+ */
+
+#include <iostream>
+#include <kv/ode-affine.hpp>
+#include <kv/ode-affine-wrapper.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+typedef kv::affine<double> afd;
+
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+void stat(const char *s)
+{
+	#if AFFINE_REGISTRY
+	std::cerr << s << ": compactions: " << afd::registry_stat().compactions << " removed: " << afd::registry_stat().removed << "\n";
+	#endif
+}
+
+int main()
+{
+	ub::vector<afd> x(3);
+	afd y, z;
+	itv w;
+	int r;
+	itv end;
+	int i;
+
+	std::cout.precision(17);
+
+	// many temporaries in a scope. the noise symbols created by the
+	// nonlinear operations are removed unless they are used by z.
+	{
+		#if AFFINE_REGISTRY
+		kv::affine_compaction<double> compaction;
+		#endif
+
+		x(0) = itv(1., 1.1);
+		x(1) = itv(2., 2.1);
+		x(2) = itv(-1., -0.9);
+		z = 0.;
+		w = 0.;
+		for (i=0; i<200; i++) {
+			y = x(0) * x(1) + sin(x(2) + 0.001 * i) * x(0);
+			y = sqrt(y * y + 1.);
+			w += to_interval(y - x(0));
+			if (i % 10 == 9) z += 0.01 * y;
+		}
+		std::cout << w << "\n";
+		std::cout << to_interval(z) << "\n";
+		std::cout << to_interval(z - 2. * x(0)) << "\n";
+	}
+	stat("loop");
+
+	kv::affine<double>::maxnum() = 0;
+
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+	end = 1.;
+
+	r = kv::odelong_affine(Lorenz(), x, (itv)0., end);
+	if (!r) std::cout << "can't calculate verified solution\n";
+	else {
+		std::cout << to_interval(x) << "\n";
+		std::cout << end << "\n";
+	}
+	stat("odelong_affine");
+
+	kv::affine<double>::maxnum() = 0;
+
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+	end = 1.;
+
+	r = kv::odelong_wrapper(Lorenz(), x, (itv)0., end);
+	if (!r) std::cout << "can't calculate verified solution\n";
+	else {
+		std::cout << to_interval(x) << "\n";
+		std::cout << end << "\n";
+	}
+	stat("odelong_wrapper");
+}
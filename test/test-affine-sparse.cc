@@ -0,0 +1,52 @@
+/*
+ * test for storage of noise symbols of affine arithmetic
+ *  use
+ *   -DAFFINE_SPARSE=0 (dense)
+ *   -DAFFINE_SPARSE=1 (sparse)
+ *  and compare the output. both must be the same.
+ */
+
+#include <iostream>
+#include <kv/affine.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+typedef kv::affine<double> afd;
+
+int main()
+{
+	ub::vector<afd> x(3);
+	afd y, s1, s2;
+	int i;
+
+	std::cout.precision(17);
+
+	// variables which have no common noise symbols
+	x(0) = itv(1., 1.1);
+	for (i=0; i<100; i++) y = itv(-0.01, 0.01);
+	x(1) = itv(2., 2.1) + y;
+	for (i=0; i<100; i++) y = itv(-0.01, 0.01);
+	x(2) = itv(-1., -0.9) - y;
+
+	for (i=0; i<20; i++) {
+		x(0) = x(0) * x(1) - 0.5 * x(2);
+		x(1) = sqrt(abs(x(1)) + 1.) / 3.;
+		x(2) = exp(-x(2) * x(2)) + log(x(1) + 2.) - 1. / (x(0) * x(0) + 1.);
+		x(0) = x(0) / 4.;
+		std::cout << to_interval(x) << "\n";
+	}
+
+	std::cout << x(2) << "\n";
+
+	split(x(0), 150, s1, s2);
+	std::cout << to_interval(s1) << to_interval(s2) << "\n";
+	std::cout << to_interval(append(s1, s2)) << "\n";
+
+	kv::epsilon_reduce(x, 10);
+	std::cout << x << "\n";
+
+	x(0) = sin(x(0)) + cos(x(1)) * atan(x(2));
+	kv::epsilon_reduce2(x, 5);
+	std::cout << x << "\n";
+}
@@ -0,0 +1,167 @@
+#include <iostream>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/autodif.hpp>
+#include <kv/autodif-reverse.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+// f: R->R
+template <class T> T testfunc2(const T& x) {
+	T tmp;
+
+	tmp = x * x - 1.;
+	return cos(tmp + sin(tmp));
+}
+
+// f: R^n->R
+template <class T> T testfunc3(const ub::vector<T>& x) {
+	return atan(x(0) * x(0) + 2. * x(1) * x(1) - 1.);
+}
+
+// f: R^n->R^n
+template <class T> ub::vector<T> testfunc5(const ub::vector<T>& x) {
+	ub::vector<T> y(2);
+
+	y(0) = 2. * x(0) * x(0) * x(1) - 1.;
+	y(1) = x(0) + 0.5 * x(1) * x(1) - 2.;
+
+	return y;
+}
+
+// f: R^n->R^m whose output is an independent variable itself
+template <class T> ub::vector<T> testfunc7(const ub::vector<T>& x) {
+	ub::vector<T> y(2);
+
+	y(0) = x(0);
+	y(1) = x(1) * x(2);
+
+	return y;
+}
+
+// f: R^n->R with many variables (Rosenbrock)
+template <class T> T testfunc6(const ub::vector<T>& x) {
+	int i;
+	int n = x.size();
+	T r, tmp, tmp2;
+
+	r = 0.;
+	for (i=0; i<n-1; i++) {
+		tmp = 1. - x(i);
+		tmp2 = x(i+1) - x(i) * x(i);
+		r += tmp * tmp + 100. * tmp2 * tmp2;
+	}
+
+	return r;
+}
+
+
+int main()
+{
+	double d1, d2;
+	itv i1;
+	ub::vector<double> v1, v2;
+	ub::vector<itv> iv1, iv2;
+	ub::matrix<double> m;
+	kv::autodif_reverse<double> a1, a2, a3;
+	ub::vector< kv::autodif_reverse<double> > va1;
+	int i;
+
+	std::cout.precision(17);
+
+	//
+	// f: R->R
+	//
+
+	kv::autodif_reverse<double>::split(testfunc2(kv::autodif_reverse<double>::init(1.5)), d1, d2);
+	std::cout << "testfunc2\n";
+	std::cout << d1 << "\n"; // f(1.5)
+	std::cout << d2 << "\n"; // f'(1.5)
+
+	//
+	// f: R^n->R
+	//
+
+	v1.resize(2);
+	v1(0) = 5.; v1(1) = 6.;
+	kv::autodif_reverse<double>::split(testfunc3(kv::autodif_reverse<double>::init(v1)), d1, v2);
+	std::cout << "testfunc3\n";
+	std::cout << d1 << "\n"; // f(5, 6)
+	std::cout << v2 << "\n"; // gradient
+
+	//
+	// f: R^n->R^m
+	//
+
+	kv::autodif_reverse<double>::split(testfunc5(kv::autodif_reverse<double>::init(v1)), v2, m);
+	std::cout << "testfunc5\n";
+	std::cout << v2 << "\n"; // f(5, 6)
+	std::cout << m << "\n"; // Jacobian matrix
+
+	v1.resize(3);
+	v1(0) = 5.; v1(1) = 6.; v1(2) = 7.;
+	kv::autodif_reverse<double>::split(testfunc7(kv::autodif_reverse<double>::init(v1)), v2, m);
+	std::cout << "testfunc7\n";
+	std::cout << v2 << "\n"; // f(5, 6, 7)
+	std::cout << m << "\n"; // Jacobian matrix
+	v1.resize(2);
+
+	//
+	// operations
+	//
+
+	v1(0) = 0.7; v1(1) = 0.8;
+	va1 = kv::autodif_reverse<double>::init(v1);
+	a1 = va1(0);
+	a2 = va1(1);
+
+	std::cout << "autodif_reverse operations\n";
+
+	a3 = a1 + a2; kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = a1 - a2; kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = a1 * a2; kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = a1 / a2; kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = pow(a1, 3); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = pow(a1, a2); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = sqrt(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = exp(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = log(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = sin(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = cos(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = tan(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = sinh(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = cosh(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = tanh(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = asin(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = acos(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	a3 = atan(a1); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+	// constant
+	a3 = kv::autodif_reverse<double>(3.); kv::autodif_reverse<double>::split(a3, d1, v2); std::cout << d1 << v2 << "\n";
+
+	//
+	// interval gradient with many variables compared with autodif
+	//
+
+	std::cout << "testfunc6\n";
+	iv1.resize(100);
+	for (i=0; i<100; i++) iv1(i) = itv(i * 0.01, i * 0.01 + 0.001);
+
+	kv::autodif_reverse<itv>::reserve(1000);
+	kv::autodif_reverse<itv>::split(testfunc6(kv::autodif_reverse<itv>::init(iv1)), i1, iv2);
+	std::cout << i1 << "\n";
+	std::cout << iv2(0) << "\n";
+	std::cout << iv2(50) << "\n";
+	std::cout << iv2(99) << "\n";
+	std::cout << "tape: " << kv::autodif_reverse<itv>::tape().nodes.size() << "\n";
+
+	kv::autodif<itv>::split(testfunc6(kv::autodif<itv>::init(iv1)), i1, iv2);
+	std::cout << i1 << "\n";
+	std::cout << iv2(0) << "\n";
+	std::cout << iv2(50) << "\n";
+	std::cout << iv2(99) << "\n";
+}
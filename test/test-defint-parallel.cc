@@ -0,0 +1,94 @@
+/*
+ * test of DEFINT_PARALLEL
+ *  compile with -fopenmp. the integrals computed with 1 thread (serial
+ *  path) and 2 threads (parallel path) must be the same, and the
+ *  exceptions thrown in the parallel path must reach the caller.
+ */
+
+#define DEFINT_PARALLEL 1
+
+#include <iostream>
+#include <stdexcept>
+#include <kv/defint.hpp>
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+typedef kv::interval<double> itv;
+
+
+struct Func {
+	template <class T> T operator() (const T& x) {
+		return 1./x;
+	}
+};
+
+struct Func2 {
+	template <class T> T operator() (const T& x) {
+		return exp(-x * x) * cos(3. * x);
+	}
+};
+
+// throws an exception other than std::domain_error
+struct Func3 {
+	template <class T> T operator() (const T& x) {
+		throw std::runtime_error("Func3");
+		return x;
+	}
+};
+
+void set_threads(int n) {
+	#ifdef _OPENMP
+	omp_set_num_threads(n);
+	#endif
+}
+
+void check(const char* s, const itv& x, const itv& y) {
+	std::cout << s << ": " << x << " " << (x.lower() == y.lower() && x.upper() == y.upper() ? "same" : "DIFFERENT") << "\n";
+}
+
+int main() {
+	itv r1, r2;
+
+	std::cout.precision(17);
+
+	set_threads(1);
+	r1 = kv::defint(Func(), (itv)1., (itv)3., 10, 10);
+	set_threads(2);
+	r2 = kv::defint(Func(), (itv)1., (itv)3., 10, 10);
+	check("defint", r1, r2);
+
+	set_threads(1);
+	r1 = kv::defint(Func2(), (itv)-2., (itv)2., 12, 16);
+	set_threads(2);
+	r2 = kv::defint(Func2(), (itv)-2., (itv)2., 12, 16);
+	check("defint", r1, r2);
+
+	set_threads(1);
+	r1 = kv::defint_autostep(Func(), (itv)1., (itv)3., 12);
+	set_threads(2);
+	r2 = kv::defint_autostep(Func(), (itv)1., (itv)3., 12);
+	check("defint_autostep", r1, r2);
+
+	set_threads(1);
+	r1 = kv::defint_autostep(Func2(), (itv)-2., (itv)2., 12);
+	set_threads(2);
+	r2 = kv::defint_autostep(Func2(), (itv)-2., (itv)2., 12);
+	check("defint_autostep", r1, r2);
+
+	try {
+		kv::defint(Func3(), (itv)0., (itv)1., 10, 10);
+		std::cout << "defint: no exception\n";
+	}
+	catch (std::runtime_error& e) {
+		std::cout << "defint: " << e.what() << "\n";
+	}
+
+	try {
+		kv::defint_autostep(Func3(), (itv)0., (itv)1., 12);
+		std::cout << "defint_autostep: no exception\n";
+	}
+	catch (std::runtime_error& e) {
+		std::cout << "defint_autostep: " << e.what() << "\n";
+	}
+}
@@ -161,11 +161,34 @@ struct Func7_g {
 	}
 };
 
+/*
+ * \int_0^1 \int_0^1 x^2 (1+y)^2 dx dy = 7/9
+ *  as (f)^1 g with f = x^2 (1+y)^2 (multiplicity of f_x = 2), g = 1.
+ *  the terms x^2 y^k of f must not lose the factor x^2 by truncation.
+ *  the enclosure of nested psa is wide with order 2. the width with
+ *  mpsa is checked by test-doubleintegral-mpsa.
+ */
+
+struct Func8_f {
+	template <class T> T operator() (const T& x, const T& y) {
+		return x * x * ((1. + y) * (1. + y));
+	}
+};
+
+struct Func8_g {
+	template <class T> T operator() (const T& x, const T& y) {
+		return T(1.);
+	}
+};
+
 
 typedef kv::interval<double> itv;
 
 int main()
 {
+	int i, j;
+	itv r, s;
+
 	std::cout.precision(17);
 
 	// singularity with edge x=0 and edge y=0
@@ -198,6 +221,14 @@ int main()
 
 	std::cout << kv::doubleintegral_power3_r1(Func5_f(), Func5_g(), itv(0.), itv(0.125), itv(0.), itv(0.125), 12, itv(0.5), 1, 0) << "\n";
 
+	// multiplicity 2 and low order
+
+	std::cout << "\\int_0^1 \\int_0^1 x^2 (1+y)^2 dx dy = 7/9\n";
+
+	r = kv::doubleintegral_power3(Func8_f(), Func8_g(), itv(0.), itv(1.), itv(0.), itv(1.), 2, itv(1.), 2, 0);
+	std::cout << r << "\n";
+	std::cout << "contains 7/9: " << subset(itv(7.) / 9., r) << "\n";
+
 	// singularity with point (0,0)
 	std::cout << "\\int_0^{0.1} \\int_0^x \\sqrt{x + y} dy dx = 0.0154187...\n";
 
@@ -208,8 +239,6 @@ int main()
 
 	std::cout << "\\int_{-1}^1 \\int_{-1}^1 (x^2+y^2)^(1/4) * \\cos{xy} dx dy = 3.2003...\n";
 
-	int i, j;
-	itv r, s;
 	int div = 4;
 	s = 2. / div;
 	r = 0.;
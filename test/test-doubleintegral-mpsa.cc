@@ -0,0 +1,114 @@
+/*
+ * test of DOUBLEINTEGRAL_MPSA
+ *  doubleintegral and doubleintegral_power3 with mpsa instead of
+ *  nested psa. the results must be the same as test-doubleintegral and
+ *  test-doubleint-singular up to the last few digits, and the
+ *  truncation of the terms x^2 y^k in Func8 must keep the enclosure of
+ *  7/9 narrow ("narrow: 1").
+ */
+
+#define DOUBLEINTEGRAL_MPSA 1
+
+#include <iostream>
+#include <kv/doubleintegral.hpp>
+#include <kv/doubleint-singular.hpp>
+
+typedef kv::interval<double> itv;
+
+struct Func {
+	template <class T> T operator() (const T& x, const T& y) {
+		return 1. / (x * x + 2 * y * y + 1.);
+	}
+};
+
+/*
+ * \int_0^{0.125} \int_0^{0.125} \sqrt{x y} \cos{xy} dx dy
+ *  = 0.000868036...
+ */
+
+struct Func1_f {
+	template <class T> T operator() (const T& x, const T& y) {
+		return x * y;
+	}
+};
+
+struct Func1_g {
+	template <class T> T operator() (const T& x, const T& y) {
+		return cos(x * y);
+	}
+};
+
+/*
+ * \int_0^{0.125} \int_0^{0.125} \sqrt{\sin{0.125-x}\cos{y}} \cos{xy} dx dy
+ *  = 0.00367596...
+ */
+
+struct Func5_f {
+	template <class T> T operator() (const T& x, const T& y) {
+		return sin(0.125-x) * cos(y);
+	}
+};
+
+struct Func5_g {
+	template <class T> T operator() (const T& x, const T& y) {
+		return cos(x * y);
+	}
+};
+
+/*
+ *  \int_0^{0.1} \int_0^x \sqrt{x + y} dy dx = 0.0154187...
+ */
+
+struct Func6_f {
+	template <class T> T operator() (const T& x, const T& y) {
+		return x + y;
+	}
+};
+
+struct Func6_g {
+	template <class T> T operator() (const T& x, const T& y) {
+		return T(1);
+	}
+};
+
+/*
+ * \int_0^1 \int_0^1 x^2 (1+y)^2 dx dy = 7/9
+ *  as (f)^1 g with f = x^2 (1+y)^2 (multiplicity of f_x = 2), g = 1.
+ */
+
+struct Func8_f {
+	template <class T> T operator() (const T& x, const T& y) {
+		return x * x * ((1. + y) * (1. + y));
+	}
+};
+
+struct Func8_g {
+	template <class T> T operator() (const T& x, const T& y) {
+		return T(1.);
+	}
+};
+
+int main()
+{
+	itv r;
+
+	std::cout.precision(17);
+
+	std::cout << kv::doubleintegral(Func(), (itv)(-1.), (itv)1., (itv)(-1.), (itv)1., 8, 20) << "\n";
+	std::cout << kv::doubleintegral_triangle(Func(), (itv)(-1.), (itv)(-1.), (itv)(-1.), (itv)1., (itv)1., (itv)(-1.), 8, 20) << "\n";
+
+	std::cout << "\\int_0^{0.125} \\int_0^{0.125} \\sqrt{x y} \\cos{xy} dx dy = 0.000868036...\n";
+	std::cout << kv::doubleintegral_power3(Func1_f(), Func1_g(), itv(0.), itv(0.125), itv(0.), itv(0.125), 12, itv(0.5), 1, 1) << "\n";
+
+	std::cout << "\\int_0^{0.125} \\int_0^{0.125} \\sqrt{\\sin{0.125-x}\\cos{y}} \\cos{xy} dx dy = 0.00367596...\n";
+	std::cout << kv::doubleintegral_power3_r1(Func5_f(), Func5_g(), itv(0.), itv(0.125), itv(0.), itv(0.125), 12, itv(0.5), 1, 0) << "\n";
+
+	std::cout << "\\int_0^1 \\int_0^1 x^2 (1+y)^2 dx dy = 7/9\n";
+	r = kv::doubleintegral_power3(Func8_f(), Func8_g(), itv(0.), itv(1.), itv(0.), itv(1.), 2, itv(1.), 2, 0);
+	std::cout << r << "\n";
+	std::cout << "contains 7/9: " << subset(itv(7.) / 9., r) << "\n";
+	std::cout << "narrow: " << (width(r) < 1.5) << "\n";
+
+	std::cout << "\\int_0^{0.1} \\int_0^x \\sqrt{x + y} dy dx = 0.0154187...\n";
+	std::cout << kv::doubleintegral_singular_point(Func6_f(), Func6_g(), itv(0.), itv(0.), itv("0.1"), itv(0.), itv("0.1"), itv("0.1"), 12, itv(0.5), 1) << "\n";
+}
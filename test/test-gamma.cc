@@ -1,8 +1,30 @@
+/*
+ * compile also with -DGAMMA_CACHE=1 to check the values by the table
+ * for double and dd (building the table for dd takes a few minutes).
+ */
+
 #include <iostream>
 #include <kv/gamma.hpp>
+#if GAMMA_CACHE
+#include <kv/dd.hpp>
+#include <kv/rdd.hpp>
+#endif
 
 typedef kv::interval<double> itv;
 
+#if GAMMA_CACHE
+template <class T> void check_cache() {
+	typedef kv::interval<T> I;
+
+	// gamma(1.5) = sqrt(pi)/2, gamma(1.25) = gamma(0.25)/4,
+	// digamma(1) = -euler, digamma(1.5) = 2 - euler - 2 log(2)
+	std::cout << subset(I("0.88622692545275801364908374167057259139877472806119"), kv::gamma(I(1.5))) << "\n";
+	std::cout << subset(I("0.90640247705547707798267128896691800074879192072"), kv::gamma(I(1.25))) << "\n";
+	std::cout << subset(I("-0.57721566490153286060651209008240243104215933593992"), kv::digamma(I(1.))) << "\n";
+	std::cout << subset(I("0.03648997397857652055902366700124443280684039533960"), kv::digamma(I(1.5))) << "\n";
+}
+#endif
+
 int main() {
 	int i;
 	std::cout.precision(17);
@@ -42,4 +64,9 @@ int main() {
 	for (i=1; i<=300; i++) {
 		std::cout << kv::digamma_zero(-(double)i+0.5) << "\n";
 	}
+
+	#if GAMMA_CACHE
+	check_cache<double>();
+	check_cache<kv::dd>();
+	#endif
 }
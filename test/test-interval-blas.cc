@@ -0,0 +1,231 @@
+// sample program for "interval-blas.hpp"
+//  compare iblas::dot, axpy, gemv and gemm with ub::prod,
+//  iblas::conv, conv_tail, horner and mconv with loops of interval operators
+//  and check enclosure by iblas::gemm_midrad
+
+#include <iostream>
+#include <ctime>
+#include <boost/random.hpp>
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/matrix.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/dd.hpp>
+#include <kv/rdd.hpp>
+#include <kv/interval-blas.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+boost::variate_generator<boost::mt19937, boost::uniform_real<> > rand1(boost::mt19937(1), boost::uniform_real<>(-1., 1.));
+
+template <class T> kv::interval<T> random_interval() {
+	double a = rand1(), b = rand1();
+	// some point intervals and intervals touching zero
+	if (a > 0.8) return kv::interval<T>(0., b > 0. ? b : -b);
+	if (a < -0.8) return kv::interval<T>(b);
+	return kv::interval<T>::hull(T(a), T(b));
+}
+
+template <class T> bool same(const kv::interval<T>& x, const kv::interval<T>& y) {
+	return x.lower() == y.lower() && x.upper() == y.upper();
+}
+
+template <class T> bool check(int n, int m) {
+	int i, j;
+	bool ok = true;
+	ub::matrix< kv::interval<T> > A(n, m), B(m, n), C1, C2;
+	ub::matrix<T> R(n, m);
+	ub::vector< kv::interval<T> > x(m), y(m), z1, z2;
+	kv::interval<T> a, d1, d2;
+
+	for (i=0; i<n; i++) {
+		for (j=0; j<m; j++) {
+			A(i, j) = random_interval<T>();
+			B(j, i) = random_interval<T>();
+			R(i, j) = rand1();
+		}
+	}
+	for (i=0; i<m; i++) {
+		x(i) = random_interval<T>();
+		y(i) = random_interval<T>();
+	}
+	a = random_interval<T>();
+
+	C1 = prod(A, B);
+	C2 = kv::iblas::gemm(A, B);
+	for (i=0; i<n; i++) for (j=0; j<n; j++) ok = ok && same(C1(i, j), C2(i, j));
+
+	C1 = prod(R, B);
+	C2 = kv::iblas::gemm(R, B);
+	for (i=0; i<n; i++) for (j=0; j<n; j++) ok = ok && same(C1(i, j), C2(i, j));
+
+	C1 = prod(B, R);
+	C2 = kv::iblas::gemm(B, R);
+	for (i=0; i<m; i++) for (j=0; j<m; j++) ok = ok && same(C1(i, j), C2(i, j));
+
+	z1 = prod(A, x);
+	z2 = kv::iblas::gemv(A, x);
+	for (i=0; i<n; i++) ok = ok && same(z1(i), z2(i));
+
+	z1 = prod(R, x);
+	z2 = kv::iblas::gemv(R, x);
+	for (i=0; i<n; i++) ok = ok && same(z1(i), z2(i));
+
+	d1 = kv::interval<T>(0.);
+	for (i=0; i<m; i++) d1 += x(i) * y(i);
+	d2 = kv::iblas::dot(x, y);
+	ok = ok && same(d1, d2);
+
+	z1 = y + a * x;
+	z2 = y;
+	kv::iblas::axpy(a, x, z2);
+	for (i=0; i<m; i++) ok = ok && same(z1(i), z2(i));
+
+	return ok;
+}
+
+template <class T> bool check_conv(int n) {
+	int i, j, k;
+	bool ok = true;
+	ub::vector< kv::interval<T> > a(n), b(n), r1(n), r2(n);
+	kv::interval<T> s, d;
+
+	for (i=0; i<n; i++) {
+		a(i) = random_interval<T>();
+		b(i) = random_interval<T>();
+	}
+	d = kv::interval<T>(0., 0.25);
+
+	for (k=0; k<n; k+=5) {
+		for (i=k; i<n; i++) {
+			s = 0.;
+			for (j=0; j<=i; j++) s += a(j) * b(i-j);
+			r1(i) = s;
+		}
+		kv::iblas::conv(a, b, r2, k);
+		for (i=k; i<n; i++) ok = ok && same(r1(i), r2(i));
+	}
+
+	for (i=1; i<n; i++) {
+		s = 0.;
+		for (j=i; j<n; j++) s += a(j) * b(i-j+n-1);
+		r1(i) = s;
+	}
+	kv::iblas::conv_tail(a, b, r2);
+	for (i=1; i<n; i++) ok = ok && same(r1(i), r2(i));
+
+	s = a(n-1);
+	for (i=n-2; i>=0; i--) s = s * d + a(i);
+	ok = ok && same(s, kv::iblas::horner(a, 0, n-1, d));
+
+	return ok;
+}
+
+// product of polynomials of 2 and 3 variables of degree <= da, db
+// in graded lexicographic order, summed in the same order as mconv.
+template <class T> bool check_mconv(int da, int db) {
+	int i, dp, dq, sp, sq, jp, jq;
+	int n2 = (da + 1) * (da + 2) / 2, n3 = (da + 1) * (da + 2) * (da + 3) / 6;
+	int m2 = (db + 1) * (db + 2) / 2, m3 = (db + 1) * (db + 2) * (db + 3) / 6;
+	bool ok = true;
+	ub::vector< kv::interval<T> > a(n3), b(m3), r1, r2;
+
+	for (i=0; i<n3; i++) a(i) = random_interval<T>();
+	for (i=0; i<m3; i++) b(i) = random_interval<T>();
+
+	#define OFF2(k) ((k) * ((k) + 1) / 2)
+	#define OFF3(k) ((k) * ((k) + 1) * ((k) + 2) / 6)
+
+	ub::vector< kv::interval<T> > a2(n2), b2(m2);
+	for (i=0; i<n2; i++) a2(i) = a(i);
+	for (i=0; i<m2; i++) b2(i) = b(i);
+	r1.resize(OFF2(da + db + 1));
+	for (i=0; i<r1.size(); i++) r1(i) = 0.;
+	for (dp=0; dp<=da; dp++) for (dq=0; dq<=db; dq++) {
+		for (jp=0; jp<=dp; jp++) for (jq=0; jq<=dq; jq++) {
+			r1(OFF2(dp + dq) + jp + jq) += a2(OFF2(dp) + jp) * b2(OFF2(dq) + jq);
+		}
+	}
+	kv::iblas::mconv(2, a2, da, b2, db, r2);
+	ok = ok && r1.size() == r2.size();
+	for (i=0; ok && i<r1.size(); i++) ok = same(r1(i), r2(i));
+
+	r1.resize(OFF3(da + db + 1));
+	for (i=0; i<r1.size(); i++) r1(i) = 0.;
+	for (dp=0; dp<=da; dp++) for (dq=0; dq<=db; dq++) {
+		for (sp=0; sp<=dp; sp++) for (sq=0; sq<=dq; sq++) {
+			for (jp=0; jp<=sp; jp++) for (jq=0; jq<=sq; jq++) {
+				r1(OFF3(dp + dq) + OFF2(sp + sq) + jp + jq) += a(OFF3(dp) + OFF2(sp) + jp) * b(OFF3(dq) + OFF2(sq) + jq);
+			}
+		}
+	}
+	kv::iblas::mconv(3, a, da, b, db, r2);
+	ok = ok && r1.size() == r2.size();
+	for (i=0; ok && i<r1.size(); i++) ok = same(r1(i), r2(i));
+
+	#undef OFF2
+	#undef OFF3
+
+	return ok;
+}
+
+// gemm_midrad must enclose A B for sample points of A and B,
+// and contain gemm(A, B) if both are thick interval matrices.
+template <class T> bool check_midrad(int n, int m) {
+	int i, j, l;
+	bool ok = true;
+	ub::matrix< kv::interval<T> > A(n, m), B(m, n), Ap(n, m), Bp(m, n), C1, C2, P;
+	ub::matrix<T> R(n, m);
+
+	for (i=0; i<n; i++) {
+		for (j=0; j<m; j++) {
+			A(i, j) = kv::interval<T>::hull(T(rand1()), T(rand1()));
+			B(j, i) = kv::interval<T>::hull(T(rand1()), T(rand1()));
+			R(i, j) = rand1();
+		}
+	}
+
+	C1 = kv::iblas::gemm(A, B);
+	C2 = kv::iblas::gemm_midrad(A, B);
+	for (i=0; i<n; i++) for (j=0; j<n; j++) ok = ok && subset(C1(i, j), C2(i, j));
+
+	for (l=0; l<3; l++) {
+		for (i=0; i<n; i++) {
+			for (j=0; j<m; j++) {
+				Ap(i, j) = (l == 0) ? A(i, j).lower() : (l == 1) ? A(i, j).upper() : mid(A(i, j));
+				Bp(j, i) = (l == 0) ? B(j, i).upper() : (l == 1) ? B(j, i).lower() : mid(B(j, i));
+			}
+		}
+		P = prod(Ap, Bp);
+		for (i=0; i<n; i++) for (j=0; j<n; j++) ok = ok && overlap(P(i, j), C2(i, j));
+		P = prod(R, Bp);
+		C2 = kv::iblas::gemm_midrad(R, B);
+		for (i=0; i<n; i++) for (j=0; j<n; j++) ok = ok && overlap(P(i, j), C2(i, j));
+		C2 = kv::iblas::gemm_midrad(A, B);
+	}
+
+	return ok;
+}
+
+int main()
+{
+	std::cout << "double: " << (check<double>(37, 29) ? "OK" : "NG") << "\n";
+	std::cout << "dd: " << (check<kv::dd>(7, 5) ? "OK" : "NG") << "\n";
+	std::cout << "midrad double: " << (check_midrad<double>(37, 29) ? "OK" : "NG") << "\n";
+	std::cout << "midrad dd: " << (check_midrad<kv::dd>(7, 5) ? "OK" : "NG") << "\n";
+	std::cout << "conv double: " << (check_conv<double>(25) && check_conv<double>(23) ? "OK" : "NG") << "\n";
+	std::cout << "conv dd: " << (check_conv<kv::dd>(25) ? "OK" : "NG") << "\n";
+	std::cout << "mconv double: " << (check_mconv<double>(8, 8) && check_mconv<double>(5, 11) ? "OK" : "NG") << "\n";
+	std::cout << "mconv dd: " << (check_mconv<kv::dd>(4, 3) ? "OK" : "NG") << "\n";
+
+	ub::matrix< kv::interval<double> > A(2, 2);
+	ub::vector< kv::interval<double> > x(2);
+	A(0, 0) = 1.; A(0, 1) = kv::interval<double>(-1., 2.);
+	A(1, 0) = kv::interval<double>(0., 1.); A(1, 1) = 3.;
+	x(0) = kv::interval<double>(1., 2.); x(1) = kv::interval<double>(-1., 1.);
+	std::cout << kv::iblas::gemv(A, x) << "\n";
+	std::cout << kv::iblas::gemm(A, A) << "\n";
+	std::cout << kv::iblas::gemm_midrad(A, A) << "\n";
+	std::cout << kv::iblas::dot(x, x) << "\n";
+}
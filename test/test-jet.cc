@@ -0,0 +1,75 @@
+#include <boost/numeric/ublas/vector.hpp>
+#include <boost/numeric/ublas/io.hpp>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/autodif.hpp>
+#include <kv/jet.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+typedef kv::jet<itv, 4> jet;
+
+// f: R^n->R^n
+template <class T> ub::vector<T> testfunc(const ub::vector<T>& x) {
+	ub::vector<T> y(2);
+
+	y(0) = 2. * x(0) * x(0) * x(1) - exp(x(1));
+	y(1) = x(0) / (1. + 0.5 * x(1) * x(1)) + atan(x(0));
+
+	return y;
+}
+
+
+int main()
+{
+	ub::vector< kv::autodif<itv> > a;
+	ub::vector<jet> j(2);
+	ub::vector< kv::psa< kv::autodif<itv> > > pa, ra;
+	ub::vector< kv::psa<jet> > pj(2), rj;
+	ub::vector<itv> x(2);
+	int i, k;
+
+	std::cout.precision(17);
+
+	x(0) = 1.;
+	x(1) = itv(2., 2.1);
+
+	//
+	// value and Jacobian
+	//
+
+	a = kv::autodif<itv>::init(x);
+	for (i=0; i<2; i++) j(i) = jet(a(i));
+
+	a = testfunc(a);
+	j = testfunc(j);
+
+	std::cout << a << "\n";
+	std::cout << j << "\n";
+
+	//
+	// Taylor series with the Jacobian
+	//
+
+	a = kv::autodif<itv>::init(x);
+	pa.resize(2);
+	for (i=0; i<2; i++) {
+		pa(i).v.resize(3);
+		pa(i).v(0) = a(i);
+		pa(i).v(1) = 1.;
+		pa(i).v(2) = 0.5;
+		pj(i).v.resize(3);
+		for (k=0; k<3; k++) pj(i).v(k) = jet(pa(i).v(k));
+	}
+
+	ra = testfunc(pa);
+	rj = testfunc(pj);
+
+	for (i=0; i<2; i++) {
+		for (k=0; k<ra(i).v.size(); k++) {
+			std::cout << ra(i).v(k) << "\n";
+			std::cout << rj(i).v(k) << "\n";
+		}
+	}
+}
@@ -0,0 +1,70 @@
+#include <iostream>
+#include <kv/kraw-approx.hpp>
+#include <kv/kraw-approx-sparse.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+// x'' = - x^3 - 3, x(0) = x(1) = 0 (the same equation as test-bvp.cc)
+// discretized by central difference with n interior points
+
+struct BVP {
+	int n;
+	BVP(int n) : n(n) {}
+
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x){
+		ub::vector<T> y(n);
+		itv h = 1. / itv(n + 1.);
+		int i;
+
+		for (i=0; i<n; i++) {
+			y(i) = -2. * x(i) + h * h * (x(i) * x(i) * x(i) + 3.);
+			if (i > 0) y(i) += x(i-1);
+			if (i < n-1) y(i) += x(i+1);
+		}
+
+		return y;
+	}
+};
+
+void print(const ub::vector<itv>& x)
+{
+	int i, n = x.size();
+	double w = 0.;
+
+	for (i=0; i<n; i++) w = std::max(w, width(x(i)));
+	std::cout << x(0) << " " << x(n/2) << " " << x(n-1) << " width: " << w << "\n";
+}
+
+int main()
+{
+	ub::vector<double> x;
+	ub::vector<itv> ix, ix2;
+	bool r;
+	int n;
+
+	std::cout.precision(17);
+
+	// compared with krawczyk_approx
+
+	n = 50;
+	x = ub::zero_vector<double>(n);
+	r = kv::krawczyk_approx(BVP(n), x, ix, 5, 0);
+	std::cout << r << "\n";
+	if (r) print(ix);
+	r = kv::krawczyk_approx_sparse(BVP(n), x, ix2, 5, 0);
+	std::cout << r << "\n";
+	if (r) {
+		print(ix2);
+		std::cout << overlap(ix, ix2) << "\n";
+	}
+
+	// large system
+
+	n = 5000;
+	x = ub::zero_vector<double>(n);
+	r = kv::krawczyk_approx_sparse(BVP(n), x, ix, 5, 0);
+	std::cout << r << "\n";
+	if (r) print(ix);
+}
@@ -0,0 +1,82 @@
+#include <iostream>
+#include <kv/interval.hpp>
+#include <kv/rdouble.hpp>
+#include <kv/mpsa.hpp>
+
+typedef kv::interval<double> itv;
+typedef kv::mpsa<itv, 2> mpsa2;
+typedef kv::mpsa<itv, 3> mpsa3;
+
+/*
+ * \int_0^1 \int_0^1 \int_0^1 f(x, y, z) dx dy dz
+ * by Taylor expansion of three variables on n^3 cubes
+ */
+
+template <class F> itv tripleintegral(F f, int order, int n)
+{
+	int i, j, k, l;
+	itv h, r, c[3], result;
+	mpsa3 x[3], y;
+
+	h = itv(1.) / n;
+	r = h / 2.;
+	for (l=0; l<3; l++) mpsa3::domain(l) = itv(-r.upper(), r.upper());
+
+	result = 0.;
+	for (i=0; i<n; i++) {
+		for (j=0; j<n; j++) {
+			for (k=0; k<n; k++) {
+				c[0] = i * h + r;
+				c[1] = j * h + r;
+				c[2] = k * h + r;
+				for (l=0; l<3; l++) x[l] = mpsa3::variable(c[l], l, order);
+				y = f(x[0], x[1], x[2]);
+				for (l=0; l<3; l++) {
+					y = integrate(y, l);
+					y = eval(y, l, r) - eval(y, l, -r);
+				}
+				result += y.v(0);
+			}
+		}
+	}
+
+	return result;
+}
+
+struct Func {
+	template <class T> T operator() (const T& x, const T& y, const T& z) {
+		return exp(x + y + z);
+	}
+};
+
+struct Func2 {
+	template <class T> T operator() (const T& x, const T& y, const T& z) {
+		return 1. / (1. + x * x + y * y + z * z);
+	}
+};
+
+int main()
+{
+	mpsa2 x, y;
+
+	std::cout.precision(17);
+
+	// coefficients of 1, x, y, x^2, xy, y^2
+	mpsa2::domain(0) = itv(-0.5, 0.5);
+	mpsa2::domain(1) = itv(-0.5, 0.5);
+	x = mpsa2::variable(itv(1.), 0, 2);
+	y = mpsa2::variable(itv(2.), 1, 2);
+	std::cout << x * y << "\n";
+	std::cout << (x + y) * (x - y) << "\n";
+
+	// terms of degree 3 and 4 are bounded on the domain
+	std::cout << x * x * y * y << "\n";
+	std::cout << exp(x + y) << "\n";
+	std::cout << evalrange(exp(x + y)) << "\n";
+
+	// (e-1)^3 = 5.0732...
+	std::cout << tripleintegral(Func(), 10, 4) << "\n";
+
+	// 0.53585675...
+	std::cout << tripleintegral(Func2(), 10, 4) << "\n";
+}
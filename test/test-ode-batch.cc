@@ -0,0 +1,110 @@
+/*
+ * test for odelong_batch and odelong_maffine_batch
+ *  compile with -fopenmp to run the boxes in parallel.
+ *  the results must be the same as the serial loop of odelong /
+ *  odelong_maffine ("same: 1"), and exceptions thrown in the
+ *  parallel loop must reach the caller.
+ */
+
+#include <iostream>
+#include <vector>
+#include <stdexcept>
+#include <kv/ode-batch.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+typedef std::vector< ub::vector<itv> > boxes;
+
+
+struct VDP {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(2);
+
+		y(0) = x(1);
+		y(1) = (1. - x(0)*x(0)) * x(1) - x(0);
+
+		return y;
+	}
+};
+
+// throws an exception other than std::domain_error
+struct Throw {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		throw std::runtime_error("Throw");
+		return x;
+	}
+};
+
+bool same(const boxes& x, const boxes& y)
+{
+	int i, j;
+
+	if (x.size() != y.size()) return false;
+	for (i=0; i<(int)x.size(); i++) {
+		for (j=0; j<(int)x[i].size(); j++) {
+			if (x[i](j).lower() != y[i](j).lower()) return false;
+			if (x[i](j).upper() != y[i](j).upper()) return false;
+		}
+	}
+	return true;
+}
+
+int main()
+{
+	boxes init, x, x1;
+	std::vector<int> status;
+	std::vector<itv> reached;
+	ub::vector<itv> b(2);
+	itv end, e;
+	int i, j, n;
+
+	std::cout.precision(17);
+
+	// 3 x 3 small boxes on [-2, 2]^2
+	for (i=0; i<3; i++) {
+		for (j=0; j<3; j++) {
+			b(0) = itv(-2. + 2. * i, -2. + 2. * i + 1e-4);
+			b(1) = itv(-2. + 2. * j, -2. + 2. * j + 1e-4);
+			init.push_back(b);
+		}
+	}
+	end = 1.;
+
+	// odelong
+
+	x1 = init;
+	for (i=0; i<(int)x1.size(); i++) {
+		e = end;
+		kv::odelong(VDP(), x1[i], itv(0.), e);
+	}
+	x = init;
+	n = kv::odelong_batch(VDP(), x, itv(0.), end, status, reached);
+	std::cout << "odelong_batch: " << n << " reached\n";
+	std::cout << x[0] << "\n";
+	std::cout << "same: " << same(x, x1) << "\n";
+
+	// odelong_maffine
+
+	x1 = init;
+	for (i=0; i<(int)x1.size(); i++) {
+		e = end;
+		kv::odelong_maffine(VDP(), x1[i], itv(0.), e);
+	}
+	x = init;
+	n = kv::odelong_maffine_batch(VDP(), x, itv(0.), end, status, reached);
+	std::cout << "odelong_maffine_batch: " << n << " reached\n";
+	std::cout << x[0] << "\n";
+	std::cout << "same: " << same(x, x1) << "\n";
+
+	// exception
+
+	x = init;
+	try {
+		kv::odelong_batch(Throw(), x, itv(0.), end, status, reached);
+		std::cout << "odelong_batch: no exception\n";
+	}
+	catch (std::runtime_error& e) {
+		std::cout << "odelong_batch: " << e.what() << "\n";
+	}
+}
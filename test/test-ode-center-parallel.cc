@@ -0,0 +1,83 @@
+/*
+ * test for ODE_CENTER_PARALLEL of ode_maffine and odelong_qr_lohner
+ *  use
+ *   -DODE_CENTER_PARALLEL=0 (serial)
+ *   -DODE_CENTER_PARALLEL=1 -fopenmp (run with OMP_NUM_THREADS=2)
+ *  and compare the output. both must be the same.
+ */
+
+#include <iostream>
+#include <stdexcept>
+#include <kv/ode-maffine.hpp>
+#include <kv/ode-qr-lohner.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+// throws an exception other than std::domain_error
+struct Throw {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		throw std::runtime_error("Throw");
+		return x;
+	}
+};
+
+int main()
+{
+	ub::vector<itv> x;
+	itv end;
+	int r;
+
+	std::cout.precision(17);
+
+	x.resize(3);
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+	end = 2.;
+	r = kv::odelong_maffine(Lorenz(), x, itv(0.), end);
+	if (!r) std::cout << "can't calculate verified solution\n";
+	else {
+		std::cout << x << "\n";
+		std::cout << end << "\n";
+	}
+
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+	end = 1.;
+	r = kv::odelong_qr_lohner(Lorenz(), x, itv(0.), end);
+	if (!r) std::cout << "can't calculate verified solution\n";
+	else {
+		std::cout << x << "\n";
+		std::cout << end << "\n";
+	}
+
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+	end = 1.;
+	try {
+		kv::odelong_maffine(Throw(), x, itv(0.), end);
+		std::cout << "odelong_maffine: no exception\n";
+	}
+	catch (std::runtime_error& e) {
+		std::cout << "odelong_maffine: " << e.what() << "\n";
+	}
+
+	try {
+		kv::odelong_qr_lohner(Throw(), x, itv(0.), end);
+		std::cout << "odelong_qr_lohner: no exception\n";
+	}
+	catch (std::runtime_error& e) {
+		std::cout << "odelong_qr_lohner: " << e.what() << "\n";
+	}
+}
@@ -0,0 +1,141 @@
+#include <iostream>
+#include <cstdio>
+#include <cstring>
+#include <list>
+#include <vector>
+
+#include <kv/ode-maffine.hpp>
+#include <kv/ode-trajectory.hpp>
+
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+
+
+struct Lorenz {
+	template <class T> ub::vector<T> operator() (const ub::vector<T>& x, T t){
+		ub::vector<T> y(3);
+
+		y(0) = 10. * ( x(1) - x(0) );
+		y(1) = 28. * x(0) - x(1) - x(0) * x(2);
+		y(2) = (-8./3.) * x(2) + x(0) * x(1);
+
+		return y;
+	}
+};
+
+
+int main()
+{
+	int i, r;
+	ub::vector<itv> ix, x(3), y;
+	itv end;
+	std::list<itv> time_list;
+	std::list< ub::vector<itv> > value_list;
+	std::vector<itv> t;
+	std::vector< ub::vector<itv> > v;
+	kv::ode_trajectory<double> traj, traj2;
+
+	std::cout.precision(17);
+
+	x(0) = 15.; x(1) = 15.; x(2) = 36.;
+
+	// dense output by list
+
+	ix = x;
+	end = 1.;
+	r = kv::odelong_maffine(Lorenz(), ix, itv(0.), end, kv::ode_param<double>(), kv::ode_callback_dense_list<double>(itv(0.), itv(0.125), time_list, value_list));
+	if (!r) {
+		std::cout << "No Solution\n";
+		return 1;
+	}
+
+	// the same by trajectory
+
+	ix = x;
+	end = 1.;
+	r = kv::odelong_maffine(Lorenz(), ix, itv(0.), end, kv::ode_param<double>(), kv::ode_callback_trajectory<double>(traj));
+
+	std::cout << "steps: " << traj.size() << "\n";
+	for (i=0; i<traj.size(); i++) {
+		std::cout << traj.start(i) << " " << traj.end(i) << " " << traj.order(i, 0) << "\n";
+	}
+
+	for (i=0; i<=8; i++) t.push_back(itv(0.125) * i);
+	traj.eval(t, v);
+
+	std::list<itv>::iterator pt = time_list.begin();
+	std::list< ub::vector<itv> >::iterator pv = value_list.begin();
+	for (i=0; i<(int)t.size(); i++) {
+		std::cout << t[i] << "\n";
+		std::cout << v[i] << "\n";
+		// same as dense output unless t[i] is on the boundary of steps
+		if (pt != time_list.end()) {
+			std::cout << *pv << "\n";
+			pt++; pv++;
+		}
+	}
+
+	// interval of time over several steps
+
+	traj.eval(itv(0.1, 0.3), y);
+	std::cout << y << "\n";
+
+	// outside
+
+	std::cout << traj.eval(itv(2.), y) << "\n";
+
+	// save and load
+
+	std::cout << traj.save("test-ode-trajectory.dat") << "\n";
+	std::cout << traj2.load("test-ode-trajectory.dat") << "\n";
+	std::cout << traj2.size() << " " << traj2.dim() << "\n";
+	traj2.eval(itv(0.1, 0.3), y);
+	std::cout << y << "\n";
+
+	// broken offset table (the last offset is not the number of
+	// coefficients) must be rejected
+
+	int k = -1;
+	traj2.clear(); // release the file mapped by load
+	std::FILE* fp = std::fopen("test-ode-trajectory.dat", "r+b");
+	std::fseek(fp, -(long)sizeof(int), SEEK_END);
+	std::fwrite(&k, sizeof(int), 1, fp);
+	std::fclose(fp);
+	std::cout << traj2.load("test-ode-trajectory.dat") << "\n";
+	std::cout << traj2.size() << " " << traj2.dim() << "\n";
+
+	// a component without coefficients (equal consecutive offsets)
+	// must be rejected
+
+	kv::ode_trajectory_sub::file_header h;
+	itv se[2] = {itv(0.), itv(1.)};
+	int o[2] = {0, 0};
+	std::memset(&h, 0, sizeof(h));
+	std::strcpy(h.magic, "kvtraj1");
+	h.size = sizeof(itv);
+	h.dim = 1;
+	h.steps = 1;
+	h.coefs = 0;
+	fp = std::fopen("test-ode-trajectory.dat", "wb");
+	std::fwrite(&h, sizeof(h), 1, fp);
+	std::fwrite(se, sizeof(itv), 2, fp);
+	std::fwrite(o, sizeof(int), 2, fp);
+	std::fclose(fp);
+	std::cout << traj2.load("test-ode-trajectory.dat") << "\n";
+	std::cout << traj2.size() << " " << traj2.dim() << "\n";
+
+	// header which does not agree with the size of the file (dim is
+	// huge) must be rejected
+
+	traj.save("test-ode-trajectory.dat");
+	k = 0x7fffffff;
+	fp = std::fopen("test-ode-trajectory.dat", "r+b");
+	std::fseek(fp, 8 + sizeof(int), SEEK_SET);
+	std::fwrite(&k, sizeof(int), 1, fp);
+	std::fclose(fp);
+	std::cout << traj2.load("test-ode-trajectory.dat") << "\n";
+	std::cout << traj2.size() << " " << traj2.dim() << "\n";
+	std::remove("test-ode-trajectory.dat");
+}
@@ -0,0 +1,102 @@
+/*
+ * test of optimize_list_bestfirst (OPTIMIZE_BESTFIRST=1)
+ *  compile also with -fopenmp. every solution of the best-first search
+ *  must overlap a solution of optimize_list and vice versa ("match: 1"),
+ *  and the exceptions thrown in the parallel region must reach the
+ *  caller.
+ */
+
+#include <iostream>
+#include <list>
+#include <stdexcept>
+#include <kv/optimize.hpp>
+
+namespace ub = boost::numeric::ublas;
+
+typedef kv::interval<double> itv;
+typedef std::list< ub::vector<itv> > boxes;
+
+struct Func {
+	template <class T> T operator() (const ub::vector<T>& x){
+		return 1/(pow(x(0)-2,2) + pow(x(1)-3,2)+1) - 1/(pow(x(0)-5,2)+pow(x(1)-6,2)+1);
+	}
+};
+
+struct Levy {
+	template <class T> T operator() (const ub::vector<T>& x){
+		T tmp, tmp2;
+		int i;
+
+		tmp = 0;
+		for (i=1; i<=5; i++) {
+			tmp += i * cos((i-1)*x(0) + i);
+		}
+		tmp2 = 0;
+		for (i=1; i<=5; i++) {
+			tmp2 += i * cos((i+1)*x(1) + i);
+		}
+
+		return tmp * tmp2;
+	}
+};
+
+// throws an exception other than std::domain_error
+struct Throw {
+	template <class T> T operator() (const ub::vector<T>& x){
+		throw std::runtime_error("Throw");
+		return x(0);
+	}
+};
+
+// each box of x overlaps a box of y
+bool covered(const boxes& x, const boxes& y)
+{
+	boxes::const_iterator p, q;
+
+	for (p=x.begin(); p!=x.end(); p++) {
+		for (q=y.begin(); q!=y.end(); q++) {
+			if (overlap(*p, *q)) break;
+		}
+		if (q == y.end()) return false;
+	}
+	return true;
+}
+
+template <class F> void check(F f, const ub::vector<itv>& I, double limit, const char* name)
+{
+	boxes targets, r1, r2;
+	boxes::iterator p;
+
+	targets.push_back(I);
+	r1 = kv::optimize_list(targets, f, limit);
+	r2 = kv::optimize_list_bestfirst(targets, f, limit);
+
+	std::cout << name << "\n";
+	for (p=r2.begin(); p!=r2.end(); p++) {
+		std::cout << *p << "\n";
+	}
+	std::cout << "match: " << (!r2.empty() && covered(r1, r2) && covered(r2, r1)) << "\n";
+}
+
+int main()
+{
+	int i;
+	ub::vector<itv> I(2);
+	boxes targets;
+
+	std::cout.precision(17);
+
+	for (i=0; i<2; i++) I(i) = itv(0., 10.);
+
+	check(Func(), I, 1e-5, "Func");
+	check(Levy(), I, 1e-5, "Levy");
+
+	targets.push_back(I);
+	try {
+		kv::optimize_list_bestfirst(targets, Throw(), 1e-5);
+		std::cout << "optimize_list_bestfirst: no exception\n";
+	}
+	catch (std::runtime_error& e) {
+		std::cout << "optimize_list_bestfirst: " << e.what() << "\n";
+	}
+}
@@ -0,0 +1,226 @@
+/*
+ * test program for "rdouble-sse2.hpp"
+ *  compare add, sub, mul, div and sqrt under
+ *  - changing rounding mode for each operation
+ *  - packed operations of rdouble-sse2.hpp (rounding upward only)
+ */
+
+#include <fenv.h>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <boost/random.hpp>
+#include <ctime>
+#include <kv/interval.hpp>
+#include <kv/rdouble-sse2.hpp>
+
+#ifndef NT
+#define NT 1000000
+#endif
+
+struct hwround_ref {
+	static double add_up(const double& x, const double& y) {
+		volatile double r, x1 = x, y1 = y;
+		fesetround(FE_UPWARD);
+		r = x1 + y1;
+		fesetround(FE_TONEAREST);
+		return r;
+	}
+
+	static double add_down(const double& x, const double& y) {
+		volatile double r, x1 = x, y1 = y;
+		fesetround(FE_DOWNWARD);
+		r = x1 + y1;
+		fesetround(FE_TONEAREST);
+		return r;
+	}
+
+	static double sub_up(const double& x, const double& y) {
+		volatile double r, x1 = x, y1 = y;
+		fesetround(FE_UPWARD);
+		r = x1 - y1;
+		fesetround(FE_TONEAREST);
+		return r;
+	}
+
+	static double sub_down(const double& x, const double& y) {
+		volatile double r, x1 = x, y1 = y;
+		fesetround(FE_DOWNWARD);
+		r = x1 - y1;
+		fesetround(FE_TONEAREST);
+		return r;
+	}
+
+	static double mul_up(const double& x, const double& y) {
+		volatile double r, x1 = x, y1 = y;
+		fesetround(FE_UPWARD);
+		r = x1 * y1;
+		fesetround(FE_TONEAREST);
+		return r;
+	}
+
+	static double mul_down(const double& x, const double& y) {
+		volatile double r, x1 = x, y1 = y;
+		fesetround(FE_DOWNWARD);
+		r = x1 * y1;
+		fesetround(FE_TONEAREST);
+		return r;
+	}
+
+	static double div_up(const double& x, const double& y) {
+		volatile double r, x1 = x, y1 = y;
+		fesetround(FE_UPWARD);
+		r = x1 / y1;
+		fesetround(FE_TONEAREST);
+		return r;
+	}
+
+	static double div_down(const double& x, const double& y) {
+		volatile double r, x1 = x, y1 = y;
+		fesetround(FE_DOWNWARD);
+		r = x1 / y1;
+		fesetround(FE_TONEAREST);
+		return r;
+	}
+
+	static double sqrt_up(const double& x) {
+		volatile double r, x1 = x;
+		fesetround(FE_UPWARD);
+		r = std::sqrt(x1);
+		fesetround(FE_TONEAREST);
+		return r;
+	}
+
+	static double sqrt_down(const double& x) {
+		volatile double r, x1 = x;
+		fesetround(FE_DOWNWARD);
+		r = std::sqrt(x1);
+		fesetround(FE_TONEAREST);
+		return r;
+	}
+};
+
+bool samedouble(double x, double y)
+{
+	if (x != x && y != y) return true;
+	return x == y;
+}
+
+int nerror = 0;
+
+void report(const char *str, double x, double y, double r1, double r2)
+{
+	nerror++;
+	std::cout << str << " error\n";
+	std::cout << x << "\n";
+	std::cout << y << "\n";
+	std::cout << r1 << "\n";
+	std::cout << r2 << "\n";
+}
+
+void check(double x, double y)
+{
+	double r1, r2, p1, p2;
+	double ax = std::fabs(x);
+
+	#define CHECK_PAIR(op) \
+		r1 = hwround_ref::op##_down(x, y); \
+		r2 = hwround_ref::op##_up(y, x); \
+		kv::rop<double>::begin(); \
+		kv::rop_pair<double>::op(x, y, y, x, p1, p2); \
+		kv::rop<double>::end(); \
+		if (!samedouble(r1, p1)) report(#op "_down", x, y, r1, p1); \
+		if (!samedouble(r2, p2)) report(#op "_up", y, x, r2, p2);
+
+	CHECK_PAIR(add)
+	CHECK_PAIR(sub)
+	CHECK_PAIR(mul)
+	CHECK_PAIR(div)
+
+	#undef CHECK_PAIR
+
+	r1 = hwround_ref::sqrt_down(ax);
+	r2 = hwround_ref::sqrt_up(ax);
+	kv::rop<double>::begin();
+	kv::rop_pair<double>::sqrt(ax, ax, p1, p2);
+	kv::rop<double>::end();
+	if (!samedouble(r1, p1)) report("sqrt_down", ax, ax, r1, p1);
+	if (!samedouble(r2, p2)) report("sqrt_up", ax, ax, r2, p2);
+}
+
+int main() {
+	double x, y;
+	int i, j;
+	unsigned long long t;
+
+	double specials[11] = {
+		0.,
+		-0.,
+		std::numeric_limits<double>::infinity(),
+		-std::numeric_limits<double>::infinity(),
+		(std::numeric_limits<double>::max)(),
+		-(std::numeric_limits<double>::max)(),
+		(std::numeric_limits<double>::min)(),
+		-(std::numeric_limits<double>::min)(),
+		std::numeric_limits<double>::denorm_min(),
+		-std::numeric_limits<double>::denorm_min()
+	};
+	specials[10] = specials[2] + specials[3]; // making NaN
+
+	boost::variate_generator<boost::mt19937, boost::uniform_int<unsigned long long> > rand(boost::mt19937(time(0)), boost::uniform_int<unsigned long long>(0, -1));
+
+	std::cout.precision(17);
+
+	// general-general case
+	for (i=0; i<NT; i++) {
+		t = rand();
+		std::memcpy(&x, &t, sizeof(x));
+		t = rand();
+		std::memcpy(&y, &t, sizeof(y));
+		check(x, y);
+	}
+
+	// general-special case
+	for (i=0; i<NT/10; i++) {
+		t = rand();
+		std::memcpy(&x, &t, sizeof(x));
+		for (j=0; j<11; j++) {
+			y = specials[j];
+			check(x, y);
+			check(y, x);
+		}
+	}
+
+	// special-special case
+	for (i=0; i<11; i++) {
+		x = specials[i];
+		for (j=0; j<11; j++) {
+			y = specials[j];
+			check(x, y);
+		}
+	}
+
+	// nested begin()/end() must keep upward rounding
+	kv::rop<double>::begin();
+	kv::rop<double>::begin();
+	kv::rop<double>::end();
+	if (kv::rop<double>::add_up(1., std::ldexp(1., -60)) == 1.) {
+		std::cout << "nested begin/end error\n";
+		nerror++;
+	}
+	kv::rop<double>::end();
+
+	// rop_scope must restore the rounding mode when an exception is thrown
+	try {
+		kv::rop_scope<double> scope;
+		throw std::bad_alloc();
+	}
+	catch (std::bad_alloc&) {
+	}
+	if (kv::rop<double>::depth() != 0 || kv::rop<double>::add_up(1., std::ldexp(1., -60)) != 1.) {
+		std::cout << "rop_scope error\n";
+		nerror++;
+	}
+
+	std::cout << (nerror == 0 ? "OK" : "NG") << "\n";
+}